@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Pixie/Math/TransformKernels.h"
+
+using namespace pixie;
+
+namespace
+{
+
+// Scalar baselines: what components used to hand-roll
+
+void TransformPointsScalar(const Mat4& m, const std::vector<Vec3>& points, std::vector<Vec3>& out)
+{
+	const Vec4* c = m.columns;
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		const Vec3 p = points[i];
+		out[i] = {c[0].x * p.x + c[1].x * p.y + c[2].x * p.z + c[3].x,
+				  c[0].y * p.x + c[1].y * p.y + c[2].y * p.z + c[3].y,
+				  c[0].z * p.x + c[1].z * p.y + c[2].z * p.z + c[3].z};
+	}
+}
+
+void ComposeTransformsScalar(const std::vector<Mat4>& parents, const std::vector<Mat4>& locals, std::vector<Mat4>& out)
+{
+	for (size_t i = 0; i < locals.size(); ++i)
+	{
+		const float* a = &parents[i].columns[0].x;
+		const float* b = &locals[i].columns[0].x;
+		float* r = &out[i].columns[0].x;
+
+		for (int column = 0; column < 4; ++column)
+			for (int row = 0; row < 4; ++row)
+			{
+				float sum = 0.0f;
+				for (int k = 0; k < 4; ++k)
+					sum += a[k * 4 + row] * b[column * 4 + k];
+				r[column * 4 + row] = sum;
+			}
+	}
+}
+
+/** Runs a function 'repeats' times and prints the best time per item */
+template<class Function>
+double Measure(const char* name, size_t items, int repeats, Function&& function)
+{
+	using clock = std::chrono::steady_clock;
+
+	double best = 1e30;
+	for (int i = 0; i < repeats; ++i)
+	{
+		const auto start = clock::now();
+		function();
+		const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+		best = std::min(best, elapsed.count() / static_cast<double>(items));
+	}
+
+	std::printf("%-40s %8.3f ns/item\n", name, best);
+	return best;
+}
+
+/** Keeps the optimizer from discarding the results */
+volatile float sink = 0.0f;
+
+} // namespace
+
+
+int main()
+{
+	std::printf("SSE2: %d, AVX2: %d\n\n", PIXIE_SSE, PIXIE_AVX2);
+
+	const size_t count = 1 << 16;
+	const int repeats = 50;
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+
+	const Mat4 transform = Mat4::Trs({1.0f, 2.0f, 3.0f}, Quat::FromAxisAngle(Normalize(Vec3{1.0f, 1.0f, 0.0f}), 0.7f), {2.0f, 2.0f, 2.0f});
+
+	std::vector<Vec3> points(count), transformed(count);
+	std::vector<float> x(count), y(count), z(count), out_x(count), out_y(count), out_z(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		points[i] = {value(random), value(random), value(random)};
+		x[i] = points[i].x;
+		y[i] = points[i].y;
+		z[i] = points[i].z;
+	}
+
+	const double scalar = Measure("TransformPoints scalar", count, repeats,
+								  [&]() { TransformPointsScalar(transform, points, transformed); sink = transformed[count / 2].x; });
+	const double aos = Measure("TransformPoints Float4 (array of Vec3)", count, repeats,
+							   [&]() { TransformPoints(transform, Span<const Vec3>(points), Span<Vec3>(transformed)); sink = transformed[count / 2].x; });
+	const double soa = Measure("TransformPoints Float8 (array per axis)", count, repeats, [&]()
+	{
+		TransformPoints(transform, Span<const float>(x), Span<const float>(y), Span<const float>(z),
+						Span<float>(out_x), Span<float>(out_y), Span<float>(out_z));
+		sink = out_x[count / 2];
+	});
+	std::printf("  speedup: %.2fx (Float4), %.2fx (Float8)\n\n", scalar / aos, scalar / soa);
+
+	std::vector<Mat4> parents(count / 4), locals(count / 4), composed(count / 4);
+	for (size_t i = 0; i < locals.size(); ++i)
+	{
+		parents[i] = Mat4::Trs({value(random), value(random), value(random)}, Quat::FromAxisAngle({0.0f, 0.0f, 1.0f}, value(random)), {1.0f, 1.0f, 1.0f});
+		locals[i] = Mat4::Translation({value(random), value(random), value(random)});
+	}
+
+	const double compose_scalar = Measure("ComposeTransforms scalar", locals.size(), repeats,
+										  [&]() { ComposeTransformsScalar(parents, locals, composed); sink = composed[7].columns[3].x; });
+	const double compose = Measure("ComposeTransforms Float4", locals.size(), repeats, [&]()
+	{
+		ComposeTransforms(Span<const Mat4>(parents), Span<const Mat4>(locals), Span<Mat4>(composed));
+		sink = composed[7].columns[3].x;
+	});
+	std::printf("  speedup: %.2fx\n", compose_scalar / compose);
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+#ifndef PIXIE_CONCEPTS_CONCEPT_REGISTRY_H
+#define PIXIE_CONCEPTS_CONCEPT_REGISTRY_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Pixie/Utility/TypeTraits.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Compile-time list of user defined concepts
+ * @tparam Cs Concept traits (see SceneConcepts)
+ */
+template<class... Cs>
+struct ConceptList
+{
+	/// Number of concepts in the list
+	static constexpr size_t size = sizeof...(Cs);
+};
+
+/**
+ * Customization point that declares the user defined concepts the scene
+ * dispatches, on top of the built-in Begin, Tick, and End.
+ *
+ * A concept is a trait with a static Call function that is well-formed only
+ * for the types that implement it and, optionally, a static CallBatch
+ * function that handles a contiguous batch of such objects at once:
+ *
+ * @code
+ * struct Observe
+ * {
+ *     template<class T>
+ *     static auto Call(T& object) -> decltype(object.Observe()) { object.Observe(); }
+ * };
+ *
+ * namespace pixie
+ * {
+ * template<>
+ * struct SceneConcepts<>
+ * {
+ *     using type = ConceptList<Observe, ComputeReward>;
+ * };
+ * }
+ * @endcode
+ *
+ * The scene then keeps a dense list of the storages whose type implements
+ * each concept, and dispatches it with Scene::Dispatch<Observe>(), batch by
+ * batch, to only those objects.
+ *
+ * @warning The specialization must be declared before any entity or
+ * component is constructed, and must be the same in every translation unit
+ * @note Only objects held in the scene storage and in static scenes are
+ * dispatched. PObjects only support the built-in concepts.
+ */
+template<class Tag = void>
+struct SceneConcepts
+{
+	using type = ConceptList<>;
+};
+
+/**
+ * The declared concepts, looked up lazily so that the user specialization
+ * is seen from within the templates of pixie
+ * @tparam T Any type the lookup depends on
+ */
+template<class T>
+using SceneConceptsOf = typename SceneConcepts<std::conditional_t<true, void, T>>::type;
+
+/** Utility type trait that checks whether class T implements concept C */
+template<class T, class C>
+using CheckConcept = decltype(C::Call(std::declval<T&>()));
+
+/** Utility type trait that checks whether concept C handles batches of class T */
+template<class T, class C>
+using CheckConceptBatch = decltype(C::CallBatch(std::declval<Span<T>>()));
+
+/**
+ * Template utility type traits boolean that is true if concept C handles batches of class T
+ * @tparam T Type of the class to check
+ * @tparam C Concept trait
+ */
+template<class T, class C>
+constexpr bool ImplementsBatch = pixie::type_traits::is_detected_v<CheckConceptBatch, T, C>;
+
+/**
+ * Template utility type traits boolean that is true if class T implements concept C,
+ * either one object at a time (C::Call) or in batches (C::CallBatch)
+ * @tparam T Type of the class to check
+ * @tparam C Concept trait
+ */
+template<class T, class C>
+constexpr bool Implements = pixie::type_traits::is_detected_v<CheckConcept, T, C> or ImplementsBatch<T, C>;
+
+/**
+ * Dispatches concept C to a contiguous batch of objects, either in a single
+ * call to C::CallBatch (if implemented) or by calling C::Call on each of them
+ * @tparam C (Required) Concept trait
+ * @tparam T (Automatically deduced) Type of the objects in the batch
+ * @param [in] objects Contiguous batch of objects of type T
+ */
+template<class C, class T>
+inline void DispatchBatch(Span<T> objects)
+{
+	if constexpr (ImplementsBatch<T, C>)
+	{
+		C::CallBatch(objects);
+	}
+	else
+	{
+		for (auto& object : objects)
+			C::Call(object);
+	}
+}
+
+/**
+ * Index of concept C within a ConceptList
+ */
+template<class C, class List>
+struct ConceptIndex;
+
+template<class C, class... Cs>
+struct ConceptIndex<C, ConceptList<Cs...>>
+{
+private:
+	static constexpr size_t Find()
+	{
+		constexpr bool matches[] = {std::is_same_v<C, Cs>..., false};
+
+		size_t index = 0;
+		while (index < sizeof...(Cs) and not matches[index])
+			++index;
+
+		return index;
+	}
+
+public:
+	static constexpr size_t value = Find();
+
+	static_assert(value < sizeof...(Cs),
+			"Concept is not declared. Add it to the ConceptList of pixie::SceneConcepts<>");
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CONCEPTS_CONCEPT_REGISTRY_H
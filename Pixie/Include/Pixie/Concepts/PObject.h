@@ -11,6 +11,7 @@
 
 #include "Pixie/Concepts/Object.h"
 #include "Pixie/Concepts/Tickable.h"
+#include "Pixie/Core/Storage/PObjectBatch.h"
 
 namespace pixie
 {
@@ -36,10 +37,11 @@ public:
 	{
 		using std::move;
 
-		if(HasTick<T>)
+		if constexpr (IsTickable<T>)
 		{
 			Tickable obj = x;
 			data = move(obj);
+			enroll = &Enroll<T>;
 		}
 		else
 		{
@@ -53,32 +55,77 @@ public:
 	{
 		using std::move;
 
-		if(HasTick<T>)
+		if constexpr (IsTickable<T>)
 		{
 			Tickable obj;
 			obj.Create<T>();
 			data = move(obj);
+			enroll = &Enroll<T>;
 		}
 		else
 		{
 			Object obj;
 			obj.Create<T>();
 			data = move(obj);
+			enroll = nullptr;
 		}
+
+		Reenroll();
 	}
 
-	/** Copy constructor */
-	PIXIE_EXPORT PObject(const PObject& object) = default;
+	/**
+	 * Copy constructor
+	 * @note The copy is not registered in the scene, even if the original is
+	 */
+	PIXIE_EXPORT PObject(const PObject& object)
+			: data(object.data), enroll(object.enroll)
+	{ }
 
-	/** Default move constructor */
-	PIXIE_EXPORT PObject(PObject&&) noexcept = default;
+	/**
+	 * Move constructor. Takes over the registration of the other PObject
+	 * @note The moved object stays where it is in the heap, hence its
+	 * registration remains valid (e.g. when its outer object is relocated)
+	 */
+	PIXIE_EXPORT PObject(PObject&& other) noexcept
+			: data(std::move(other.data)), enroll(other.enroll),
+			  batches(other.batches), registration(other.registration)
+	{
+		other.enroll = nullptr;
+		other.batches = nullptr;
+		other.registration = PObjectBatchRef();
+	}
 
 	/** Copy assignment operator */
 	PIXIE_EXPORT PObject& operator=(const PObject& object)
 	{ *this = PObject(object);	return *this; }
 
-	/** Move assignment operator */
-	PIXIE_EXPORT PObject& operator=(PObject&&) noexcept = default;
+	/**
+	 * Move assignment operator. If this PObject is registered in the scene,
+	 * its old object stops being ticked and the new one, if tickable, is
+	 * ticked in its place
+	 */
+	PIXIE_EXPORT PObject& operator=(PObject&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		other.registration.Erase();
+		other.batches = nullptr;
+
+		data = std::move(other.data);
+		enroll = other.enroll;
+		other.enroll = nullptr;
+
+		Reenroll();
+
+		return *this;
+	}
+
+	/** Destructor. Unregisters the object from the scene */
+	PIXIE_EXPORT ~PObject()
+	{
+		registration.Erase();
+	}
 
 public:
 	/**
@@ -96,7 +143,7 @@ public:
 	{
 		using std::get;
 
-		if(HasTick<T>)
+		if constexpr (IsTickable<T>)
 		{
 			return get<Tickable>(data).template StaticCast<T>();
 		}
@@ -140,9 +187,54 @@ private:
 	}
 #undef VISIT_VARIANT
 
+	/**
+	 * Registers the tickable object held here in the batch of its type, so
+	 * that it is ticked in a single pass along with the other objects of its
+	 * type rather than visited one by one. The registration follows the
+	 * PObject: it is dropped when the PObject is destroyed and renewed when
+	 * it is assigned a new object.
+	 * @param [in] pobject_batches Batches the PObject is registered in
+	 * @note PObjects that hold a non-tickable object are not registered
+	 */
+	void Register(PObjectBatches& pobject_batches)
+	{
+		batches = &pobject_batches;
+		Reenroll();
+	}
+
+	/**
+	 * Drops the current registration and registers the object held here,
+	 * if the PObject is registered in the scene and the object is tickable
+	 */
+	void Reenroll()
+	{
+		registration.Erase();
+
+		if (batches and enroll)
+			registration = enroll(*batches, *this);
+	}
+
+	/**
+	 * Registers the object of type T held by the PObject in its batch
+	 */
+	template<class T>
+	static PObjectBatchRef Enroll(PObjectBatches& batches, PObject& pobject)
+	{
+		return batches.Add(pobject.StaticCast<T>());
+	}
+
 private:
 	/// type of the object this PObject holds
 	object_type data{};
+
+	/// Registers the held object in its batch. Null if it is not tickable
+	PObjectBatchRef (*enroll)(PObjectBatches&, PObject&) = nullptr;
+
+	/// Batches this PObject is registered in, if any
+	PObjectBatches* batches = nullptr;
+
+	/// Registration of the held object in its batch
+	PObjectBatchRef registration{};
 };
 
 }
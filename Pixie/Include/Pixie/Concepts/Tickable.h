@@ -37,6 +37,7 @@ public:
 	template<class T>
 	void Create()
 	{
+		static_assert(IsTickable<T>, "Tickable requires an object that defines a public 'void Tick()' member function");
 		self = std::make_unique<Model<T>>();
 	}
 
@@ -48,7 +49,9 @@ public:
 	template<class T>
 	PIXIE_EXPORT Tickable(T x)
 			: self(std::make_unique<Model<T>>(std::move(x)))
-	{ }
+	{
+		static_assert(IsTickable<T>, "Tickable requires an object that defines a public 'void Tick()' member function");
+	}
 
 	/** Copy constructor */
 	PIXIE_EXPORT Tickable(const Tickable& object)
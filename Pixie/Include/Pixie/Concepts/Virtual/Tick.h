@@ -1,10 +1,9 @@
 #ifndef PIXIE_CONCEPTS_VIRTUAL_TICK_H
 #define PIXIE_CONCEPTS_VIRTUAL_TICK_H
 
-#include <iostream>
-
 #include "Pixie/Misc/PixieExports.h"
 #include "Pixie/Utility/TypeTraits.h"
+#include "Pixie/Utility/Span.h"
 
 namespace pixie
 {
@@ -22,6 +21,49 @@ using CheckTick = decltype(std::declval<T>().Tick());
 template<class T>
 constexpr bool HasTick = pixie::type_traits::is_detected_v<CheckTick, T>;
 
+/** Utility type trait that checks whether class T implements a 'static void TickBatch(Span<T>)' method */
+template<class T>
+using CheckTickBatch = decltype(T::TickBatch(std::declval<Span<T>>()));
+
+/**
+ * Template utility type traits boolean that uses detection idiom at compile time to
+ * check whether class T implements a batched Tick method with the following signature:
+ * static void TickBatch(Span<T> objects);
+ * @tparam T Type of the class to check for the presence of TickBatch method
+ * @note When implemented, the scene ticks all the objects of type T through
+ * TickBatch in a single pass instead of calling Tick on them one by one
+ */
+template<class T>
+constexpr bool HasTickBatch = pixie::type_traits::is_detected_v<CheckTickBatch, T>;
+
+/**
+ * Template utility type traits boolean that is true if objects of class T can be ticked,
+ * either one by one (Tick) or in batches (TickBatch)
+ * @tparam T Type of the class to check
+ */
+template<class T>
+constexpr bool IsTickable = HasTick<T> or HasTickBatch<T>;
+
+/**
+ * Ticks all the objects of a batch, either in a single call to T::TickBatch
+ * (if implemented) or by calling T::Tick on each of them
+ * @tparam T (Automatically deduced) Type of the objects in the batch
+ * @param [in] objects Contiguous batch of objects of type T
+ */
+template<class T>
+inline void TickBatch(Span<T> objects)
+{
+	if constexpr (HasTickBatch<T>)
+	{
+		T::TickBatch(objects);
+	}
+	else
+	{
+		for (auto& object : objects)
+			object.Tick();
+	}
+}
+
 /**
  * Free Tick function that is called from the main game loop which will then redirects
  * the call to the Tick method of input object of type T
@@ -63,24 +105,32 @@ protected:
 	}
 
     /**
-     * Overloaded method that is invoked when the object of type T does not have a Tick method
-     * but still is defined to comply with this concept
-     * @tparam T Automatically deduced - Type of class that implements a Tick method
-     * @param [in] data Class that derives from this concept and implements a Tick method
+     * Overloaded method that is invoked when the object of type T only implements the batched
+     * version of Tick. The object is ticked as a batch of one.
+     * @tparam T Automatically deduced - Type of class that implements a TickBatch method
+     * @param [in] data Class that derives from this concept and implements a TickBatch method
+     */
+	template<class T, typename
+	std::enable_if_t<HasTick<T> == 0 and HasTickBatch<T> != 0> * = nullptr>
+	static inline void CallTick(T& data)
+	{
+		T::TickBatch(Span<T>(&data, 1));
+	}
+
+    /**
+     * Overloaded method that is selected when the object of type T does not have a Tick method
+     * but still is defined to comply with this concept. Rejects the object at compile time.
+     * @tparam T Automatically deduced - Type of class that should implement a Tick method
      */
 	template<class T, typename
-	std::enable_if<HasTick<T> == 0>::type* = nullptr>
+	std::enable_if_t<HasTick<T> == 0 and HasTickBatch<T> == 0> * = nullptr>
 	static inline void CallTick(T&)
 	{
-		std::cerr << "Error: Object " << /*pixie::type_traits::experimental::type_name<T>()*/ typeid(T).name()
-				  << " is specified to comply with Tick concept but does not define a 'Tick' member function.\n"
-				  << "If your class already implements Tick then make sure it has a public accessor.\n"
-				  << "If not, please define the member function with the following signature within your class.\n"
-				  << "Error: " << typeid(T).name() << " Requires\t "
-				  << "'void Tick() {}'\n"
-				  << "------------------------------------------------------------------------------------------"
-				  << std::endl;
-		std::cerr.flush();
+		static_assert(IsTickable<T>,
+				"Object is specified to comply with Tick concept but does not define a 'Tick' member function. "
+				"If your class already implements Tick then make sure it has a public accessor. "
+				"If not, please define the member function with the following signature within your class: "
+				"'void Tick() {}'");
 	}
 };
 
@@ -31,6 +31,26 @@ public:
 	 */
 	static void Start();
 
+	/**
+	 * Queries the Engine to call Begin on the registered objects, e.g. so that
+	 * they write the first observations of an episode
+	 * @note Does nothing if the game has already begun
+	 */
+	static void Begin();
+
+	/**
+	 * Queries the Engine to run a single frame of the game loop, for a
+	 * learner that drives the environment one step at a time
+	 * @note Calls Begin first if the game has not begun yet
+	 */
+	static void Step();
+
+	/**
+	 * Queries the Engine to call End on the registered objects, if the game
+	 * has begun
+	 */
+	static void End();
+
 	/**
 	 * Queries the Engine to shut itself down
 	 */
@@ -46,6 +66,184 @@ public:
 	 */
 	static void Reset(); // TODO(Ahura): missing implementation
 
+	/**
+	 * Queries the scene to defragment the memory of its objects
+	 * @note Call between episodes, while the engine is not running. Handles
+	 * remain valid, raw pointers to the scene objects do not.
+	 */
+	static void Compact();
+
+	/**
+	 * Queries the scene to dispatch the user defined concept C to all the
+	 * objects that implement it
+	 * @tparam C (Required) Concept trait declared in SceneConcepts
+	 * @see SceneConcepts
+	 */
+	template<class C>
+	static void Dispatch()
+	{
+		if (is_initialized)
+			database.scene.Dispatch<C>();
+	}
+
+	/**
+	 * Queries the scene for all the entities that own components of types Ts
+	 * @tparam Ts (Required) Types of the components
+	 * @see Scene::Query
+	 */
+	template<class... Ts>
+	static QueryView<Ts...> Query()
+	{
+		return is_initialized ? database.scene.Query<Ts...>() : QueryView<Ts...>({}, {});
+	}
+
+	/**
+	 * Looks up the object of type T within the entity that owns the input
+	 * object, e.g. GetComponent<Sensor>(wheel) from any component of a robot
+	 * @tparam T (Required) Type of the object to look up
+	 * @param [in] owned Handle to an entity or to any of its components
+	 * @return A handle to the object, or a null handle if there is none (a
+	 * pointer, or a nullptr, if T is stored in a sparse set)
+	 * @see Scene::GetComponent
+	 */
+	template<class T, class U>
+	static ComponentLookup<T> GetComponent(Handle<U> owned)
+	{
+		return is_initialized ? database.scene.GetComponent<T>(owned) : ComponentLookup<T>();
+	}
+
+	/**
+	 * Checks whether the entity that owns the input object owns an object of type T
+	 * @see Scene::HasComponent
+	 */
+	template<class T, class U>
+	static bool HasComponent(Handle<U> owned)
+	{
+		return is_initialized and database.scene.HasComponent<T>(owned);
+	}
+
+	/**
+	 * Attaches a component of type T to the entity that owns the input
+	 * object, e.g. AddComponent<Stunned>(robot, 2.0f). T must be stored in a
+	 * sparse set (see SparseStorage)
+	 * @return A pointer to the component, or a nullptr if the entity is not alive
+	 * @see Scene::AddComponent
+	 */
+	template<class T, class U, class... Args>
+	static T* AddComponent(Handle<U> owned, Args&&... args)
+	{
+		return is_initialized ? database.scene.AddComponent<T>(owned, std::forward<Args>(args)...) : nullptr;
+	}
+
+	/**
+	 * Detaches and destroys the component of type T of the entity that owns
+	 * the input object
+	 * @return True if the entity had one; otherwise false
+	 * @see Scene::RemoveComponent
+	 */
+	template<class T, class U>
+	static bool RemoveComponent(Handle<U> owned)
+	{
+		return is_initialized and database.scene.RemoveComponent<T>(owned);
+	}
+
+	/**
+	 * Emits an event, delivered in a batch to the subscribers of its type at
+	 * the end of the current phase, e.g. Emit(Collision{a, b})
+	 * @note Can be called from any thread
+	 * @see Scene::Emit
+	 */
+	template<class E>
+	static void Emit(E event)
+	{
+		if (is_initialized)
+			database.scene.Emit(std::move(event));
+	}
+
+	/**
+	 * Registers a handler that receives the events of type E, one batch per
+	 * phase, e.g. Subscribe<Collision>([](Span<const Collision> collisions) { ... })
+	 * @return Identifier of the subscription (see Unsubscribe)
+	 * @see Scene::Subscribe
+	 */
+	template<class E, class Handler>
+	static uint32_t Subscribe(Handler&& handler)
+	{
+		return is_initialized ? database.scene.Subscribe<E>(std::forward<Handler>(handler)) : 0;
+	}
+
+	/**
+	 * Removes a subscription to the events of type E
+	 * @see Scene::Unsubscribe
+	 */
+	template<class E>
+	static bool Unsubscribe(uint32_t id)
+	{
+		return is_initialized and database.scene.Unsubscribe<E>(id);
+	}
+
+	/**
+	 * Queries the scene to run a policy on the whole batch of observations
+	 * at the end of Begin and of each Tick, e.g. SetPolicy(forward_pass)
+	 * @param [in] policy The policy, or an empty function to remove it
+	 * @see Policy
+	 */
+	static void SetPolicy(Policy policy)
+	{
+		if (is_initialized)
+			database.scene.SetPolicy(std::move(policy));
+	}
+
+	/**
+	 * Returns the current frame of the scene, e.g. to remember when the
+	 * changes were last read
+	 * @see Scene::GetFrame
+	 */
+	static uint64_t GetFrame()
+	{
+		return is_initialized ? database.scene.GetFrame() : 0;
+	}
+
+	/**
+	 * Records that the object changed on the current frame. T must track its
+	 * changes (see TrackChanges)
+	 * @return True if recorded; false if the object is not alive
+	 * @see Scene::MarkChanged
+	 */
+	template<class T>
+	static bool MarkChanged(Handle<T> handle)
+	{
+		return is_initialized and database.scene.MarkChanged(handle);
+	}
+
+	/**
+	 * Looks up the live objects of type T that changed after the given
+	 * frame, e.g. ChangedSince<Transform>(last_read)
+	 * @return Handles to the changed objects, in the order of their last change
+	 * @see Scene::ChangedSince
+	 */
+	template<class T>
+	static std::vector<Handle<T>> ChangedSince(uint64_t since)
+	{
+		return is_initialized ? database.scene.ChangedSince<T>(since) : std::vector<Handle<T>>();
+	}
+
+	/**
+	 * Checks whether the object changed after the given frame
+	 * @see Scene::HasChangedSince
+	 */
+	template<class T>
+	static bool HasChangedSince(Handle<T> handle, uint64_t since)
+	{
+		return is_initialized and database.scene.HasChangedSince(handle, since);
+	}
+
+	/**
+	 * Queries the scene for a snapshot of the memory used by its objects
+	 * @return Live and reserved memory per type, per entity and in total
+	 */
+	static MemoryStats GetMemoryStats();
+
 	/**
 	 * Destroys the Core.
 	 * @note This destroys all the main components (i.e. Engine, Scene, etc.)
@@ -62,6 +260,13 @@ public:
 	 * @return A reference to the core clock
 	 */
 	static Clock& GetClock() { return database.clock; }
+
+	/**
+	 * Returns the worker threads of the engine, e.g. to split a batch of
+	 * ray casts across them
+	 * @see WorkerPool
+	 */
+	static WorkerPool& GetWorkerPool() { return database.engine.GetWorkers(); }
 private:
 	/**
 	 * Database struct where all core objects are stored
@@ -45,6 +45,25 @@ public:
 		return delta_time_chrono;
 	}
 
+	/**
+	 * Returns the simulated time of a frame, which fixed-step systems such
+	 * as physics advance by regardless of the rendering time
+	 * @return Fixed time step in seconds
+	 */
+	float GetFixedTimeStepInSeconds() const
+	{
+		return fixed_time_step_seconds;
+	}
+
+	/**
+	 * Sets the simulated time of a frame
+	 * @param [in] seconds Fixed time step in seconds
+	 */
+	void SetFixedTimeStepInSeconds(float seconds)
+	{
+		fixed_time_step_seconds = seconds;
+	}
+
 private:
 	/**
 	 * Start the stopwatch timer
@@ -86,6 +105,9 @@ private:
 	/// potentially prevent many individual chrono to seconds conversions
 	float delta_time_seconds{0.0f};
 
+	/// Simulated time of a frame in seconds
+	float fixed_time_step_seconds{1.0f / 60.0f};
+
 	/// Time point set by StartTimer at the beginning of a new iteration
 	/// of the main game loop
 	steady_clock::time_point start;
@@ -1,6 +1,9 @@
 #ifndef PIXIE_CORE_ENGINE_ENGINE_H
 #define PIXIE_CORE_ENGINE_ENGINE_H
 
+#include <memory>
+
+#include "Pixie/Core/Engine/WorkerPool.h"
 #include "Pixie/Core/Scene/Scene.h"
 
 namespace pixie
@@ -15,12 +18,36 @@ public:
 	/** Default destructor */
 	~Engine() = default;
 
+	/** Default move constructor */
+	Engine(Engine&&) noexcept = default;
+
+	/** Default move assignment operator */
+	Engine& operator=(Engine&&) noexcept = default;
+
 	/**
 	 * Starts the game loop, processes all input commands and class
 	 * Begin, Tick, and End methods of registered qualified objects
 	 */
 	void Start();
 
+	/**
+	 * Calls the Begin method of all the registered objects, if the game has
+	 * not begun yet
+	 */
+	void Begin();
+
+	/**
+	 * Runs a single frame of the game loop, e.g. when a learner steps the
+	 * environment instead of letting Start run it
+	 * @note Calls Begin first if the game has not begun yet
+	 */
+	void Step();
+
+	/**
+	 * Calls the End method of all the registered objects, if the game has begun
+	 */
+	void End();
+
 	/**
 	 * Completely Stops the game loop, therefore the engine will no longer
 	 * processes any command
@@ -44,12 +71,30 @@ public:
 	 */
 	void SetPtrToScene(Scene* in_scene) { this->scene = in_scene; }
 
+	/**
+	 * Returns the worker threads of the engine, started on first use
+	 * @see WorkerPool
+	 */
+	WorkerPool& GetWorkers()
+	{
+		if (not workers)
+			workers = std::make_unique<WorkerPool>();
+
+		return *workers;
+	}
+
 private:
 	/// A pointer to scene object which is originally stored in Core database
 	Scene* scene = nullptr;
 
 	/// The current state of the engine
 	bool is_running = false;
+
+	/// Whether Begin has been called and End has not
+	bool has_begun = false;
+
+	/// Threads that data parallel work is split across
+	std::unique_ptr<WorkerPool> workers{};
 };
 
 } // namespace pixie
@@ -0,0 +1,193 @@
+#ifndef PIXIE_CORE_ENGINE_WORKER_POOL_H
+#define PIXIE_CORE_ENGINE_WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pixie
+{
+
+/**
+ * Fixed set of worker threads that the engine uses to split data parallel
+ * work (e.g. batched raycasts) into chunks.
+ *
+ * The calling thread works on the chunks along with the workers, and a
+ * ParallelFor issued from within a worker runs serially on that worker.
+ */
+class WorkerPool
+{
+public:
+	/**
+	 * (Constructor) Starts the worker threads
+	 * @param [in] worker_count Number of threads on top of the calling one
+	 */
+	explicit WorkerPool(size_t worker_count = DefaultWorkerCount())
+	{
+		workers.reserve(worker_count);
+		for (size_t i = 0; i < worker_count; ++i)
+			workers.emplace_back([this]() { Run(); });
+	}
+
+	/** Stops and joins the worker threads */
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			is_stopping = true;
+		}
+
+		wake.notify_all();
+		for (auto& worker : workers)
+			worker.join();
+	}
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/** Returns the number of threads that work on a ParallelFor, the caller included */
+	size_t Size() const { return workers.size() + 1; }
+
+	/**
+	 * Calls the input function on consecutive chunks of [0, count) from
+	 * all the threads of the pool, and returns once every chunk is done
+	 * @param [in] count Number of items
+	 * @param [in] grain Number of items per chunk
+	 * @param [in] function Function that takes (size_t begin, size_t end)
+	 * @warning The function must not throw
+	 */
+	template<class Function>
+	void ParallelFor(size_t count, size_t grain, Function&& function)
+	{
+		grain = std::max<size_t>(grain, 1);
+
+		if (workers.empty() or count <= grain or IsWorker())
+		{
+			if (count > 0)
+				function(size_t(0), count);
+			return;
+		}
+
+		std::lock_guard<std::mutex> submit_lock(submit);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = std::ref(function);
+			job_count = count;
+			job_grain = grain;
+			next_chunk.store(0, std::memory_order_relaxed);
+			busy_workers = workers.size();
+			++generation;
+		}
+
+		wake.notify_all();
+		RunChunks();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() { return busy_workers == 0; });
+		job = nullptr;
+	}
+
+	/** Returns one worker per hardware thread, minus the calling one */
+	static size_t DefaultWorkerCount()
+	{
+		const unsigned hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+private:
+	/** Whether the calling thread is a worker of any pool */
+	static bool& IsWorker()
+	{
+		thread_local bool is_worker = false;
+		return is_worker;
+	}
+
+	/** Main loop of a worker thread */
+	void Run()
+	{
+		IsWorker() = true;
+
+		uint64_t seen = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&]() { return is_stopping or generation != seen; });
+
+				if (is_stopping)
+					return;
+
+				seen = generation;
+			}
+
+			RunChunks();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--busy_workers;
+			}
+
+			done.notify_one();
+		}
+	}
+
+	/** Works on the chunks of the current job until there are none left */
+	void RunChunks()
+	{
+		while (true)
+		{
+			const size_t begin = next_chunk.fetch_add(job_grain, std::memory_order_relaxed);
+			if (begin >= job_count)
+				return;
+
+			job(begin, std::min(begin + job_grain, job_count));
+		}
+	}
+
+	/// Worker threads
+	std::vector<std::thread> workers{};
+
+	/// Serializes the calls to ParallelFor
+	std::mutex submit{};
+
+	/// Guards the job and the state of the workers
+	std::mutex mutex{};
+
+	/// Wakes the workers up on a new job or on stop
+	std::condition_variable wake{};
+
+	/// Signals the end of the job
+	std::condition_variable done{};
+
+	/// Function of the current job
+	std::function<void(size_t, size_t)> job{};
+
+	/// Number of items of the current job
+	size_t job_count = 0;
+
+	/// Number of items per chunk of the current job
+	size_t job_grain = 1;
+
+	/// First item of the next chunk to pick up
+	std::atomic<size_t> next_chunk{0};
+
+	/// Workers still working on the current job
+	size_t busy_workers = 0;
+
+	/// Bumped for every job
+	uint64_t generation = 0;
+
+	/// Set once the pool is being destroyed
+	bool is_stopping = false;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_ENGINE_WORKER_POOL_H
@@ -46,37 +46,165 @@ public:
 		return game_manager.DynamicCast<T>();
 	}
 
+	/**
+	 * Queries the scene to get its spatial hash, where objects register
+	 * their positions and look up their neighbors
+	 * @return A pointer to the spatial hash, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline SpatialHash* GetSpatialHash()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetSpatialHash();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Queries the scene to get the geometry that rays are cast against
+	 * @return A pointer to the raycaster, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline Raycaster* GetRaycaster()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetRaycaster();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Queries the scene to get its broadphase, where objects register their
+	 * bounds to receive OverlapBegin and OverlapEnd events
+	 * @return A pointer to the broadphase, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline Broadphase* GetBroadphase()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetBroadphase();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Queries the scene to get its 2D rigid bodies
+	 * @return A pointer to the physics world, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline PhysicsWorld2D* GetPhysics()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetPhysics();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Queries the scene to get its observations, where objects store what
+	 * they observe each step
+	 * @return A pointer to the observations, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline SpaceBuffer* GetObservations()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetObservations();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Queries the scene to get its actions, where objects read what they are
+	 * asked to do each step
+	 * @return A pointer to the actions, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	static inline SpaceBuffer* GetActions()
+	{
+		if (Core::is_initialized)
+		{
+			return &Core::database.scene.GetActions();
+		}
+		return nullptr;
+	}
+
 	/**
 	 * Queries the scene to Create and add an object of type T into the scene
 	 * @tparam T (Required) Type of the object that is being created
-	 * @return A pointer to the created object
-	 * @warning Do NOT delete the returned pointer
+	 * @return A handle to the created object, or a null handle if the core
+	 * is not initialized
 	 * @remark: This level of indirect access is provided to assure that client
 	 * will not attempt to access the scene directly
 	 */
 	template<class T>
-	static inline T* ConstructEntity()
+	static inline Handle<T> ConstructEntity()
 	{
 		if (Core::is_initialized)
 		{
 			return Core::database.scene.ConstructEntity<T>();
 		}
-		return nullptr;
+		return Handle<T>();
+	}
+
+	/**
+	 * Queries the scene to destroy the entity and all its components
+	 * @tparam T (Automatically deduced) Type of the entity
+	 * @param [in] entity Handle returned by ConstructEntity
+	 * @return True if the entity was alive and is now destroyed; otherwise false
+	 */
+	template<class T>
+	static inline bool DestroyEntity(Handle<T> entity)
+	{
+		if (Core::is_initialized)
+		{
+			return Core::database.scene.DestroyEntity(entity);
+		}
+		return false;
 	}
 
 	/**
 	 * Queries the scene to Create a component of type T and form its
 	 * dependencies
 	 * @tparam T (Required) Type of the component that is being created
-	 * @return A pointer to the created component
-	 * @warning Do NOT delete the returned pointer
+	 * @return A handle to the created component
 	 */
 	template<class T>
-	static T* ConstructComponent()
+	static Handle<T> ConstructComponent()
 	{
 		return Core::database.scene.ConstructComponent<T>();
 	}
 
+	/**
+	 * Queries the scene to create a static scene whose object types are
+	 * known at compile time. The engine drives it along with the rest of
+	 * the scene, without any per-object virtual dispatch.
+	 * @tparam Ts (Required) Types of the objects held by the static scene
+	 * @return A pointer to the static scene, or a nullptr if the core is not
+	 * initialized
+	 * @warning Do NOT delete the returned pointer
+	 */
+	template<class... Ts>
+	static StaticScene<Ts...>* ConstructStaticScene()
+	{
+		if (Core::is_initialized)
+		{
+			return Core::database.scene.CreateStaticScene<Ts...>();
+		}
+		return nullptr;
+	}
+
 	/**
 	 * Queries the scene to populate input PObject with the component
 	 * of type T and form all its dependencies. This method will
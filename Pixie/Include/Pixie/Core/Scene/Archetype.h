@@ -0,0 +1,208 @@
+#ifndef PIXIE_CORE_SCENE_ARCHETYPE_H
+#define PIXIE_CORE_SCENE_ARCHETYPE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Core/Storage/ComponentStorage.h"
+
+namespace pixie
+{
+
+/**
+ * Table of all the entities that own the exact same set of component types.
+ *
+ * Each row is an entity and each column is a component type, identified by
+ * the storage of that type. A cell holds the address of the component so
+ * that a query can walk the rows without resolving any handle.
+ *
+ * @note The entity itself is part of its own row, hence a query can ask for
+ * the entity type as well as for the types of its components
+ * @note If an entity owns several components of the same type, its row
+ * holds the first one of them in construction order
+ */
+class ArchetypeTable
+{
+public:
+	/**
+	 * (Constructor) Creates an empty table
+	 * @param [in] types Storages of the component types, sorted
+	 */
+	explicit ArchetypeTable(std::vector<ComponentStorageBase*> types)
+			: types(std::move(types)), columns(this->types.size())
+	{}
+
+	/**
+	 * Appends a row
+	 * @param [in] entity Reference to the entity that owns the row
+	 * @param [in] cells Address of each component, in the order of the types
+	 */
+	void AddRow(ComponentRef entity, const std::vector<void*>& cells)
+	{
+		entities.push_back(entity);
+		for (size_t column = 0; column < columns.size(); ++column)
+			columns[column].push_back(cells[column]);
+	}
+
+	/**
+	 * Removes the row of the given entity. The last row takes its place
+	 * @return True if the entity was found; otherwise false
+	 */
+	bool RemoveRow(ComponentRef entity)
+	{
+		auto it = std::find(entities.begin(), entities.end(), entity);
+		if (it == entities.end())
+			return false;
+
+		size_t row = static_cast<size_t>(it - entities.begin());
+
+		entities[row] = entities.back();
+		entities.pop_back();
+
+		for (auto& column : columns)
+		{
+			column[row] = column.back();
+			column.pop_back();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Returns the index of the column of the given type, or npos if the
+	 * entities of this table don't own it
+	 */
+	size_t FindColumn(const ComponentStorageBase* type) const
+	{
+		auto it = std::lower_bound(types.begin(), types.end(), type);
+		if (it == types.end() or *it != type)
+			return npos;
+
+		return static_cast<size_t>(it - types.begin());
+	}
+
+	/** Returns the addresses of the components of a column */
+	const std::vector<void*>& GetColumn(size_t column) const { return columns[column]; }
+
+	/** Returns the addresses of the components of a column */
+	std::vector<void*>& GetColumn(size_t column) { return columns[column]; }
+
+	/** Returns the number of rows (i.e. entities) */
+	size_t Size() const { return entities.size(); }
+
+	/** Returns the storages of the component types, sorted */
+	const std::vector<ComponentStorageBase*>& GetTypes() const { return types; }
+
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+	/// Storage of each component type, sorted
+	std::vector<ComponentStorageBase*> types;
+
+	/// One column per component type
+	std::vector<std::vector<void*>> columns;
+
+	/// Entity of each row
+	std::vector<ComponentRef> entities;
+};
+
+
+/**
+ * View over all the entities that own components of types Ts, as returned
+ * by Scene::Query.
+ *
+ * @code
+ * scene.Query<Transform, Velocity>().ForEach([](Transform& t, Velocity& v) { ... });
+ * @endcode
+ *
+ * @tparam Ts Types of the components to visit
+ * @warning The view is only valid until the next entity is constructed or
+ * destroyed, and entities must not be destroyed from within ForEach
+ */
+template<class... Ts>
+class QueryView
+{
+	static_assert(sizeof...(Ts) > 0, "Query requires at least one component type");
+
+	/// A matching table and the column of each of Ts within it
+	struct Match
+	{
+		ArchetypeTable* table;
+		std::array<size_t, sizeof...(Ts)> columns;
+	};
+
+public:
+	/**
+	 * (Constructor) Selects the tables that hold all of Ts
+	 * @param [in] tables All the archetype tables of the scene
+	 * @param [in] storages Storage of each of Ts; nullptr if the scene has
+	 * no object of that type
+	 */
+	QueryView(const std::vector<ArchetypeTable*>& tables, std::array<ComponentStorageBase*, sizeof...(Ts)> storages)
+	{
+		for (auto* storage : storages)
+			if (storage == nullptr)
+				return;
+
+		for (auto* table : tables)
+		{
+			Match match{table, {}};
+
+			bool has_all = true;
+			for (size_t i = 0; i < storages.size() and has_all; ++i)
+			{
+				match.columns[i] = table->FindColumn(storages[i]);
+				has_all = match.columns[i] != ArchetypeTable::npos;
+			}
+
+			if (has_all and table->Size() > 0)
+				matches.push_back(match);
+		}
+	}
+
+	/**
+	 * Calls the input function on each entity that owns all of Ts, table by
+	 * table
+	 * @param [in] function Function that takes (Ts&...)
+	 */
+	template<class Function>
+	void ForEach(Function&& function) const
+	{
+		for (auto& match : matches)
+			ForEachRow(match, function, std::index_sequence_for<Ts...>());
+	}
+
+	/** Returns the number of matching entities */
+	size_t Size() const
+	{
+		size_t size = 0;
+		for (auto& match : matches)
+			size += match.table->Size();
+
+		return size;
+	}
+
+	/** Returns whether no entity matches */
+	bool IsEmpty() const { return Size() == 0; }
+
+private:
+	template<class Function, size_t... Is>
+	static void ForEachRow(const Match& match, Function& function, std::index_sequence<Is...>)
+	{
+		std::array<void* const*, sizeof...(Ts)> cells{match.table->GetColumn(match.columns[Is]).data()...};
+
+		const size_t rows = match.table->Size();
+		for (size_t row = 0; row < rows; ++row)
+			function(*static_cast<Ts*>(cells[Is][row])...);
+	}
+
+	/// Tables that hold all of Ts
+	std::vector<Match> matches;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_SCENE_ARCHETYPE_H
@@ -0,0 +1,394 @@
+#ifndef PIXIE_CORE_SCENE_EVENT_BUS_H
+#define PIXIE_CORE_SCENE_EVENT_BUS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Type erased base of the channel of a single event type
+ */
+class EventChannelBase
+{
+public:
+	/** Default virtual destructor */
+	virtual ~EventChannelBase() = default;
+
+	/**
+	 * Moves the events emitted since the last call out of the per-thread
+	 * buffers into the batch to deliver
+	 */
+	virtual void Collect() = 0;
+
+	/**
+	 * Hands the collected batch over to the subscribers
+	 */
+	virtual void Deliver() = 0;
+};
+
+
+/**
+ * Per-thread slots used by the event channels. Each thread that emits an
+ * event owns a slot (the lowest free one) for as long as it lives, hence
+ * the thread is the only writer of the buffers of that slot.
+ */
+class EventThreadSlots
+{
+public:
+	/// Maximum number of threads that can emit events at the same time
+	static constexpr uint32_t max_threads = 64;
+
+	/**
+	 * Returns the slot of the calling thread, acquiring one on first use
+	 * @throw std::length_error if more than max_threads threads emit events
+	 */
+	static uint32_t Current()
+	{
+		thread_local Owner owner;
+		return owner.slot;
+	}
+
+private:
+	/** Holds the slot of a thread and gives it back when the thread exits */
+	struct Owner
+	{
+		Owner() : slot(Acquire()) {}
+		~Owner() { Release(slot); }
+
+		const uint32_t slot;
+	};
+
+	static uint32_t Acquire()
+	{
+		std::lock_guard<std::mutex> lock(Mutex());
+
+		auto& used = Used();
+		auto it = std::find(used.begin(), used.end(), false);
+		if (it == used.end())
+			throw std::length_error("Too many threads emit events at the same time");
+
+		*it = true;
+		return static_cast<uint32_t>(it - used.begin());
+	}
+
+	static void Release(uint32_t slot)
+	{
+		std::lock_guard<std::mutex> lock(Mutex());
+		Used()[slot] = false;
+	}
+
+	static std::mutex& Mutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	static std::array<bool, max_threads>& Used()
+	{
+		static std::array<bool, max_threads> used{};
+		return used;
+	}
+};
+
+
+/**
+ * Channel of the events of type E.
+ *
+ * Emitted events are appended to a buffer owned by the emitting thread, so
+ * emitting never takes a lock nor contends with other threads. At the next
+ * phase boundary the buffers are drained into a single batch, slot by slot
+ * and in emission order within a thread, and the batch is handed to each
+ * subscriber in subscription order. Events emitted by the subscribers are
+ * delivered at the boundary after that.
+ *
+ * @tparam E Type of the events
+ */
+template<class E>
+class EventChannel final : public EventChannelBase
+{
+public:
+	/// Receives a batch of events
+	using Handler = std::function<void(Span<const E>)>;
+
+	/** Default constructor */
+	EventChannel() = default;
+
+	/** Releases the per-thread buffers */
+	~EventChannel() override
+	{
+		for (auto& buffer : buffers)
+			delete buffer.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Appends an event to the buffer of the calling thread
+	 * @note Lock-free, except for the very first event of each thread
+	 */
+	void Emit(E event)
+	{
+		GetBuffer(EventThreadSlots::Current()).push_back(std::move(event));
+	}
+
+	/**
+	 * Registers a handler that receives every batch of events
+	 * @return Identifier of the subscription (see Unsubscribe)
+	 */
+	uint32_t Subscribe(Handler handler)
+	{
+		handlers.push_back({next_id, std::move(handler), true});
+		return next_id++;
+	}
+
+	/**
+	 * Removes a subscription
+	 * @return True if it was found; otherwise false
+	 */
+	bool Unsubscribe(uint32_t id)
+	{
+		auto it = std::find_if(handlers.begin(), handlers.end(),
+							   [id](const Subscription& subscription) { return subscription.id == id and subscription.is_active; });
+		if (it == handlers.end())
+			return false;
+
+		// Only flagged, the handler may be the one being called
+		it->is_active = false;
+		return true;
+	}
+
+	void Collect() override
+	{
+		batch.clear();
+		for (auto& buffer : buffers)
+		{
+			if (auto* events = buffer.load(std::memory_order_acquire))
+			{
+				std::move(events->begin(), events->end(), std::back_inserter(batch));
+				events->clear();
+			}
+		}
+	}
+
+	void Deliver() override
+	{
+		// Indexed, a handler may subscribe another one, which receives the
+		// batches from the next delivery on
+		const size_t count = handlers.size();
+		if (not batch.empty())
+			for (size_t i = 0; i < count; ++i)
+				if (handlers[i].is_active)
+					handlers[i].handler(Span<const E>(batch));
+
+		handlers.erase(std::remove_if(handlers.begin(), handlers.end(),
+									  [](const Subscription& subscription) { return not subscription.is_active; }),
+					   handlers.end());
+
+		batch.clear();
+	}
+
+private:
+	struct Subscription
+	{
+		/// Identifier of the subscription
+		uint32_t id;
+
+		/// Receives the batches
+		Handler handler;
+
+		/// False once unsubscribed
+		bool is_active = true;
+	};
+
+	/**
+	 * Returns the buffer of the given thread slot, allocating it on first use
+	 */
+	std::vector<E>& GetBuffer(uint32_t slot)
+	{
+		auto& buffer = buffers[slot];
+
+		std::vector<E>* events = buffer.load(std::memory_order_acquire);
+		if (not events)
+		{
+			// Only the owner of the slot ever allocates its buffer
+			events = new std::vector<E>();
+			buffer.store(events, std::memory_order_release);
+		}
+
+		return *events;
+	}
+
+	/// Per-thread buffers of the events emitted since the last delivery
+	std::array<std::atomic<std::vector<E>*>, EventThreadSlots::max_threads> buffers{};
+
+	/// Events being delivered
+	std::vector<E> batch{};
+
+	/// Subscribers, in subscription order
+	std::vector<Subscription> handlers{};
+
+	/// Identifier of the next subscription
+	uint32_t next_id = 0;
+};
+
+
+/**
+ * Typed event bus of a scene.
+ *
+ * Objects communicate by emitting events instead of calling each other
+ * during Tick, hence they share no mutable state. Events emitted during a
+ * phase (Begin, Tick, or End) are delivered in batches, in a deterministic
+ * order, at the end of that phase (see Scene::TickObjects).
+ *
+ * @code
+ * Core::Subscribe<Collision>([](Span<const Collision> collisions) { ... });
+ * Core::Emit(Collision{a, b});
+ * @endcode
+ *
+ * @note Emit can be called from any thread. Subscribe, Unsubscribe and
+ * Flush must be called from the thread that runs the scene
+ */
+class EventBus
+{
+public:
+	/// Maximum number of event types per bus
+	static constexpr size_t max_event_types = 256;
+
+	/** Default constructor */
+	EventBus() = default;
+
+	/** Default move constructor */
+	EventBus(EventBus&&) noexcept = default;
+
+	/** Default move assignment operator */
+	EventBus& operator=(EventBus&&) noexcept = default;
+
+	/**
+	 * Emits an event, delivered at the end of the current phase
+	 * @tparam E (Automatically deduced) Type of the event
+	 */
+	template<class E>
+	void Emit(E event)
+	{
+		GetChannel<E>().Emit(std::move(event));
+	}
+
+	/**
+	 * Registers a handler that receives the events of type E, one batch per phase
+	 * @tparam E (Required) Type of the events
+	 * @param [in] handler Function that takes a Span<const E>
+	 * @return Identifier of the subscription (see Unsubscribe)
+	 */
+	template<class E, class Handler>
+	uint32_t Subscribe(Handler&& handler)
+	{
+		return GetChannel<E>().Subscribe(std::forward<Handler>(handler));
+	}
+
+	/**
+	 * Removes a subscription to the events of type E
+	 * @return True if it was found; otherwise false
+	 */
+	template<class E>
+	bool Unsubscribe(uint32_t id)
+	{
+		return GetChannel<E>().Unsubscribe(id);
+	}
+
+	/**
+	 * Delivers the pending events, channel by channel in the order the
+	 * channels were created. All the channels are drained before any
+	 * handler is called, hence the events emitted by the handlers are left
+	 * for the next flush
+	 * @warning No thread may emit events while the bus is flushed
+	 */
+	void Flush()
+	{
+		const size_t count = state->channels.size();
+
+		for (size_t i = 0; i < count; ++i)
+			state->channels[i]->Collect();
+
+		// Channels created by the handlers have nothing to deliver yet
+		for (size_t i = 0; i < count; ++i)
+			state->channels[i]->Deliver();
+	}
+
+private:
+	/** Channels and their lookup table, heap allocated so that the bus is movable */
+	struct State
+	{
+		/// Event type index -> channel, null until the first use of the type
+		std::array<std::atomic<EventChannelBase*>, max_event_types> lookup{};
+
+		/// Channels, in creation order
+		std::vector<std::unique_ptr<EventChannelBase>> channels{};
+
+		/// Guards the creation of channels
+		std::mutex mutex{};
+	};
+
+	/**
+	 * Returns the process-wide index of event type E
+	 */
+	template<class E>
+	static size_t EventTypeIndex()
+	{
+		static const size_t index = NextEventTypeIndex()++;
+		return index;
+	}
+
+	static std::atomic<size_t>& NextEventTypeIndex()
+	{
+		static std::atomic<size_t> next{0};
+		return next;
+	}
+
+	/**
+	 * Returns the channel of event type E, creating it on first use
+	 * @throw std::length_error if there are more than max_event_types types
+	 */
+	template<class E>
+	EventChannel<E>& GetChannel()
+	{
+		const size_t index = EventTypeIndex<E>();
+		if (index >= max_event_types)
+			throw std::length_error("Too many event types");
+
+		auto& entry = state->lookup[index];
+
+		EventChannelBase* channel = entry.load(std::memory_order_acquire);
+		if (not channel)
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+
+			channel = entry.load(std::memory_order_acquire);
+			if (not channel)
+			{
+				state->channels.push_back(std::make_unique<EventChannel<E>>());
+				channel = state->channels.back().get();
+				entry.store(channel, std::memory_order_release);
+			}
+		}
+
+		return static_cast<EventChannel<E>&>(*channel);
+	}
+
+	/// Channels of the bus
+	std::unique_ptr<State> state = std::make_unique<State>();
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_SCENE_EVENT_BUS_H
@@ -6,16 +6,32 @@
 #include <stack>
 #include <sstream>
 #include <functional>
+#include <map>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 
 #include "Pixie/Concepts/Object.h"
 #include "Pixie/Concepts/Tickable.h"
 #include "Pixie/Concepts/PObject.h"
+#include "Pixie/Core/Storage/ComponentStorage.h"
+#include "Pixie/Core/Storage/Handle.h"
+#include "Pixie/Core/Storage/MemoryStats.h"
+#include "Pixie/Core/Storage/PObjectBatch.h"
+#include "Pixie/Core/Storage/SparseSet.h"
+#include "Archetype.h"
 #include "Tree.h"
 
 namespace pixie
 {
 
+/**
+ * What looking up a component of type T returns: a handle for the objects
+ * of the scene storage, or a pointer for the ones stored in a sparse set
+ */
+template<class T>
+using ComponentLookup = std::conditional_t<IsSparse<T>, T*, Handle<T>>;
+
 /**
  * An exclusive scene data structure that holds all the scene entities and
  * their respective components. Each group of entities and components are
@@ -27,6 +43,7 @@ namespace pixie
  * - Create a tree using entity object as the root
  * - Complete the tree using the construction dependencies of the objects
  * - Keep the trees sorted based on their Tick execution group
+ * - Own the per-type storages where the entities and components live
  *
  * Usage:
  * 1. Call CreateObject when creating the entity (usually an agent
@@ -40,52 +57,378 @@ public:
 	/** Default constructor */
 	Forest() = default;
 
+	/** Default move constructor */
+	Forest(Forest&&) noexcept = default;
+
+	/**
+	 * Move assignment operator
+	 * @note The current content is swapped into the other forest so that it
+	 * is released in order (see the destructor) once the other one is gone
+	 */
+	Forest& operator=(Forest&& other) noexcept
+	{
+		using std::swap;
+
+		swap(trees, other.trees);
+		swap(memory, other.memory);
+		swap(pobject_batches, other.pobject_batches);
+		swap(storages, other.storages);
+		swap(tick_batches, other.tick_batches);
+		swap(sparse_sets, other.sparse_sets);
+		swap(sparse_tick_batches, other.sparse_tick_batches);
+		swap(pending_removal, other.pending_removal);
+		swap(concept_batches, other.concept_batches);
+		swap(archetypes, other.archetypes);
+		swap(archetype_tables, other.archetype_tables);
+		swap(pending_destruction, other.pending_destruction);
+		swap(is_dispatching, other.is_dispatching);
+		swap(frame, other.frame);
+		swap(component_level, other.component_level);
+		swap(temp_buffer, other.temp_buffer);
+
+		return *this;
+	}
+
+	/**
+	 * Destructor. Releases the trees one by one before the storages are
+	 * torn down, so that each entity is destroyed before its components
+	 */
+	~Forest()
+	{
+		for (auto& tree : trees)
+			tree.Release();
+	}
+
 	/**
 	 * Constructs a new tree with the Scene entity of type T assigned to
 	 * its root
 	 * @tparam T (Required) Type of the object that is being created and
 	 * assigned to the root of the new tree
-	 * @return A pointer to the newly created object T
-	 * @warning Do NOT delete this pointer
+	 * @return A handle to the newly created object T
 	 */
 	template<class T>
-	T* ConstructEntity()
+	Handle<T> ConstructEntity()
 	{
-		using std::get;
-		using std::move;
-
 		// Initialize a new tree for this object and it's components
 		int tick_group = static_cast<int>(trees.size());
 		auto& tree = trees.emplace_back(Tree(tick_group));
 
-		// Create the object T
-		PObject obj;
-		obj.Create<T>();
+		// Construct the object T in place. Its components are constructed
+		// (and queued in the temporary buffer) from within its constructor
+		Handle<T> handle = GetStorage<T>().Emplace();
 
-		// Unless the concept object itself is copied, this pointer
-		// remains valid because the object T is held
-		// by a unique ptr within the pixie concept object
-		T* ptr = obj.StaticCast<T>();
+		if constexpr (IsTracked<T>)
+			MarkChanged(handle);
 
-		// Move the object to the root of newly initialized tree
-		tree.AddRoot(move(obj));
+		// Assign the object to the root of newly initialized tree
+		tree.AddRoot(ComponentRef(handle));
 
 		// All components of the T should have been initialized and stored
 		// by now. Move them from temporary buffers to grow the tree
 		PopulateTree(&tree);
 
+		AddToArchetype(&tree);
+
 		// The dependency tree is formed and all objects are stored in
-		// this tree. Clear the temporary buffers and return the pointer
+		// this tree. Clear the temporary buffers and return the handle
 		// to entity object T
 		ClearBuffers();
 
-		return ptr;
+		return handle;
+	}
+
+	/**
+	 * Destroys the entity along with all the components in its tree. All
+	 * handles to these objects become stale.
+	 * @tparam T (Automatically deduced) Type of the entity
+	 * @param [in] entity Handle to an entity constructed by ConstructEntity
+	 * @return True if the entity was found and destroyed (or queued to be
+	 * destroyed); otherwise false
+	 * @note If called while Begin, Tick or End are being dispatched, the
+	 * destruction is deferred until the dispatch is over
+	 */
+	template<class T>
+	bool DestroyEntity(Handle<T> entity)
+	{
+		ComponentRef ref(entity);
+
+		if (not ref.IsValid())
+			return false;
+
+		if (is_dispatching)
+		{
+			pending_destruction.push_back(ref);
+			return true;
+		}
+
+		return DestroyTree(ref);
+	}
+
+	/**
+	 * Returns the storage of objects of type T. Creates one if this is the
+	 * first object of its type
+	 * @tparam T (Required) Type of the stored objects
+	 */
+	template<class T>
+	ComponentStorage<T>& GetStorage()
+	{
+		static_assert(not IsSparse<T>, "Objects stored in a sparse set are attached at runtime with AddComponent");
+
+		auto& storage = storages[std::type_index(typeid(T))];
+		if (not storage)
+		{
+			storage = std::make_unique<ComponentStorage<T>>();
+			storage->SetParentAccount(memory.get());
+			storage->SetStorageId(static_cast<uint32_t>(storages.size() - 1));
+
+			if (storage->ImplementsTick())
+				tick_batches.push_back(storage.get());
+
+			if (concept_batches.size() < storage->ConceptCount())
+				concept_batches.resize(storage->ConceptCount());
+
+			for (size_t i = 0; i < storage->ConceptCount(); ++i)
+				if (auto dispatch = storage->GetConceptDispatcher(i))
+					concept_batches[i].push_back({storage.get(), dispatch});
+		}
+
+		return static_cast<ComponentStorage<T>&>(*storage);
+	}
+
+	/**
+	 * Returns the storage of objects of type T, if any
+	 * @tparam T (Required) Type of the stored objects
+	 * @return The storage, or a nullptr if no object of type T was ever
+	 * constructed
+	 */
+	template<class T>
+	ComponentStorageBase* FindStorage() const
+	{
+		auto it = storages.find(std::type_index(typeid(T)));
+		return it != storages.end() ? it->second.get() : nullptr;
+	}
+
+	/**
+	 * Looks up the object of type T within the entity that owns the input
+	 * object, i.e. among the entity itself and all of its components
+	 * @tparam T (Required) Type of the object to look up
+	 * @tparam U (Automatically deduced) Type of the owned object
+	 * @param [in] owned Handle to the entity or to any of its components
+	 * @return A handle to the first object of type T of the entity, or a
+	 * null handle if it has none
+	 * @note Constant time. The types are identified at compile time
+	 * @warning Objects are only linked to their entity once it is fully
+	 * constructed, hence the lookup fails from within constructors
+	 */
+	template<class T, class U, std::enable_if_t<not IsSparse<T>> * = nullptr>
+	Handle<T> GetComponent(Handle<U> owned) const
+	{
+		const ComponentRef* ref = FindComponent(ComponentRef(owned), type_id<T>);
+		return ref ? ref->As<T>() : Handle<T>();
+	}
+
+	/**
+	 * Looks up the component of type T that is attached at runtime to the
+	 * entity that owns the input object (see AddComponent)
+	 * @tparam T (Required) Type of the component, stored in a sparse set
+	 * @tparam U (Automatically deduced) Type of the owned object
+	 * @param [in] owned Handle to the entity or to any of its components
+	 * @return A pointer to the component, or a nullptr if it has none
+	 * @warning The pointer is invalidated by the next AddComponent or
+	 * RemoveComponent of type T
+	 */
+	template<class T, class U, std::enable_if_t<IsSparse<T>> * = nullptr>
+	T* GetComponent(Handle<U> owned) const
+	{
+		EntityKey key;
+		auto* set = FindSparseSet<T>();
+		return set and FindEntity(ComponentRef(owned), key) ? set->Find(key) : nullptr;
+	}
+
+	/**
+	 * Checks whether the entity that owns the input object also owns an
+	 * object of type T
+	 * @see GetComponent
+	 */
+	template<class T, class U>
+	bool HasComponent(Handle<U> owned) const
+	{
+		if constexpr (IsSparse<T>)
+			return GetComponent<T>(owned) != nullptr;
+		else
+			return FindComponent(ComponentRef(owned), type_id<T>) != nullptr;
+	}
+
+	/**
+	 * Attaches a component of type T to the entity that owns the input
+	 * object. Replaces the current one if the entity already has one.
+	 * @tparam T (Required) Type of the component, stored in a sparse set
+	 * (see SparseStorage)
+	 * @tparam U (Automatically deduced) Type of the owned object
+	 * @param [in] owned Handle to the entity or to any of its components
+	 * @param [in] args Arguments forwarded to the constructor of T
+	 * @return A pointer to the component, or a nullptr if the entity is not
+	 * alive (or not fully constructed yet)
+	 * @note Constant time (amortized)
+	 * @warning Do not add a component of type T from within the Tick of
+	 * another component of type T
+	 */
+	template<class T, class U, class... Args>
+	T* AddComponent(Handle<U> owned, Args&&... args)
+	{
+		static_assert(IsSparse<T>, "Only objects stored in a sparse set can be attached at runtime. "
+								   "Declare 'using storage_policy = pixie::SparseStorage;' in the type");
+
+		EntityKey key;
+		if (not FindEntity(ComponentRef(owned), key))
+			return nullptr;
+
+		return &GetSparseSet<T>().Add(key, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Detaches and destroys the component of type T of the entity that owns
+	 * the input object
+	 * @return True if the entity had one; otherwise false
+	 * @note Constant time. If called while Begin, Tick or End are being
+	 * dispatched, the removal is deferred until the dispatch is over
+	 */
+	template<class T, class U>
+	bool RemoveComponent(Handle<U> owned)
+	{
+		static_assert(IsSparse<T>, "Only objects stored in a sparse set can be removed at runtime");
+
+		EntityKey key;
+		auto* set = FindSparseSet<T>();
+		if (not set or not FindEntity(ComponentRef(owned), key) or not set->Contains(key))
+			return false;
+
+		if (is_dispatching)
+		{
+			pending_removal.emplace_back(set, key);
+			return true;
+		}
+
+		return set->Remove(key);
+	}
+
+	/**
+	 * Returns the sparse set of the components of type T. Creates one if this
+	 * is the first component of its type
+	 * @tparam T (Required) Type of the components
+	 */
+	template<class T>
+	SparseSet<T>& GetSparseSet()
+	{
+		auto& set = sparse_sets[std::type_index(typeid(T))];
+		if (not set)
+		{
+			set = std::make_unique<SparseSet<T>>();
+			set->SetParentAccount(memory.get());
+
+			if constexpr (IsTickable<T>)
+				sparse_tick_batches.push_back(set.get());
+		}
+
+		return static_cast<SparseSet<T>&>(*set);
+	}
+
+	/**
+	 * Returns the sparse set of the components of type T, if any
+	 */
+	template<class T>
+	SparseSet<T>* FindSparseSet() const
+	{
+		auto it = sparse_sets.find(std::type_index(typeid(T)));
+		return it != sparse_sets.end() ? static_cast<SparseSet<T>*>(it->second.get()) : nullptr;
+	}
+
+	/**
+	 * Queries the archetype tables for all the entities that own components
+	 * of types Ts
+	 * @tparam Ts (Required) Types of the components
+	 * @return A view that visits the components of the matching entities
+	 */
+	template<class... Ts>
+	QueryView<Ts...> Query() const
+	{
+		return QueryView<Ts...>(archetype_tables, {FindStorage<Ts>()...});
+	}
+
+	/**
+	 * Returns the current frame. Objects constructed before the first Tick
+	 * belong to frame 1, and each Tick starts a new frame
+	 */
+	uint64_t GetFrame() const { return frame; }
+
+	/**
+	 * Records that the object changed on the current frame
+	 * @tparam T (Automatically deduced) Type of the object. Must track its
+	 * changes (see TrackChanges)
+	 * @param [in] handle Handle to the object
+	 * @return True if recorded; false if the object is not alive
+	 * @note Constant time (amortized). Constructing an object of a tracked
+	 * type counts as a change
+	 */
+	template<class T>
+	bool MarkChanged(Handle<T> handle)
+	{
+		static_assert(IsTracked<T>, "Changes of T are not tracked. "
+									"Declare 'using change_tracking = pixie::TrackChanges;' in the type");
+
+		auto* storage = handle.GetStorage();
+		return storage and storage->MarkChanged(handle.GetIndex(), handle.GetGeneration(), frame);
+	}
+
+	/**
+	 * Looks up the live objects of type T that changed after the given frame
+	 * @tparam T (Required) Type of the objects. Must track its changes
+	 * @param [in] since Frame of the last read (see GetFrame), or 0 for all
+	 * the objects that ever changed
+	 * @return Handles to the changed objects, in the order of their last change
+	 * @note Proportional to the number of changes, not to the number of objects
+	 */
+	template<class T>
+	std::vector<Handle<T>> ChangedSince(uint64_t since) const
+	{
+		static_assert(IsTracked<T>, "Changes of T are not tracked. "
+									"Declare 'using change_tracking = pixie::TrackChanges;' in the type");
+
+		std::vector<Handle<T>> changed;
+
+		auto* storage = static_cast<ComponentStorage<T>*>(FindStorage<T>());
+		if (not storage)
+			return changed;
+
+		storage->GetChangeLog()->ForEachSince(since, [&](uint32_t index, uint32_t generation)
+		{
+			if (storage->ComponentStorageBase::Contains(index, generation))
+				changed.push_back(storage->MakeHandle(index, generation));
+		});
+
+		return changed;
+	}
+
+	/**
+	 * Checks whether the object changed after the given frame
+	 * @see ChangedSince
+	 */
+	template<class T>
+	bool HasChangedSince(Handle<T> handle, uint64_t since) const
+	{
+		static_assert(IsTracked<T>, "Changes of T are not tracked. "
+									"Declare 'using change_tracking = pixie::TrackChanges;' in the type");
+
+		auto* storage = handle.GetStorage();
+		return storage and storage->GetChangeLog()->LastChange(handle.GetIndex(), handle.GetGeneration()) > since;
 	}
 
 	/**
 	 * Construct an object of type T and stores it within the input PObject
 	 * @tparam T (Required) Type of the component that is being created
 	 * @param A pointer to an empty PObject
+	 * @note If T is tickable, the PObject is ticked along with the other
+	 * objects of type T for as long as it holds one (see PObject::Register)
 	 */
 	template<class T>
 	void ConstructPObject(PObject* pobject)
@@ -93,9 +436,12 @@ public:
 		// See comments of ConstructComponent
 		++component_level;
 
-		PObject obj;
 		(*pobject).Create<T>();
 
+		// Tickable PObjects are registered in the batch of their type, once,
+		// so that they are never visited in Tick if they don't implement it
+		(*pobject).Register(*pobject_batches);
+
 		temp_buffer.emplace_back(pobject, component_level);
 
 		--component_level;
@@ -104,11 +450,10 @@ public:
 	/**
 	 * Constructs a component of type T and stores it in a temporary buffer
 	 * @tparam T (Required) Type of the component that is being created
-	 * @return A pointer to the created object of type T
-	 * @warning Do NOT delete this pointer
+	 * @return A handle to the created object of type T
 	 */
 	template<class T>
-	T* ConstructComponent()
+	Handle<T> ConstructComponent()
 	{
 		// A component is being created. increments the construction level
 		// to keep track of the hierarchy of this sub-component
@@ -127,20 +472,18 @@ public:
 //			throw std::runtime_error("Circular object creation detected.");
 //		}
 
-		PObject obj;
-		obj.Create<T>();
+		Handle<T> handle = GetStorage<T>().Emplace();
 
-		// the pointer remains valid because the object T is held
-		// by a unique ptr within one of the pixie's concepts
-		T* ptr = obj.StaticCast<T>();
+		if constexpr (IsTracked<T>)
+			MarkChanged(handle);
 
-		temp_buffer.emplace_back(std::move(obj), component_level);
+		temp_buffer.emplace_back(ComponentRef(handle), component_level);
 
 		// The component is fully constructed. We are now recursing back
 		// to the main object, hence we should decrement the level tracker
 		--component_level;
 
-		return ptr;
+		return handle;
 	}
 
 	/**
@@ -148,17 +491,45 @@ public:
 	 */
 	void CallBegin()
 	{
+		is_dispatching = true;
+
 		for (auto& tree : trees)
 			tree.CallBegin();
+
+		FlushPendingDestruction();
 	}
 
 	/**
-	 * Calls Tick for each execution group
+	 * Calls Tick of all the registered objects. Objects are ticked type by
+	 * type, with a single virtual call per type: first the ones owned by
+	 * PObjects, then the ones held in the scene storage in memory order
+	 * (see pixie::TickBatch)
 	 */
 	inline void CallTick()
+	{
+		++frame;
+		is_dispatching = true;
+
+		pobject_batches->TickAll();
+
+		for (auto* storage : tick_batches)
+			storage->TickAll();
+
+		// Indexed, a Tick may attach the first component of a new sparse type
+		for (size_t i = 0; i < sparse_tick_batches.size(); ++i)
+			sparse_tick_batches[i]->TickAll();
+
+		FlushPendingDestruction();
+	}
+
+	/**
+	 * Recomputes the world matrix of the dirty transforms and of the
+	 * transforms below them, tree by tree (see Transform3D)
+	 */
+	void UpdateTransforms()
 	{
 		for (auto& tree : trees)
-			tree.CallTick();
+			tree.UpdateTransforms();
 	}
 
 	/**
@@ -166,11 +537,285 @@ public:
 	 */
 	void CallEnd()
 	{
+		is_dispatching = true;
+
 		for (auto& tree : trees)
 			tree.CallEnd();
+
+		FlushPendingDestruction();
+	}
+
+	/**
+	 * Dispatches the user defined concept C to all the objects that
+	 * implement it. Objects are visited type by type, with a single call per
+	 * type that handles all of its objects in memory order (see
+	 * pixie::DispatchBatch). Types that don't implement C are never visited.
+	 * @tparam C (Required) Concept trait declared in SceneConcepts
+	 * @note Can be called from within Begin, Tick, End, or another concept
+	 */
+	template<class C>
+	void Dispatch()
+	{
+		constexpr size_t index = ConceptIndex<C, SceneConceptsOf<C>>::value;
+
+		if (index >= concept_batches.size())
+			return;
+
+		const bool is_nested = is_dispatching;
+		is_dispatching = true;
+
+		for (auto& batch : concept_batches[index])
+			batch.second(*batch.first);
+
+		if (not is_nested)
+			FlushPendingDestruction();
+	}
+
+	/**
+	 * Takes a snapshot of the memory used by the forest
+	 * @return Live and reserved memory per type, per tree and in total
+	 * @note Only the already maintained counters are copied. None of the
+	 * objects are visited
+	 */
+	MemoryStats GetMemoryStats() const
+	{
+		MemoryStats stats;
+
+		stats.types.reserve(storages.size());
+		for (auto& entry : storages)
+		{
+			auto& account = entry.second->GetMemoryAccount();
+			stats.types.push_back({entry.second->TypeName(), account.live, account.reserved_bytes});
+		}
+
+		for (auto& entry : sparse_sets)
+		{
+			auto& account = entry.second->GetMemoryAccount();
+			stats.types.push_back({entry.second->TypeName(), account.live, account.reserved_bytes});
+		}
+
+		std::sort(stats.types.begin(), stats.types.end(),
+				  [](const TypeMemoryStats& a, const TypeMemoryStats& b) { return a.live.bytes > b.live.bytes; });
+
+		stats.trees.reserve(trees.size());
+		for (auto& tree : trees)
+			stats.trees.push_back({tree.tick_group, tree.memory});
+
+		if (memory)
+		{
+			stats.scene = memory->live;
+			stats.reserved_bytes = memory->reserved_bytes;
+		}
+
+		return stats;
+	}
+
+	/**
+	 * Defragments the scene storage. The live objects of each type are moved
+	 * next to each other, in the order they are visited by Tick, and the
+	 * memory left behind by destroyed objects is released. Handles remain
+	 * valid and the PObjects registered in the trees are re-pointed to the
+	 * new address of their outer objects.
+	 * @return True if the forest was compacted; false if it was called during
+	 * dispatch or construction, in which case nothing is moved
+	 * @warning Raw pointers and references to scene objects are invalidated
+	 */
+	bool Compact()
+	{
+		if (is_dispatching or component_level != 0 or not temp_buffer.empty())
+			return false;
+
+		// Order in which the objects of each type are visited
+		std::unordered_map<ComponentStorageBase*, std::vector<uint32_t>> visit_order;
+		for (auto& tree : trees)
+		{
+			for (auto& ref : tree.objects)
+				visit_order[ref.storage].push_back(ref.index);
+
+			for (auto& ref : tree.tickables)
+				visit_order[ref.storage].push_back(ref.index);
+		}
+
+		std::vector<Relocation> relocations;
+		for (auto& entry : storages)
+			entry.second->Relocate(visit_order[entry.second.get()], relocations);
+
+		// PObjects are owned by (and live inside of) their outer object. Move
+		// their pointers along with the outer object
+		std::sort(relocations.begin(), relocations.end(),
+				  [](const Relocation& a, const Relocation& b) { return a.old_begin < b.old_begin; });
+
+		for (auto* table : archetype_tables)
+			for (size_t column = 0; column < table->GetTypes().size(); ++column)
+				for (auto& cell : table->GetColumn(column))
+					cell = Rebase(cell, relocations);
+
+		for (size_t i = 0; i < trees.size(); ++i)
+		{
+			for (auto& pobject : trees[i].pobjects)
+				pobject = Rebase(pobject, relocations);
+
+			trees[i].tick_group = static_cast<int>(i);
+			trees[i].RelinkNodes();
+		}
+
+		return true;
 	}
 
 private:
+	/**
+	 * Translates an address that lies within one of the relocated objects to
+	 * the same offset within the new address of that object
+	 * @param [in] ptr The address to translate
+	 * @param [in] relocations Relocation records sorted by their old address
+	 * @return The translated address, or ptr itself if it was not relocated
+	 */
+	template<class P>
+	static P* Rebase(P* ptr, const std::vector<Relocation>& relocations)
+	{
+		auto address = reinterpret_cast<uintptr_t>(ptr);
+
+		auto it = std::upper_bound(relocations.begin(), relocations.end(), address,
+								   [](uintptr_t a, const Relocation& r) { return a < r.old_begin; });
+
+		if (it == relocations.begin())
+			return ptr;
+
+		--it;
+		if (address >= it->old_end)
+			return ptr;
+
+		return reinterpret_cast<P*>(it->new_begin + (address - it->old_begin));
+	}
+
+	/**
+	 * Destroys the tree whose root is the given entity and re-assigns the
+	 * tick group of the trees that come after it
+	 * @param [in] entity Reference to the entity at the root of the tree
+	 * @return True if such a tree was found; otherwise false
+	 */
+	bool DestroyTree(ComponentRef entity)
+	{
+		auto it = std::find_if(trees.begin(), trees.end(),
+							   [&](const Tree& tree) { return tree.entity == entity; });
+
+		if (it == trees.end())
+			return false;
+
+		if (it->archetype)
+			it->archetype->RemoveRow(it->entity);
+
+		EntityKey key{entity.storage->GetStorageId(), entity.index};
+		for (auto& entry : sparse_sets)
+			entry.second->Remove(key);
+
+		it->Release();
+		it = trees.erase(it);
+
+		// Erasing from the middle of the deque may shift the trees on either
+		// side of it. Fix up their tick group and the links of their nodes
+		for (size_t i = 0; i < trees.size(); ++i)
+		{
+			trees[i].tick_group = static_cast<int>(i);
+			trees[i].RelinkNodes();
+		}
+
+		return true;
+	}
+
+	/**
+	 * Looks up the object of the given type within the entity that owns the
+	 * referred object
+	 */
+	static const ComponentRef* FindComponent(ComponentRef owned, TypeId type)
+	{
+		if (not owned.IsValid())
+			return nullptr;
+
+		const ComponentTable* table = owned.storage->GetComponentTable(owned.index);
+		return table ? table->Find(type) : nullptr;
+	}
+
+	/**
+	 * Finds the entity that owns the referred object
+	 * @param [in] owned Reference to the entity or to any of its components
+	 * @param [out] key Key of the entity
+	 * @return True if the object is alive and is part of an entity
+	 */
+	static bool FindEntity(ComponentRef owned, EntityKey& key)
+	{
+		if (not owned.IsValid())
+			return false;
+
+		const ComponentTable* table = owned.storage->GetComponentTable(owned.index);
+		if (not table)
+			return false;
+
+		ComponentRef entity = table->GetEntity();
+		key = {entity.storage->GetStorageId(), entity.index};
+		return true;
+	}
+
+	/**
+	 * Adds the tree as a row of the table of its archetype, i.e. of the set
+	 * of types of its entity and components. Creates the table if this is
+	 * the first tree of its archetype
+	 */
+	void AddToArchetype(Tree* tree)
+	{
+		std::vector<std::pair<ComponentStorageBase*, void*>> cells;
+		cells.reserve(tree->objects.size() + tree->tickables.size());
+
+		for (auto* list : {&tree->objects, &tree->tickables})
+			for (auto& ref : *list)
+				cells.emplace_back(ref.storage, ref.storage->AddressOf(ref.index));
+
+		// One column per type. The stable sort keeps the first component
+		// of each type
+		std::stable_sort(cells.begin(), cells.end(),
+						 [](const auto& a, const auto& b) { return a.first < b.first; });
+		cells.erase(std::unique(cells.begin(), cells.end(),
+								[](const auto& a, const auto& b) { return a.first == b.first; }),
+					cells.end());
+
+		std::vector<ComponentStorageBase*> types;
+		std::vector<void*> addresses;
+		for (auto& cell : cells)
+		{
+			types.push_back(cell.first);
+			addresses.push_back(cell.second);
+		}
+
+		auto& table = archetypes[types];
+		if (not table)
+		{
+			table = std::make_unique<ArchetypeTable>(types);
+			archetype_tables.push_back(table.get());
+		}
+
+		table->AddRow(tree->entity, addresses);
+		tree->archetype = table.get();
+	}
+
+	/**
+	 * Destroys the entities that were queued for destruction during
+	 * dispatch of Begin, Tick or End
+	 */
+	void FlushPendingDestruction()
+	{
+		is_dispatching = false;
+
+		for (auto& removal : pending_removal)
+			removal.first->Remove(removal.second);
+
+		pending_removal.clear();
+
+		for (auto& ref : pending_destruction)
+			DestroyTree(ref);
+
+		pending_destruction.clear();
+	}
+
 	/**
 	 * Populates the tree using the root object components stored in a
 	 * temporary buffer
@@ -301,6 +946,17 @@ private:
 		}
 
 		tree->ReverseContainers();
+
+		// Nodes are copied around while the tree grows. Point them back to
+		// their actual parents
+		tree->RelinkNodes();
+
+		tree->BuildPhaseLists();
+
+		tree->BuildComponentTable();
+
+		tree->BuildTransformHierarchy();
+		tree->UpdateTransforms();
 	}
 
 	/**
@@ -316,15 +972,59 @@ private:
 	/// Vector of trees sorted by their tick group
 	std::deque<Tree> trees;
 
+	/// Memory account of the whole forest that all the storages report to
+	/// @note Heap allocated so that it doesn't move along with the forest
+	std::unique_ptr<MemoryAccount> memory = std::make_unique<MemoryAccount>();
+
+	/// Batches of the tickable objects owned by PObjects, per type
+	/// @note Heap allocated so that the PObjects registered in it can refer
+	/// to it while the forest moves. Outlives the storages, hence the PObjects
+	std::unique_ptr<PObjectBatches> pobject_batches = std::make_unique<PObjectBatches>();
+
+	/// Per-type storages where all the entities and components live
+	std::unordered_map<std::type_index, std::unique_ptr<ComponentStorageBase>> storages;
+
+	/// Storages of the types that implement Tick, in the order their first
+	/// object was constructed. This is the order in which types are ticked
+	std::vector<ComponentStorageBase*> tick_batches;
+
+	/// Per user defined concept, the storages of the types that implement it
+	/// and their dispatcher, in the order their first object was constructed
+	std::vector<std::vector<std::pair<ComponentStorageBase*, ComponentStorageBase::ConceptDispatcher>>> concept_batches;
+
+	/// Table of each archetype, i.e. of each set of types owned by an entity
+	std::map<std::vector<ComponentStorageBase*>, std::unique_ptr<ArchetypeTable>> archetypes;
+
+	/// Archetype tables, in the order they were created
+	std::vector<ArchetypeTable*> archetype_tables;
+
+	/// Sparse sets of the components attached at runtime, per type
+	std::unordered_map<std::type_index, std::unique_ptr<SparseSetBase>> sparse_sets;
+
+	/// Sparse sets of the types that implement Tick, in the order they were created
+	std::vector<SparseSetBase*> sparse_tick_batches;
+
+	/// Components whose removal is deferred until the end of the current dispatch
+	std::vector<std::pair<SparseSetBase*, EntityKey>> pending_removal;
+
+	/// Entities whose destruction is deferred until the end of the current dispatch
+	std::vector<ComponentRef> pending_destruction;
+
+	/// True while Begin, Tick or End are being dispatched
+	bool is_dispatching = false;
+
+	/// Current frame, incremented by every Tick (see GetFrame)
+	uint64_t frame = 1;
+
 	/// Tracks the construction level of the object and its components
 	int component_level = 0;
 
 	/// Temporary buffer that holds components of the Outer object
 
 #ifdef __APPLE_CLANG__
-	std::deque<std::pair<mpark::variant<PObject, PObject*>, int>> temp_buffer;
+	std::deque<std::pair<mpark::variant<ComponentRef, PObject*>, int>> temp_buffer;
 #else
-	std::deque<std::pair<std::variant<PObject, PObject*>, int>> temp_buffer;
+	std::deque<std::pair<std::variant<ComponentRef, PObject*>, int>> temp_buffer;
 #endif
 };
 
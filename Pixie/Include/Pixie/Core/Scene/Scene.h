@@ -7,8 +7,18 @@
 
 #include "Pixie/Concepts/Object.h"
 #include "Pixie/Concepts/Tickable.h"
+#include "Pixie/Core/Scene/EventBus.h"
 #include "Pixie/Core/Scene/Forest.h"
+#include "Pixie/Core/Scene/StaticScene.h"
+#include "Pixie/Core/Storage/Handle.h"
+#include "Pixie/Core/Storage/MemoryStats.h"
+#include "Pixie/Environment/Policy.h"
+#include "Pixie/Environment/SpaceBuffer.h"
 #include "Pixie/Misc/Placeholders.h"
+#include "Pixie/Physics/PhysicsWorld2D.h"
+#include "Pixie/Spatial/Broadphase.h"
+#include "Pixie/Spatial/Raycaster.h"
+#include "Pixie/Spatial/SpatialHash.h"
 #include "Pixie/Utility/TypeTraits.h"
 #include "Pixie/Concepts/PObject.h"
 
@@ -29,6 +39,12 @@ public:
 	/** Default destructor */
 	~Scene() = default;
 
+	/** Default move constructor */
+	Scene(Scene&&) noexcept = default;
+
+	/** Default move assignment operator */
+	Scene& operator=(Scene&&) noexcept = default;
+
 public: // public APIs
 	/**
 	 * Calls the Begin method of all the registered objects (if implemented)
@@ -67,28 +83,288 @@ public: // public APIs
 	Tickable& GetGameManagerRef()	 	  { return game_manager; }
 	const Tickable& GetGameManagerRef() const {	return game_manager; }
 
+	/**
+	 * Returns the spatial hash of the scene, where objects register their
+	 * positions to answer neighbor queries
+	 * @note Staged changes are committed at the end of Begin and of Tick
+	 */
+	SpatialHash& GetSpatialHash()			  { return spatial_hash; }
+	const SpatialHash& GetSpatialHash() const { return spatial_hash; }
+
+	/**
+	 * Returns the geometry of the scene that rays are cast against
+	 * @note Staged changes are committed at the end of Begin and of Tick
+	 */
+	Raycaster& GetRaycaster()			  { return raycaster; }
+	const Raycaster& GetRaycaster() const { return raycaster; }
+
+	/**
+	 * Returns the broadphase of the scene, whose overlaps are emitted as
+	 * OverlapBegin and OverlapEnd events
+	 * @note Staged changes are committed at the end of Begin and of Tick
+	 */
+	Broadphase& GetBroadphase()			  { return broadphase; }
+	const Broadphase& GetBroadphase() const { return broadphase; }
+
+	/**
+	 * Returns the 2D rigid bodies of the scene
+	 * @note Stepped after the objects Tick and before the game manager Tick
+	 */
+	PhysicsWorld2D& GetPhysics()			 { return physics; }
+	const PhysicsWorld2D& GetPhysics() const { return physics; }
+
+	/**
+	 * Returns the observations of the scene, written by the objects and read
+	 * by the learner as tensors without copy
+	 */
+	SpaceBuffer& GetObservations()			   { return observations; }
+	const SpaceBuffer& GetObservations() const { return observations; }
+
+	/**
+	 * Returns the actions of the scene, written by the learner and read by
+	 * the objects
+	 */
+	SpaceBuffer& GetActions()			  { return actions; }
+	const SpaceBuffer& GetActions() const { return actions; }
+
+	/**
+	 * Sets the policy that decides the actions of the whole batch of agents
+	 * from their observations, at the end of Begin and of each Tick
+	 * @param [in] in_policy The policy, or an empty function to remove it
+	 * @see Policy
+	 */
+	void SetPolicy(Policy in_policy) { policy = std::move(in_policy); }
+
 	/**
 	 * Creates and adds an object of type T into the scene
 	 * @tparam T (Required) Type of the object that is being created and registered
-	 * @return A pointer to the created object
-	 * @warning Do NOT delete the returned pointer
+	 * @return A handle to the created object
 	 */
 	template<class T>
-	T* ConstructEntity()
+	Handle<T> ConstructEntity()
 	{
 		return forest.ConstructEntity<T>();
 	}
 
+	/**
+	 * Removes the entity and all its components from the scene
+	 * @tparam T (Automatically deduced) Type of the entity
+	 * @param [in] entity Handle to the entity
+	 * @return True if the entity was alive and is now destroyed; otherwise false
+	 * @note Destruction requested from within Begin, Tick or End of the scene
+	 * objects is deferred until all of them are done
+	 */
+	template<class T>
+	bool DestroyEntity(Handle<T> entity)
+	{
+		return forest.DestroyEntity(entity);
+	}
+
+	/**
+	 * Defragments the storage of the scene objects so that the objects of
+	 * each type are contiguous in memory and laid out in their tick order.
+	 * Meant to be called at episode boundaries, after many entities have been
+	 * spawned and destroyed.
+	 * @return True if compacted; false if called while the objects are being
+	 * constructed or dispatched
+	 * @note Handles remain valid, raw pointers to scene objects do not
+	 */
+	bool Compact()
+	{
+		return forest.Compact();
+	}
+
+	/**
+	 * Creates a static scene with a fixed set of object types and hosts it
+	 * along with the dynamic objects of this scene. Its objects are driven
+	 * right after the dynamic ones in every phase.
+	 * @tparam Ts (Required) Types of the objects held by the static scene
+	 * @return A pointer to the static scene to populate
+	 * @warning Do NOT delete the returned pointer
+	 * @see StaticScene
+	 */
+	template<class... Ts>
+	StaticScene<Ts...>* CreateStaticScene()
+	{
+		auto static_scene = std::make_unique<StaticScene<Ts...>>();
+		auto* ptr = static_scene.get();
+		static_scenes.push_back(std::move(static_scene));
+		return ptr;
+	}
+
+	/**
+	 * Dispatches the user defined concept C to all the dynamic and static
+	 * scene objects that implement it
+	 * @tparam C (Required) Concept trait declared in SceneConcepts
+	 * @see SceneConcepts
+	 */
+	template<class C>
+	void Dispatch()
+	{
+		forest.Dispatch<C>();
+
+		constexpr size_t index = ConceptIndex<C, SceneConceptsOf<C>>::value;
+		for (auto& static_scene : static_scenes)
+			static_scene->DispatchConcept(index);
+	}
+
+	/**
+	 * Looks up the object of type T within the entity that owns the input
+	 * object (the entity itself or any of its components)
+	 * @return A handle to the object, or a null handle if there is none (a
+	 * pointer, or a nullptr, if T is stored in a sparse set)
+	 * @see Forest::GetComponent
+	 */
+	template<class T, class U>
+	ComponentLookup<T> GetComponent(Handle<U> owned) const
+	{
+		return forest.GetComponent<T>(owned);
+	}
+
+	/**
+	 * Checks whether the entity that owns the input object owns an object of type T
+	 * @see Forest::HasComponent
+	 */
+	template<class T, class U>
+	bool HasComponent(Handle<U> owned) const
+	{
+		return forest.HasComponent<T>(owned);
+	}
+
+	/**
+	 * Attaches a component of type T, stored in a sparse set, to the entity
+	 * that owns the input object
+	 * @see Forest::AddComponent
+	 */
+	template<class T, class U, class... Args>
+	T* AddComponent(Handle<U> owned, Args&&... args)
+	{
+		return forest.AddComponent<T>(owned, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Detaches the component of type T from the entity that owns the input object
+	 * @see Forest::RemoveComponent
+	 */
+	template<class T, class U>
+	bool RemoveComponent(Handle<U> owned)
+	{
+		return forest.RemoveComponent<T>(owned);
+	}
+
+	/**
+	 * Returns the sparse set of the components of type T, e.g. to iterate
+	 * over all of them
+	 * @see Forest::GetSparseSet
+	 */
+	template<class T>
+	SparseSet<T>& GetSparseSet()
+	{
+		return forest.GetSparseSet<T>();
+	}
+
+	/**
+	 * Queries the scene for all the entities that own components of types
+	 * Ts (the entity type itself included), e.g.
+	 * Query<Transform, Velocity>().ForEach([](Transform& t, Velocity& v) { ... });
+	 * @tparam Ts (Required) Types of the components
+	 * @return A view over the matching entities, backed by the archetype
+	 * tables that are maintained as entities are constructed and destroyed
+	 * @see QueryView
+	 */
+	template<class... Ts>
+	QueryView<Ts...> Query() const
+	{
+		return forest.Query<Ts...>();
+	}
+
+	/**
+	 * Emits an event, delivered in a batch to the subscribers of its type at
+	 * the end of the current phase (Begin, Tick, or End)
+	 * @see EventBus::Emit
+	 */
+	template<class E>
+	void Emit(E event)
+	{
+		events.Emit(std::move(event));
+	}
+
+	/**
+	 * Registers a handler that receives the events of type E, one batch per phase
+	 * @see EventBus::Subscribe
+	 */
+	template<class E, class Handler>
+	uint32_t Subscribe(Handler&& handler)
+	{
+		return events.Subscribe<E>(std::forward<Handler>(handler));
+	}
+
+	/**
+	 * Removes a subscription to the events of type E
+	 * @see EventBus::Unsubscribe
+	 */
+	template<class E>
+	bool Unsubscribe(uint32_t id)
+	{
+		return events.Unsubscribe<E>(id);
+	}
+
+	/**
+	 * Returns the current frame
+	 * @see Forest::GetFrame
+	 */
+	uint64_t GetFrame() const { return forest.GetFrame(); }
+
+	/**
+	 * Records that the object changed on the current frame
+	 * @see Forest::MarkChanged
+	 */
+	template<class T>
+	bool MarkChanged(Handle<T> handle)
+	{
+		return forest.MarkChanged(handle);
+	}
+
+	/**
+	 * Looks up the live objects of type T that changed after the given frame
+	 * @see Forest::ChangedSince
+	 */
+	template<class T>
+	std::vector<Handle<T>> ChangedSince(uint64_t since) const
+	{
+		return forest.ChangedSince<T>(since);
+	}
+
+	/**
+	 * Checks whether the object changed after the given frame
+	 * @see Forest::HasChangedSince
+	 */
+	template<class T>
+	bool HasChangedSince(Handle<T> handle, uint64_t since) const
+	{
+		return forest.HasChangedSince(handle, since);
+	}
+
+	/**
+	 * Returns a snapshot of the memory used by the scene objects, per type,
+	 * per tree (i.e. entity) and in total
+	 * @note The counters are maintained as objects are created and destroyed,
+	 * hence taking a snapshot does not visit any of the objects
+	 */
+	MemoryStats GetMemoryStats() const
+	{
+		return forest.GetMemoryStats();
+	}
+
 	/**
 	 * Queries the scene forest to constructs a component of type T
 	 * which will also queue the component for registration in its outer's
 	 * dependency tree
 	 * @tparam T (Required) Type of the component that is being created
-	 * @return A pointer to the created component
-	 * @warning Do NOT delete the returned pointer
+	 * @return A handle to the created component
 	 */
 	template<class T>
-	inline T* ConstructComponent()
+	inline Handle<T> ConstructComponent()
 	{
 		return forest.ConstructComponent<T>();
 	}
@@ -106,10 +382,45 @@ public: // public APIs
 	}
 
 private:
+	/**
+	 * Commits the broadphase and emits the overlaps that began and ended
+	 */
+	inline void CommitBroadphase();
+
+	/**
+	 * Runs the policy, if any, on the observations gathered during the phase
+	 */
+	inline void Infer();
+
 	/// Forest that holds registered objects grouped by their construction
 	/// dependency and sorted by their execution id (tick_group)
 	Forest forest = Forest();
 
+	/// Events emitted by the objects, delivered at the end of each phase
+	EventBus events{};
+
+	/// Positions registered by the objects, for neighbor queries
+	SpatialHash spatial_hash{};
+
+	/// Geometry registered by the objects, for ray casts
+	Raycaster raycaster{};
+
+	/// Bounds registered by the objects, for overlap events
+	Broadphase broadphase{};
+
+	/// Rigid bodies registered by the objects
+	PhysicsWorld2D physics{};
+
+	/// Observations and actions exchanged with the learner
+	SpaceBuffer observations{};
+	SpaceBuffer actions{};
+
+	/// Decides the actions from the observations between two frames
+	Policy policy{};
+
+	/// Static scenes hosted by this scene
+	std::vector<std::unique_ptr<StaticSceneBase>> static_scenes{};
+
 	/// Unique Game Manager for this instance of scene
 	Tickable game_manager = ConceptPlaceHolder();
 };
@@ -124,6 +435,18 @@ inline void Scene::BeginObjects()
 	Begin(game_manager);
 
 	forest.CallBegin();
+
+	for (auto& static_scene : static_scenes)
+		static_scene->BeginObjects();
+
+	forest.UpdateTransforms();
+
+	spatial_hash.Commit();
+	raycaster.Commit();
+	CommitBroadphase();
+	events.Flush();
+
+	Infer();
 }
 
 
@@ -131,10 +454,31 @@ inline void Scene::TickObjects()
 {
 	forest.CallTick();
 
+	for (auto& static_scene : static_scenes)
+		static_scene->TickObjects();
+
+	// Physics phase: the forces applied during Tick move the bodies, and the
+	// game manager sees the resulting state
+	physics.Step();
+
+	// World matrices follow the placements set during Tick
+	forest.UpdateTransforms();
+
 	// Since game manager holds the game logic, we should first let
 	// everyone else tick and only then tick the game manager which
 	// may then update all the wanted status such as reward, score, etc.
 	Tick(game_manager);
+
+	// Phase boundary: apply the moves of this frame to the spatial hash and
+	// hand the events emitted during Tick to the subscribers
+	spatial_hash.Commit();
+	raycaster.Commit();
+	CommitBroadphase();
+	events.Flush();
+
+	// Inference phase: observations are final once the events have been
+	// handled, and the actions are read by the next Tick
+	Infer();
 }
 
 
@@ -142,10 +486,34 @@ inline void Scene::EndObjects()
 {
 	forest.CallEnd();
 
+	for (auto& static_scene : static_scenes)
+		static_scene->EndObjects();
+
 	// Just like Tick, let others finish first, then do the final
 	// wrap up such storing info, reporting exit status, etc. in
 	// game manager
 	End(game_manager);
+
+	events.Flush();
+}
+
+
+inline void Scene::CommitBroadphase()
+{
+	broadphase.Commit();
+
+	for (uint64_t key : broadphase.Ended())
+		events.Emit(OverlapEnd{Broadphase::ToPair(key)});
+
+	for (uint64_t key : broadphase.Began())
+		events.Emit(OverlapBegin{Broadphase::ToPair(key)});
+}
+
+
+inline void Scene::Infer()
+{
+	if (policy)
+		policy(observations, actions);
 }
 
 } // namespace pixie
@@ -0,0 +1,192 @@
+#ifndef PIXIE_CORE_SCENE_STATIC_SCENE_H
+#define PIXIE_CORE_SCENE_STATIC_SCENE_H
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Concepts/Virtual/Begin.h"
+#include "Pixie/Concepts/Virtual/Tick.h"
+#include "Pixie/Concepts/Virtual/End.h"
+#include "Pixie/Concepts/ConceptRegistry.h"
+
+namespace pixie
+{
+
+/**
+ * Type erased interface of a StaticScene so that it can be hosted by a
+ * dynamic Scene. The hosting scene makes a single virtual call per static
+ * scene and per phase; everything underneath is statically dispatched.
+ */
+class StaticSceneBase
+{
+public:
+	/** Default virtual destructor */
+	virtual ~StaticSceneBase() = default;
+
+	/** Calls Begin of all the objects that implement it */
+	virtual void BeginObjects() = 0;
+
+	/** Calls Tick of all the objects that implement it */
+	virtual void TickObjects() = 0;
+
+	/** Calls End of all the objects that implement it */
+	virtual void EndObjects() = 0;
+
+	/**
+	 * Dispatches a user defined concept to all the objects that implement it
+	 * @param [in] concept_index Index of the concept within SceneConcepts
+	 */
+	virtual void DispatchConcept(size_t concept_index) = 0;
+};
+
+
+/**
+ * Scene whose set of object types is fixed at compile time.
+ *
+ * Objects of each type are stored by value in their own vector and the
+ * Begin, Tick, and End phases are expanded at compile time over the types,
+ * using the same HasBegin, HasTick, and HasEnd detection traits as the rest
+ * of pixie. Types that do not implement a phase are skipped entirely and
+ * every call is a direct (and inlinable) member function call; no virtual
+ * dispatch or variant visit is involved. Types that implement TickBatch are
+ * ticked in a single call per frame.
+ *
+ * Usage:
+ * - Standalone: populate it and drive it yourself by calling BeginObjects,
+ *   TickObjects, and EndObjects.
+ * - Mixed: let the dynamic Scene own it (see Scene::CreateStaticScene) and
+ *   the engine will drive it along with the dynamic objects.
+ *
+ * @tparam Ts Types of the objects held by this scene. Each type is stored in
+ * a single contiguous vector, hence the types must be unique.
+ * @remark Objects are ticked type by type in the order of Ts, and in order
+ * of their addition within each type
+ */
+template<class... Ts>
+class StaticScene final : public StaticSceneBase
+{
+	static_assert(sizeof...(Ts) > 0, "StaticScene requires at least one object type");
+
+public:
+	/** Default constructor */
+	StaticScene() = default;
+
+	/**
+	 * Constructs an object of type T at the end of its vector
+	 * @tparam T (Required) Type of the object. Must be one of Ts
+	 * @param [in] args Arguments forwarded to the constructor of T
+	 * @return Index of the object within the objects of type T
+	 * @note Adding objects may reallocate the vector of type T. Refer to
+	 * them by their index rather than by pointer
+	 */
+	template<class T, class... Args>
+	size_t Add(Args&&... args)
+	{
+		auto& objects = GetAll<T>();
+		objects.emplace_back(std::forward<Args>(args)...);
+		return objects.size() - 1;
+	}
+
+	/**
+	 * Returns the object of type T at the given index
+	 * @tparam T (Required) Type of the object. Must be one of Ts
+	 */
+	template<class T>
+	T& Get(size_t index) { return GetAll<T>()[index]; }
+
+	/**
+	 * Returns all the objects of type T
+	 * @tparam T (Required) Type of the objects. Must be one of Ts
+	 */
+	template<class T>
+	std::vector<T>& GetAll() { return std::get<std::vector<T>>(objects); }
+
+	template<class T>
+	const std::vector<T>& GetAll() const { return std::get<std::vector<T>>(objects); }
+
+	/**
+	 * Returns the total number of objects of all types
+	 */
+	size_t Size() const
+	{
+		return (GetAll<Ts>().size() + ...);
+	}
+
+	void BeginObjects() override
+	{
+		(BeginAll<Ts>(), ...);
+	}
+
+	void TickObjects() override
+	{
+		(TickAll<Ts>(), ...);
+	}
+
+	void EndObjects() override
+	{
+		(EndAll<Ts>(), ...);
+	}
+
+	/**
+	 * Dispatches the user defined concept C to all the objects that
+	 * implement it, in a single batch per type (see pixie::DispatchBatch)
+	 * @tparam C (Required) Concept trait
+	 */
+	template<class C>
+	void Dispatch()
+	{
+		(DispatchAll<C, Ts>(), ...);
+	}
+
+	void DispatchConcept(size_t concept_index) override
+	{
+		DispatchConceptIn(concept_index, SceneConceptsOf<StaticScene>());
+	}
+
+private:
+	template<class T>
+	void BeginAll()
+	{
+		if constexpr (HasBegin<T>)
+			for (auto& object : GetAll<T>())
+				object.Begin();
+	}
+
+	template<class T>
+	void TickAll()
+	{
+		if constexpr (IsTickable<T>)
+			pixie::TickBatch(Span<T>(GetAll<T>()));
+	}
+
+	template<class C, class T>
+	void DispatchAll()
+	{
+		if constexpr (Implements<T, C>)
+			pixie::DispatchBatch<C>(Span<T>(GetAll<T>()));
+	}
+
+	template<class... Cs>
+	void DispatchConceptIn([[maybe_unused]] size_t concept_index, ConceptList<Cs...>)
+	{
+		[[maybe_unused]] size_t index = 0;
+		((index++ == concept_index ? Dispatch<Cs>() : void()), ...);
+	}
+
+	template<class T>
+	void EndAll()
+	{
+		if constexpr (HasEnd<T>)
+			for (auto& object : GetAll<T>())
+				object.End();
+	}
+
+	/// One vector per object type
+	std::tuple<std::vector<Ts>...> objects{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_SCENE_STATIC_SCENE_H
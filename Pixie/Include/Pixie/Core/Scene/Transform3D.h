@@ -0,0 +1,100 @@
+#ifndef PIXIE_CORE_SCENE_TRANSFORM_3D_H
+#define PIXIE_CORE_SCENE_TRANSFORM_3D_H
+
+#include "Pixie/Math/Matrix.h"
+#include "Pixie/Math/Quat.h"
+#include "Pixie/Math/Vector.h"
+
+namespace pixie
+{
+
+/**
+ * Placement of an object relative to the transform of its outer object,
+ * with its world matrix kept up to date by the scene.
+ *
+ * An object owns a transform by creating it as a component. The parent of
+ * that transform is the one owned by the closest outer object that owns
+ * one, as recorded by the construction tree:
+ * @code
+ * struct Arm
+ * {
+ *     Arm() { transform = ObjectInitializer::ConstructComponent<Transform3D>(); }
+ *     Handle<Transform3D> transform;
+ * };
+ *
+ * struct Robot
+ * {
+ *     Robot()
+ *     {
+ *         transform = ObjectInitializer::ConstructComponent<Transform3D>();
+ *         arm = ObjectInitializer::ConstructComponent<Arm>();   // arm->transform follows transform
+ *     }
+ *     Handle<Transform3D> transform;
+ *     Handle<Arm> arm;
+ * };
+ * @endcode
+ *
+ * Setting the local placement marks the transform dirty. The world matrices
+ * of the dirty transforms and of everything below them are recomputed in a
+ * single pre-order pass over each tree: once the entity is constructed, at
+ * the end of Begin, and after the Tick of the objects and the physics step.
+ */
+class Transform3D
+{
+	friend struct Tree;
+
+public:
+	/** Sets the position relative to the parent */
+	void SetPosition(const Vec3& value) { position = value; is_dirty = true; }
+
+	/** Sets the rotation relative to the parent */
+	void SetRotation(const Quat& value) { rotation = value; is_dirty = true; }
+
+	/** Sets the scale along the local axes */
+	void SetScale(const Vec3& value) { scale = value; is_dirty = true; }
+
+	const Vec3& GetPosition() const { return position; }
+	const Quat& GetRotation() const { return rotation; }
+	const Vec3& GetScale() const { return scale; }
+
+	/** Returns the transform relative to the parent */
+	Mat4 GetLocal() const { return Mat4::Trs(position, rotation, scale); }
+
+	/**
+	 * Returns the transform relative to the world
+	 * @note As of the last update, see the class description
+	 */
+	const Mat4& GetWorld() const { return world; }
+
+	/** Returns the position in the world, as of the last update */
+	Vec3 GetWorldPosition() const { return world.GetTranslation(); }
+
+	/** Whether the local placement changed since the last update */
+	bool IsDirty() const { return is_dirty; }
+
+private:
+	/**
+	 * Recomputes the world matrix
+	 * @param [in] parent Transform of the parent, or nullptr for a root
+	 */
+	void UpdateWorld(const Transform3D* parent)
+	{
+		world = parent ? parent->world * GetLocal() : GetLocal();
+		is_dirty = false;
+	}
+
+	/// Placement relative to the parent
+	Vec3 position{};
+	Quat rotation{};
+	Vec3 scale{1.0f, 1.0f, 1.0f};
+
+	/// Placement relative to the world
+	Mat4 world{};
+
+	/// Whether the local placement changed since the last update
+	bool is_dirty = true;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_SCENE_TRANSFORM_3D_H
@@ -8,11 +8,17 @@
 #endif
 
 #include <deque>
+#include <memory>
 #include <vector>
 #include <algorithm>
 
 #include <Pixie/Concepts/PObject.h>
 #include "Pixie/Misc/PixieExports.h"
+#include "Pixie/Core/Storage/ComponentStorage.h"
+#include "Pixie/Core/Storage/MemoryStats.h"
+#include "Pixie/Core/Storage/ComponentTable.h"
+#include "Pixie/Core/Scene/Archetype.h"
+#include "Pixie/Core/Scene/Transform3D.h"
 
 namespace pixie
 {
@@ -63,28 +69,29 @@ public:
 	/**
 	 * Creates the root of the tree and stores the input object in its
 	 * respective concept container
-	 * @param [in] object Entity object contained in the pixie object
+	 * @param [in] entity Reference to the entity object held in the scene storage
 	 */
-	void AddRoot(PObject entity)
+	void AddRoot(ComponentRef entity)
 	{
-		AddNode(std::move(entity), nullptr);
+		this->entity = entity;
+		AddNode(entity, nullptr);
 	}
 
 	/**
 	 * Creates a node and attaches it to its parent node.
 	 * This method also stores the input concept object in its respective
 	 * concept container
-	 * @param [in] object A pixie object
+	 * @param [in] obj Either a reference to an object held in the scene
+	 * storage or a pointer to a PObject owned by its outer object
 	 * @param [in] parent Pointer to the parent node of the object
-	 * @param [in] Pointer
 	 * @return A reference to newly created node
 	 */
 #ifdef __APPLE_CLANG__
-	Node& AddNode(mpark::variant<PObject, PObject*> obj, Node* parent)
+	Node& AddNode(mpark::variant<ComponentRef, PObject*> obj, Node* parent)
 	{
 		using mpark::get_if;
 #else
-	Node& AddNode(std::variant<PObject, PObject*> obj, Node* parent)
+	Node& AddNode(std::variant<ComponentRef, PObject*> obj, Node* parent)
 	{
 		using std::get_if;
 #endif
@@ -92,11 +99,10 @@ public:
 
 		Node node;
 
-		if (PObject* pobject = get_if<PObject>(&obj)) // Constructing a type T component
+		if (ComponentRef* ref = get_if<ComponentRef>(&obj)) // Constructing a type T component
 		{
-			// Move and store its contained data into one of the available lists
-			// and let the pobject itself go out of scope
-			MovePObjectDataToList(move(*pobject), &node);
+			// Store the reference in the list of its concept
+			AddRefToList(*ref, &node);
 		}
 		else if (PObject** ptr = get_if<PObject*>(&obj)) // Constructing a pure PObject
 		{
@@ -124,42 +130,67 @@ public:
 	}
 
 	/**
-	 * Moves the data hold by the PObject to its appropriate container
-	 * @param pobject The PObject holding the data
-	 * @param node The tree node that the PObject's data will link to
+	 * Stores the reference to a scene object in its appropriate container
+	 * @param ref Reference to the object held in the scene storage
+	 * @param node The tree node that the reference will link to
 	 */
-	void MovePObjectDataToList(PObject pobject, Node* node)
+	void AddRefToList(ComponentRef ref, Node* node)
 	{
-#ifdef __APPLE_CLANG__
-		using mpark::get;
-		using mpark::holds_alternative;
-#else
-		using std::get;
-		using std::holds_alternative;
-#endif
-		using std::move;
+		memory.Add(ref.storage->ElementSize());
 
-		if (holds_alternative<Object>(pobject.data))
-		{
-			node->list_idx = 0;
-			node->element_idx = objects.size();
-			objects.emplace_back(move(get<Object>(pobject.data)));
-		}
-		else if (holds_alternative<Tickable>(pobject.data))
+		if (ref.storage->ImplementsTick())
 		{
 			node->list_idx = 1;
 			node->element_idx = tickables.size();
-			tickables.emplace_back(move(get<Tickable>(pobject.data)));
+			tickables.emplace_back(ref);
 		}
 		else
 		{
-			// TODO(Ahura): unsupported type
-			node->list_idx = -1;
-			node->element_idx = 0;
+			node->list_idx = 0;
+			node->element_idx = objects.size();
+			objects.emplace_back(ref);
 		}
 	}
 
-	// TODO(Ahura): Need to reverse all of the nodes' element_index
+	/**
+	 * Destroys the entity and all the components held by this tree and
+	 * clears the containers
+	 * @note The entity is destroyed first so that it can still access its
+	 * components in its destructor. PObjects are owned by their outer
+	 * objects and are destroyed along with them.
+	 */
+	void Release()
+	{
+		entity.Erase();
+
+		for (auto& ref : objects)
+			ref.Erase();
+
+		for (auto& ref : tickables)
+			ref.Erase();
+
+		objects.clear();
+		tickables.clear();
+		pobjects.clear();
+		begin_list.clear();
+		end_list.clear();
+		root = Node();
+		memory = MemoryCounter();
+		archetype = nullptr;
+		components->Clear();
+		transforms.clear();
+	}
+
+	/**
+	 * Points every node of the tree back to this tree and to its actual
+	 * parent node
+	 * @note Must be called whenever the tree or its nodes are moved in memory
+	 */
+	void RelinkNodes()
+	{
+		RelinkNode(&root, nullptr);
+	}
+
 	/**
 	 * Reverses the container at the end of the tree construction
 	 * So that we don't have to reverse iterate over them
@@ -169,70 +200,238 @@ public:
 		std::reverse(objects.begin(), objects.end());
 		std::reverse(tickables.begin(), tickables.end());
 		std::reverse(pobjects.begin(), pobjects.end());
+
+		ReverseElementIndices(&root);
 	}
 
 	/**
-	 * Calls the Begin method of the registered Objects
+	 * Builds the lists of objects that implement Begin and End, keeping
+	 * the order of the objects followed by the tickables
+	 * @note Whether a type implements Begin or End is known at compile time,
+	 * hence objects that don't implement them never make it to these lists
 	 */
-	void CallBegin()
+	void BuildPhaseLists()
 	{
-		// Since pixie allows it and also it doesn't cost much,
-		// call Begin for non-tickable objects in hope some of
-		// them have implemented it
-		for (auto& obj : pobjects)
-			Begin(*obj);
+		begin_list.clear();
+		end_list.clear();
+
+		for (auto* list : {&objects, &tickables})
+		{
+			for (auto& ref : *list)
+			{
+				if (ref.storage->ImplementsBegin())
+					begin_list.push_back(ref);
+
+				if (ref.storage->ImplementsEnd())
+					end_list.push_back(ref);
+			}
+		}
+	}
 
-		for (auto& obj : objects)
-			Begin(obj);
+	/**
+	 * Fills the component table of the tree and links every object of the
+	 * tree to it, so that any of them can look up its siblings by type
+	 */
+	void BuildComponentTable()
+	{
+		components->Clear();
+		components->SetEntity(entity);
 
-		for (auto& tick_obj : tickables)
-			Begin(tick_obj);
+		for (auto* list : {&objects, &tickables})
+		{
+			for (auto& ref : *list)
+			{
+				components->Insert(ref.storage->GetTypeId(), ref);
+				ref.storage->SetComponentTable(ref.index, components.get());
+			}
+		}
 	}
 
 	/**
-	 * Calls the Tick method of the registered Objects
+	 * Lists the transforms of the tree in pre-order, along with their
+	 * parent transform (see Transform3D)
 	 */
-	inline void CallTick()
+	void BuildTransformHierarchy()
 	{
+		transforms.clear();
+		LinkTransforms(&root, -1);
+	}
+
+	/**
+	 * Recomputes the world matrix of the dirty transforms and of all the
+	 * transforms below them. Parents come first in the list, hence a single
+	 * pass is enough
+	 */
+	void UpdateTransforms()
+	{
+		for (size_t i = 0; i < transforms.size(); ++i)
+		{
+			auto& link = transforms[i];
+			link.transform = link.ref.As<Transform3D>().Get();
+
+			const TransformLink* parent = link.parent >= 0 ? &transforms[link.parent] : nullptr;
+
+			link.is_updated = link.transform->is_dirty or (parent and parent->is_updated);
+			if (link.is_updated)
+				link.transform->UpdateWorld(parent ? parent->transform : nullptr);
+		}
+	}
+
+	/**
+	 * Calls the Begin method of the registered Objects that implement it
+	 */
+	void CallBegin()
+	{
+		// Since pixie allows it and also it doesn't cost much,
+		// call Begin for PObjects in hope some of them have
+		// implemented it
 		for (auto& obj : pobjects)
-			Tick(*obj);
+			Begin(*obj);
 
-		for (auto& tick_obj : tickables)
-			Tick(tick_obj);
+		for (auto& ref : begin_list)
+			ref.Begin();
 	}
 
 	/**
-	 * Calls the End method of the registered Objects
+	 * Calls the End method of the registered Objects that implement it
 	 */
 	void CallEnd()
 	{
 		// Since pixie allows it and also it doesn't cost much,
-		// call End for non-tickable objects in hope some of
-		// them have implemented it
+		// call End for PObjects in hope some of them have
+		// implemented it
 		for (auto& obj : pobjects)
 			End(*obj);
 
-		for (auto& obj : objects)
-			End(obj);
+		for (auto& ref : end_list)
+			ref.End();
+	}
 
-		for (auto& tick_obj : tickables)
-			End(tick_obj);
+private:
+	/** Whether the object of a node is a Transform3D */
+	bool IsTransform(const Node& node) const
+	{
+		return node.list_idx == 0 and objects[node.element_idx].storage->GetTypeId() == type_id<Transform3D>;
 	}
 
+	/**
+	 * Recursively lists the transforms under the input node
+	 * @param [in] node Node to visit
+	 * @param [in] parent Index of the transform of the closest outer object, or -1
+	 */
+	void LinkTransforms(const Node* node, int parent)
+	{
+		if (IsTransform(*node))
+		{
+			transforms.push_back({objects[node->element_idx], parent});
+			return;
+		}
+
+		// The first transform created by this object is its own, and the
+		// parent of the transforms of its components
+		int owned = parent;
+		const Node* owned_node = nullptr;
+		for (auto& child : node->children)
+		{
+			if (IsTransform(child))
+			{
+				owned = static_cast<int>(transforms.size());
+				owned_node = &child;
+				transforms.push_back({objects[child.element_idx], parent});
+				break;
+			}
+		}
+
+		for (auto& child : node->children)
+			if (&child != owned_node)
+				LinkTransforms(&child, IsTransform(child) ? parent : owned);
+	}
+
+	/**
+	 * Recursively points the element index of the input node and its
+	 * children to the reversed position of their object
+	 */
+	void ReverseElementIndices(Node* node)
+	{
+		size_t size = 0;
+		switch (node->list_idx)
+		{
+			case 0: size = objects.size(); 	 break;
+			case 1: size = tickables.size(); break;
+			case 3: size = pobjects.size();  break;
+			default: break;
+		}
+
+		if (size > 0)
+			node->element_idx = size - 1 - node->element_idx;
+
+		for (auto& child : node->children)
+			ReverseElementIndices(&child);
+	}
+
+	/**
+	 * Recursively relinks the input node and its children
+	 */
+	void RelinkNode(Node* node, Node* parent)
+	{
+		node->host_tree = this;
+		node->parent = parent;
+
+		for (auto& child : node->children)
+			RelinkNode(&child, node);
+	}
+
+public:
 	/// Assigned tick group of this tree
 	int tick_group = 0;
 
 	/// Root of the tree
 	Node root{};
 
+	/// Reference to the entity object at the root of the tree
+	ComponentRef entity{};
+
 	/// Registered objects that don't comply with any of the concepts
-	std::vector<Object> objects{};
+	std::vector<ComponentRef> objects{};
 
 	/// Registered objects that implement Tick concept
-	std::vector<Tickable> tickables{};
+	std::vector<ComponentRef> tickables{};
 
 	/// Pointer to registered PObjects owned by and held in its outer class
+	/// @note PObjects are not ticked per tree but in batches of their type
+	/// (see Forest::CallTick)
 	std::vector<PObject*> pobjects{};
+
+	/// Registered objects and tickables that implement Begin
+	std::vector<ComponentRef> begin_list{};
+
+	/// Registered objects and tickables that implement End
+	std::vector<ComponentRef> end_list{};
+
+	/// Type indexed table of the entity and its components
+	/// @note Heap allocated so that the objects can link to it while the tree moves
+	std::unique_ptr<ComponentTable> components = std::make_unique<ComponentTable>();
+
+	/// Archetype table that holds the row of this tree
+	ArchetypeTable* archetype = nullptr;
+
+	/// A transform of the tree and the index of its parent transform
+	struct TransformLink
+	{
+		ComponentRef ref{};
+		int parent = -1;
+
+		/// Resolved and whether its world matrix changed, during an update
+		Transform3D* transform = nullptr;
+		bool is_updated = false;
+	};
+
+	/// Transforms of the tree in pre-order, parents first
+	std::vector<TransformLink> transforms{};
+
+	/// Live instances held in the scene storage by this tree
+	/// @note PObjects are part of their outer object and are not counted separately
+	MemoryCounter memory{};
 };
 
 } // namespace pixie
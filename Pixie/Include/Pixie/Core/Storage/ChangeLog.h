@@ -0,0 +1,151 @@
+#ifndef PIXIE_CORE_STORAGE_CHANGE_LOG_H
+#define PIXIE_CORE_STORAGE_CHANGE_LOG_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Pixie/Utility/TypeTraits.h"
+
+namespace pixie
+{
+
+/**
+ * Change tracking policy of the types whose changes are recorded by the
+ * scene, so that readers can visit only the objects that changed since a
+ * given frame (see Scene::ChangedSince).
+ * Select it by declaring the following alias within the type:
+ * using change_tracking = pixie::TrackChanges;
+ */
+struct TrackChanges {};
+
+/** Utility type trait that reads the change tracking policy declared by class T */
+template<class T>
+using CheckChangeTracking = typename T::change_tracking;
+
+/**
+ * Template utility type traits boolean that is true if the changes of class T are recorded
+ * @tparam T Type of the class to check
+ */
+template<class T>
+constexpr bool IsTracked = std::is_same_v<typename pixie::type_traits::detected_or<void, CheckChangeTracking, T>::type, TrackChanges>;
+
+
+/**
+ * Frame-stamped record of the changes of the objects of a single storage.
+ *
+ * Each slot keeps the frame of its last change, and every change is appended
+ * to a log ordered by frame. Reading the changes since a frame is a binary
+ * search followed by a walk over the newer entries only, so a reader does
+ * work proportional to the number of changes rather than to the number of
+ * objects.
+ *
+ * @note An object that changes several times shows up once, at its last change
+ */
+class ChangeLog
+{
+public:
+	/**
+	 * Records a change of the object held in slot 'index'
+	 * @param [in] index Index of the slot
+	 * @param [in] generation Generation of the slot
+	 * @param [in] frame Current frame. Must never decrease between calls
+	 */
+	void Record(uint32_t index, uint32_t generation, uint64_t frame)
+	{
+		if (index >= stamps.size())
+			stamps.resize(index + 1);
+
+		Stamp& stamp = stamps[index];
+		if (stamp.frame == frame and stamp.generation == generation)
+			return;
+
+		stamp = {frame, generation};
+		entries.push_back({frame, index, generation});
+
+		// Superseded entries are dropped once they outnumber the slots
+		if (entries.size() > 2 * stamps.size() + 64)
+			Trim();
+	}
+
+	/**
+	 * Returns the frame of the last change of the object held in slot
+	 * 'index', or 0 if it never changed
+	 */
+	uint64_t LastChange(uint32_t index, uint32_t generation) const
+	{
+		if (index >= stamps.size() or stamps[index].generation != generation)
+			return 0;
+
+		return stamps[index].frame;
+	}
+
+	/**
+	 * Calls the input function on each slot that changed after the given
+	 * frame, in the order of their last change
+	 * @param [in] since Frame of the last read. Changes made on that very
+	 * frame are not visited
+	 * @param [in] function Function that takes (uint32_t index, uint32_t generation)
+	 * @note The slots may no longer be live, the caller must check them
+	 */
+	template<class Function>
+	void ForEachSince(uint64_t since, Function&& function) const
+	{
+		auto first = std::upper_bound(entries.begin(), entries.end(), since,
+									  [](uint64_t frame, const Entry& entry) { return frame < entry.frame; });
+
+		for (auto it = first; it != entries.end(); ++it)
+			if (IsLatest(*it))
+				function(it->index, it->generation);
+	}
+
+	/** Returns the number of entries in the log, superseded ones included */
+	size_t Size() const { return entries.size(); }
+
+private:
+	struct Stamp
+	{
+		/// Frame of the last change, 0 if the slot never changed
+		uint64_t frame = 0;
+
+		/// Generation of the slot at the time of the last change
+		uint32_t generation = 0;
+	};
+
+	struct Entry
+	{
+		/// Frame of the change
+		uint64_t frame;
+
+		/// Index of the slot
+		uint32_t index;
+
+		/// Generation of the slot at the time of the change
+		uint32_t generation;
+	};
+
+	/** Whether the entry is the last change of its slot */
+	bool IsLatest(const Entry& entry) const
+	{
+		const Stamp& stamp = stamps[entry.index];
+		return stamp.frame == entry.frame and stamp.generation == entry.generation;
+	}
+
+	/** Removes the superseded entries, keeping the order of the others */
+	void Trim()
+	{
+		entries.erase(std::remove_if(entries.begin(), entries.end(),
+									 [this](const Entry& entry) { return not IsLatest(entry); }),
+					  entries.end());
+	}
+
+	/// slot index -> last change
+	std::vector<Stamp> stamps{};
+
+	/// Changes, in non-decreasing frame order
+	std::vector<Entry> entries{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_CHANGE_LOG_H
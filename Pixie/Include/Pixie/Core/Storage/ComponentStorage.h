@@ -0,0 +1,748 @@
+#ifndef PIXIE_CORE_STORAGE_COMPONENT_STORAGE_H
+#define PIXIE_CORE_STORAGE_COMPONENT_STORAGE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Misc/PixieExports.h"
+#include "Pixie/Concepts/Virtual/Begin.h"
+#include "Pixie/Concepts/Virtual/Tick.h"
+#include "Pixie/Concepts/Virtual/End.h"
+#include "Pixie/Concepts/ConceptRegistry.h"
+#include "Pixie/Core/Storage/ChangeLog.h"
+#include "Pixie/Core/Storage/Handle.h"
+#include "Pixie/Core/Storage/MemoryStats.h"
+#include "Pixie/Utility/TypeTraits.h"
+#include "Pixie/Utility/TypeId.h"
+
+namespace pixie
+{
+
+class ComponentTable;
+
+/**
+ * Record of an object that was moved to a new address by the storage
+ * @note Addresses are stored as integers since the old memory is already
+ * released by the time the records are consumed
+ */
+struct Relocation
+{
+	/// First byte of the object at its old address
+	uintptr_t old_begin = 0;
+
+	/// One past the last byte of the object at its old address
+	uintptr_t old_end = 0;
+
+	/// First byte of the object at its new address
+	uintptr_t new_begin = 0;
+};
+
+/**
+ * Type erased base of the per-type component storage.
+ *
+ * Holds the slot bookkeeping that is independent of the stored type:
+ * - slots: handle index -> position of the object in the storage along with
+ *   the slot generation
+ * - owners: position -> handle index (or npos if that position is a hole)
+ *
+ * The two-way indirection lets handles stay valid while the objects
+ * themselves are relocated within the storage.
+ */
+class ComponentStorageBase
+{
+public:
+	/// Marks an unused slot or position
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/// Dispatches a user defined concept to all the live objects of a storage
+	using ConceptDispatcher = void (*)(ComponentStorageBase&);
+
+	/**
+	 * (Constructor)
+	 * @param [in] is_tickable Whether the stored type implements the Tick concept
+	 * @param [in] has_begin Whether the stored type implements Begin
+	 * @param [in] has_end Whether the stored type implements End
+	 * @param [in] element_size Size of the stored type in bytes
+	 * @param [in] type_name Name of the stored type
+	 * @param [in] type_id Compile-time identifier of the stored type
+	 */
+	ComponentStorageBase(bool is_tickable, bool has_begin, bool has_end,
+						 size_t element_size, std::string_view type_name, TypeId type_id)
+			: is_tickable(is_tickable), has_begin(has_begin), has_end(has_end),
+			  element_size(element_size), type_name(type_name), type_id(type_id)
+	{}
+
+	/** Default virtual destructor */
+	virtual ~ComponentStorageBase() = default;
+
+	// Storages are referred to by handles, hence they must never move
+	ComponentStorageBase(const ComponentStorageBase&) = delete;
+	ComponentStorageBase& operator=(const ComponentStorageBase&) = delete;
+
+	/** Calls Begin on the object held in slot 'index' (if implemented) */
+	virtual void Begin(uint32_t index) = 0;
+
+	/** Calls Tick on the object held in slot 'index' */
+	virtual void Tick(uint32_t index) = 0;
+
+	/** Calls End on the object held in slot 'index' (if implemented) */
+	virtual void End(uint32_t index) = 0;
+
+	/**
+	 * Returns the address of the object held in slot 'index'
+	 * @warning The slot must be live
+	 */
+	virtual void* AddressOf(uint32_t index) = 0;
+
+	/**
+	 * Ticks all the live objects of this storage in memory order, one
+	 * contiguous run of objects at a time (see pixie::TickBatch)
+	 */
+	virtual void TickAll() = 0;
+
+	/**
+	 * Destroys the object held in slot 'index' if the slot is still of the
+	 * given generation
+	 * @return True if an object was destroyed; otherwise false
+	 */
+	virtual bool Erase(uint32_t index, uint32_t generation) = 0;
+
+	/**
+	 * Moves all the live objects to the front of the storage so that they
+	 * are contiguous and laid out in the given order. Holes are removed and
+	 * unused memory is released. Handles remain valid.
+	 * @param [in] order Slot indices in the desired memory order. Live slots
+	 * missing from this list are placed after them in their current order
+	 * @param [out] relocations Appended with a record of every moved object
+	 * @note Does nothing if the stored type is not move constructible
+	 */
+	virtual void Relocate(const std::vector<uint32_t>& order, std::vector<Relocation>& relocations) = 0;
+
+	/**
+	 * Checks whether the slot 'index' still holds an object of the given generation
+	 */
+	bool Contains(uint32_t index, uint32_t generation) const
+	{
+		return index < slots.size()
+			   and slots[index].generation == generation
+			   and slots[index].position != npos;
+	}
+
+	/** Returns whether the stored type implements the Tick (or TickBatch) concept */
+	bool ImplementsTick() const { return is_tickable; }
+
+	/**
+	 * Returns the function that dispatches the user defined concept at the
+	 * given index of SceneConcepts to all the live objects of a storage
+	 * @return The dispatcher, or a nullptr if the stored type doesn't
+	 * implement the concept
+	 */
+	ConceptDispatcher GetConceptDispatcher(size_t concept_index) const
+	{
+		return concept_index < concept_dispatchers.size() ? concept_dispatchers[concept_index] : nullptr;
+	}
+
+	/** Returns the number of user defined concepts known to this storage */
+	size_t ConceptCount() const { return concept_dispatchers.size(); }
+
+	/** Returns whether the stored type implements Begin */
+	bool ImplementsBegin() const { return has_begin; }
+
+	/** Returns whether the stored type implements End */
+	bool ImplementsEnd() const { return has_end; }
+
+	/** Returns the number of live objects in this storage */
+	size_t Size() const { return live_count; }
+
+	/** Returns the number of positions, live or not, that are in use */
+	size_t Extent() const { return owners.size(); }
+
+	/** Returns the size of the stored type in bytes */
+	size_t ElementSize() const { return element_size; }
+
+	/** Returns the name of the stored type */
+	std::string_view TypeName() const { return type_name; }
+
+	/** Returns the compile-time identifier of the stored type */
+	TypeId GetTypeId() const { return type_id; }
+
+	/** Returns the identifier of this storage within its scene */
+	uint32_t GetStorageId() const { return storage_id; }
+
+	/** Sets the identifier of this storage within its scene */
+	void SetStorageId(uint32_t id) { storage_id = id; }
+
+	/**
+	 * Returns the component table of the entity that owns the object held
+	 * in slot 'index'
+	 * @return The table, or a nullptr if the object is not (yet) part of
+	 * an entity
+	 */
+	const ComponentTable* GetComponentTable(uint32_t index) const
+	{
+		return index < component_tables.size() ? component_tables[index] : nullptr;
+	}
+
+	/**
+	 * Links the object held in slot 'index' to the component table of its entity
+	 */
+	void SetComponentTable(uint32_t index, const ComponentTable* table)
+	{
+		if (index >= component_tables.size())
+			component_tables.resize(slots.size(), nullptr);
+
+		component_tables[index] = table;
+	}
+
+	/**
+	 * Returns the record of the changes of the stored objects
+	 * @return The record, or a nullptr if the stored type doesn't track its
+	 * changes (see TrackChanges)
+	 */
+	const ChangeLog* GetChangeLog() const { return changes.get(); }
+
+	/**
+	 * Records a change of the object held in slot 'index'
+	 * @param [in] frame Current frame of the scene
+	 * @return True if recorded; false if the object is not alive or its type
+	 * doesn't track its changes
+	 */
+	bool MarkChanged(uint32_t index, uint32_t generation, uint64_t frame)
+	{
+		if (not changes or not Contains(index, generation))
+			return false;
+
+		changes->Record(index, generation, frame);
+		return true;
+	}
+
+	/** Returns the live and reserved memory of this storage */
+	const MemoryAccount& GetMemoryAccount() const { return memory; }
+
+	/**
+	 * Forwards all the changes in the memory of this storage to the input
+	 * account (e.g. the scene's), starting with what is already accounted for
+	 */
+	void SetParentAccount(MemoryAccount* parent)
+	{
+		memory.parent = parent;
+		if (parent)
+		{
+			parent->live.instances += memory.live.instances;
+			parent->live.bytes += memory.live.bytes;
+			parent->Reserve(static_cast<std::ptrdiff_t>(memory.reserved_bytes));
+		}
+	}
+
+protected:
+	struct Slot
+	{
+		/// Position of the object within the storage, npos if the slot is free
+		uint32_t position = npos;
+
+		/// Bumped every time the object of this slot is destroyed
+		uint32_t generation = 0;
+	};
+
+	/**
+	 * Reserves a position for a new object. Holes left behind by destroyed
+	 * objects are reused first.
+	 * @return The reserved position
+	 * @note The position is not owned by any slot until BindSlot is called.
+	 * Until then, the position is treated as a hole by everyone else, which
+	 * allows the object to construct other objects of its own type
+	 */
+	uint32_t ReservePosition()
+	{
+		if (not free_positions.empty())
+		{
+			uint32_t position = free_positions.back();
+			free_positions.pop_back();
+			return position;
+		}
+
+		owners.push_back(npos);
+		return static_cast<uint32_t>(owners.size() - 1);
+	}
+
+	/**
+	 * Gives a reserved position back to the storage without binding it to a slot
+	 */
+	void ReleasePosition(uint32_t position)
+	{
+		free_positions.push_back(position);
+	}
+
+	/**
+	 * Binds a fully constructed object at 'position' to a (possibly recycled) slot
+	 * @return Index of the slot
+	 */
+	uint32_t BindSlot(uint32_t position)
+	{
+		uint32_t index;
+		if (not free_slots.empty())
+		{
+			index = free_slots.back();
+			free_slots.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32_t>(slots.size());
+			slots.emplace_back();
+		}
+
+		slots[index].position = position;
+		owners[position] = index;
+		++live_count;
+		memory.AddInstance(element_size);
+
+		return index;
+	}
+
+	/**
+	 * Unbinds slot 'index' from its position and invalidates all the handles
+	 * that were issued for it
+	 * @return The position the slot was bound to
+	 */
+	uint32_t UnbindSlot(uint32_t index)
+	{
+		uint32_t position = slots[index].position;
+
+		owners[position] = npos;
+		free_positions.push_back(position);
+
+		if (index < component_tables.size())
+			component_tables[index] = nullptr;
+
+		slots[index].position = npos;
+		++slots[index].generation;
+		free_slots.push_back(index);
+		--live_count;
+		memory.RemoveInstance(element_size);
+
+		return position;
+	}
+
+	/// handle index -> position and generation
+	std::vector<Slot> slots{};
+
+	/// position -> handle index, npos marks a hole
+	std::vector<uint32_t> owners{};
+
+	/// Slots that can be recycled
+	std::vector<uint32_t> free_slots{};
+
+	/// Positions (holes) that can be reused
+	std::vector<uint32_t> free_positions{};
+
+	/// Number of live objects
+	size_t live_count = 0;
+
+	/// Live and allocated memory of this storage
+	MemoryAccount memory{};
+
+	/// slot index -> component table of the entity that owns the object
+	std::vector<const ComponentTable*> component_tables{};
+
+	/// Identifier of this storage within its scene
+	uint32_t storage_id = 0;
+
+	/// Dispatcher of each user defined concept, null if not implemented
+	std::vector<ConceptDispatcher> concept_dispatchers{};
+
+	/// Changes of the stored objects, null if the stored type doesn't track them
+	std::unique_ptr<ChangeLog> changes{};
+
+	/// Whether the stored type implements the Tick concept
+	const bool is_tickable;
+
+	/// Whether the stored type implements Begin
+	const bool has_begin;
+
+	/// Whether the stored type implements End
+	const bool has_end;
+
+	/// Size of the stored type in bytes
+	const size_t element_size;
+
+	/// Name of the stored type
+	const std::string_view type_name;
+
+	/// Compile-time identifier of the stored type
+	const TypeId type_id;
+};
+
+
+/**
+ * Storage of all the scene objects of type T.
+ *
+ * Objects are constructed in place inside fixed-size chunks. Chunks are
+ * never reallocated, hence growing the storage does not move any of the
+ * existing objects. Destroyed objects leave a hole that is reused by the
+ * next object of the same type. Objects are only ever moved by an explicit
+ * call to Relocate.
+ *
+ * @tparam T Type of the stored objects
+ */
+template<class T>
+class ComponentStorage final : public ComponentStorageBase
+{
+public:
+	/// Number of objects held by a single chunk
+	static constexpr size_t chunk_capacity = std::max<size_t>(64, (16 * 1024) / sizeof(T));
+
+	/** Default constructor */
+	ComponentStorage()
+			: ComponentStorageBase(IsTickable<T>, HasBegin<T>, HasEnd<T>,
+								   sizeof(T), type_traits::experimental::type_name<T>(), pixie::type_id<T>)
+	{
+		RegisterConcepts(SceneConceptsOf<T>());
+
+		if constexpr (IsTracked<T>)
+			changes = std::make_unique<ChangeLog>();
+	}
+
+	/** Destroys all the live objects */
+	~ComponentStorage() override
+	{
+		for (size_t position = 0; position < owners.size(); ++position)
+			if (owners[position] != npos)
+				Address(position)->~T();
+
+		memory.Reserve(-static_cast<std::ptrdiff_t>(memory.reserved_bytes));
+	}
+
+	void Relocate(const std::vector<uint32_t>& order, std::vector<Relocation>& relocations) override
+	{
+		if constexpr (std::is_move_constructible_v<T>)
+		{
+			// Final sequence of slots: the requested order first, followed
+			// by any live slot that was left out of it
+			std::vector<uint32_t> sequence;
+			sequence.reserve(live_count);
+
+			std::vector<bool> is_placed(slots.size(), false);
+			auto place = [&](uint32_t index)
+			{
+				if (index < slots.size() and slots[index].position != npos and not is_placed[index])
+				{
+					is_placed[index] = true;
+					sequence.push_back(index);
+				}
+			};
+
+			for (uint32_t index : order)
+				place(index);
+
+			for (uint32_t index : owners)
+				if (index != npos)
+					place(index);
+
+			// Move every object into a freshly allocated set of chunks
+			std::vector<std::unique_ptr<Chunk>> new_chunks((sequence.size() + chunk_capacity - 1) / chunk_capacity);
+			for (auto& chunk : new_chunks)
+				chunk.reset(new Chunk);
+
+			std::vector<uint32_t> new_owners(sequence.size());
+
+			for (size_t position = 0; position < sequence.size(); ++position)
+			{
+				uint32_t index = sequence[position];
+
+				T* from = AddressIn(chunks, slots[index].position);
+				T* to = AddressIn(new_chunks, position);
+
+				::new (static_cast<void*>(to)) T(std::move(*from));
+				from->~T();
+
+				relocations.push_back({reinterpret_cast<uintptr_t>(from),
+									   reinterpret_cast<uintptr_t>(from) + sizeof(T),
+									   reinterpret_cast<uintptr_t>(to)});
+
+				slots[index].position = static_cast<uint32_t>(position);
+				new_owners[position] = index;
+			}
+
+			auto chunk_bytes = static_cast<std::ptrdiff_t>(sizeof(Chunk));
+			memory.Reserve(static_cast<std::ptrdiff_t>(new_chunks.size()) * chunk_bytes
+						   - static_cast<std::ptrdiff_t>(chunks.size()) * chunk_bytes);
+
+			chunks.swap(new_chunks);
+			owners.swap(new_owners);
+			free_positions.clear();
+		}
+	}
+
+	/**
+	 * Constructs a new object of type T in place
+	 * @param [in] args Arguments forwarded to the constructor of T
+	 * @return A handle to the newly constructed object
+	 */
+	template<class... Args>
+	Handle<T> Emplace(Args&&... args)
+	{
+		uint32_t position = ReservePosition();
+		EnsureCapacity(position);
+
+		try
+		{
+			::new (static_cast<void*>(Address(position))) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			ReleasePosition(position);
+			throw;
+		}
+
+		uint32_t index = BindSlot(position);
+		return Handle<T>(this, index, slots[index].generation);
+	}
+
+	/**
+	 * Destroys the object the handle refers to
+	 * @return True if the object was alive and is now destroyed; otherwise false
+	 */
+	bool Erase(Handle<T> handle)
+	{
+		return Erase(handle.index, handle.generation);
+	}
+
+	bool Erase(uint32_t index, uint32_t generation) override
+	{
+		if (not ComponentStorageBase::Contains(index, generation))
+			return false;
+
+		Address(slots[index].position)->~T();
+		UnbindSlot(index);
+		return true;
+	}
+
+	/**
+	 * Resolves the handle in O(1)
+	 * @return A pointer to the object or nullptr if the handle is stale
+	 */
+	T* Get(Handle<T> handle)
+	{
+		if (not Contains(handle))
+			return nullptr;
+
+		return Address(slots[handle.index].position);
+	}
+
+	/**
+	 * Issues a handle to the object held in slot 'index'
+	 * @param [in] index Index of the slot
+	 * @param [in] generation Generation of the slot the handle refers to
+	 */
+	Handle<T> MakeHandle(uint32_t index, uint32_t generation)
+	{
+		return Handle<T>(this, index, generation);
+	}
+
+	/** Checks whether the handle still refers to a live object */
+	bool Contains(Handle<T> handle) const
+	{
+		return ComponentStorageBase::Contains(handle.index, handle.generation);
+	}
+
+	void* AddressOf(uint32_t index) override
+	{
+		return Address(slots[index].position);
+	}
+
+	void Begin(uint32_t index) override
+	{
+		if constexpr (HasBegin<T>)
+			Address(slots[index].position)->Begin();
+	}
+
+	void Tick(uint32_t index) override
+	{
+		if constexpr (HasTick<T>)
+			Address(slots[index].position)->Tick();
+	}
+
+	void End(uint32_t index) override
+	{
+		if constexpr (HasEnd<T>)
+			Address(slots[index].position)->End();
+	}
+
+	void TickAll() override
+	{
+		if constexpr (IsTickable<T>)
+			ForEachRun([](Span<T> objects) { pixie::TickBatch(objects); });
+	}
+
+private:
+	/**
+	 * Calls the input function on each contiguous run of live objects, in
+	 * memory order. A run ends at a hole or at the end of its chunk.
+	 * @param [in] function Function that takes a Span<T>
+	 * @note Objects constructed during this pass at the end of the storage
+	 * are left out
+	 */
+	template<class Function>
+	void ForEachRun(Function&& function)
+	{
+		const size_t extent = owners.size();
+		size_t position = 0;
+
+		while (position < extent)
+		{
+			while (position < extent and owners[position] == npos)
+				++position;
+
+			const size_t first = position;
+			const size_t chunk_end = std::min(extent, (first / chunk_capacity + 1) * chunk_capacity);
+
+			while (position < chunk_end and owners[position] != npos)
+				++position;
+
+			if (position > first)
+				function(Span<T>(Address(first), position - first));
+		}
+	}
+
+	/**
+	 * Fills the dispatcher of each user defined concept
+	 */
+	template<class... Cs>
+	void RegisterConcepts(ConceptList<Cs...>)
+	{
+		concept_dispatchers = {GetDispatcher<Cs>()...};
+	}
+
+	/**
+	 * Returns the dispatcher of concept C, or a nullptr if T doesn't implement it
+	 */
+	template<class C>
+	static ConceptDispatcher GetDispatcher()
+	{
+		if constexpr (Implements<T, C>)
+			return &Dispatch<C>;
+		else
+			return nullptr;
+	}
+
+	/**
+	 * Dispatches concept C to all the live objects of the storage, one
+	 * contiguous run of objects at a time (see pixie::DispatchBatch)
+	 */
+	template<class C>
+	static void Dispatch(ComponentStorageBase& storage)
+	{
+		static_cast<ComponentStorage&>(storage).ForEachRun([](Span<T> objects) { pixie::DispatchBatch<C>(objects); });
+	}
+
+	/** Raw, uninitialized and properly aligned memory for chunk_capacity objects */
+	struct Chunk
+	{
+		alignas(T) unsigned char bytes[sizeof(T) * chunk_capacity];
+	};
+
+	/**
+	 * Returns the address of the object at the given position
+	 */
+	T* Address(size_t position) const
+	{
+		return AddressIn(chunks, position);
+	}
+
+	/**
+	 * Returns the address of the given position within the input chunks
+	 */
+	static T* AddressIn(const std::vector<std::unique_ptr<Chunk>>& in_chunks, size_t position)
+	{
+		auto* bytes = in_chunks[position / chunk_capacity]->bytes + sizeof(T) * (position % chunk_capacity);
+		return std::launder(reinterpret_cast<T*>(bytes));
+	}
+
+	/**
+	 * Allocates new chunks until the given position fits in the storage
+	 */
+	void EnsureCapacity(size_t position)
+	{
+		while (position >= chunks.size() * chunk_capacity)
+		{
+			chunks.emplace_back(new Chunk);
+			memory.Reserve(sizeof(Chunk));
+		}
+	}
+
+	/// Chunks of memory that hold the objects
+	std::vector<std::unique_ptr<Chunk>> chunks{};
+};
+
+
+/**
+ * Type erased handle used internally by the scene to refer to any object
+ * held in one of the component storages
+ */
+struct ComponentRef
+{
+	/** Default constructor. Constructs a null reference */
+	ComponentRef() = default;
+
+	/**
+	 * (Constructor) Type erases the input handle
+	 * @tparam T (Automatically deduced) Type of the object the handle refers to
+	 */
+	template<class T>
+	explicit ComponentRef(Handle<T> handle)
+			: storage(handle.GetStorage()), index(handle.GetIndex()), generation(handle.GetGeneration())
+	{}
+
+	/** Checks whether the referred object is still alive */
+	bool IsValid() const { return storage and storage->Contains(index, generation); }
+
+	/** Calls Begin on the referred object (if implemented) */
+	void Begin() const { storage->Begin(index); }
+
+	/** Calls Tick on the referred object */
+	void Tick() const { storage->Tick(index); }
+
+	/** Calls End on the referred object (if implemented) */
+	void End() const { storage->End(index); }
+
+	/** Destroys the referred object */
+	bool Erase() const { return storage and storage->Erase(index, generation); }
+
+	/**
+	 * Converts the reference back to a typed handle
+	 * @tparam T (Required) Type of the referred object
+	 * @warning T must be the type of the referred object
+	 */
+	template<class T>
+	Handle<T> As() const
+	{
+		return static_cast<ComponentStorage<T>*>(storage)->MakeHandle(index, generation);
+	}
+
+	bool operator==(const ComponentRef& other) const
+	{
+		return storage == other.storage and index == other.index and generation == other.generation;
+	}
+
+	bool operator!=(const ComponentRef& other) const { return not (*this == other); }
+
+	/// Storage that holds the referred object
+	ComponentStorageBase* storage = nullptr;
+
+	/// Index of the storage slot
+	uint32_t index = 0;
+
+	/// Generation of the slot at the time the reference was made
+	uint32_t generation = 0;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_COMPONENT_STORAGE_H
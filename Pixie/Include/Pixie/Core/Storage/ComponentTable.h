@@ -0,0 +1,130 @@
+#ifndef PIXIE_CORE_STORAGE_COMPONENT_TABLE_H
+#define PIXIE_CORE_STORAGE_COMPONENT_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Pixie/Core/Storage/ComponentStorage.h"
+#include "Pixie/Utility/TypeId.h"
+
+namespace pixie
+{
+
+/**
+ * Per-entity table that maps the type of each of its objects (the entity
+ * itself and its components) to a reference to that object.
+ *
+ * The table is a small open addressing hash table keyed by the compile-time
+ * TypeId of the objects. Since the identifiers are already hashes, a lookup
+ * is a mask and, most of the time, a single comparison.
+ *
+ * @note If an entity owns several objects of the same type, the table holds
+ * the first one that was inserted
+ */
+class ComponentTable
+{
+public:
+	/**
+	 * Inserts a reference to an object of the given type, unless the table
+	 * already holds an object of that type
+	 * @param [in] type_id Compile-time identifier of the type of the object
+	 * @param [in] ref Reference to the object
+	 * @return True if inserted; otherwise false
+	 */
+	bool Insert(TypeId type_id, ComponentRef ref)
+	{
+		if ((count + 1) * 2 > entries.size())
+			Grow();
+
+		size_t i = Probe(type_id);
+		if (entries[i].ref.storage != nullptr)
+			return false;
+
+		entries[i] = {type_id, ref};
+		++count;
+		return true;
+	}
+
+	/**
+	 * Looks up the object of the given type
+	 * @param [in] type_id Compile-time identifier of the type
+	 * @return A pointer to the reference to the object, or a nullptr if the
+	 * entity doesn't own an object of that type
+	 */
+	const ComponentRef* Find(TypeId type_id) const
+	{
+		if (entries.empty())
+			return nullptr;
+
+		const Entry& entry = entries[Probe(type_id)];
+		return entry.ref.storage != nullptr ? &entry.ref : nullptr;
+	}
+
+	/** Returns the number of types in the table */
+	size_t Size() const { return count; }
+
+	/** Returns the reference to the entity that owns the table */
+	ComponentRef GetEntity() const { return entity; }
+
+	/** Sets the entity that owns the table */
+	void SetEntity(ComponentRef owner) { entity = owner; }
+
+	/** Removes all the entries */
+	void Clear()
+	{
+		entries.clear();
+		count = 0;
+		entity = ComponentRef();
+	}
+
+private:
+	struct Entry
+	{
+		/// Type of the object
+		TypeId type_id = 0;
+
+		/// Reference to the object, null if the entry is empty
+		ComponentRef ref{};
+	};
+
+	/**
+	 * Returns the index of the entry of the given type, or of the empty
+	 * entry where it would be inserted
+	 */
+	size_t Probe(TypeId type_id) const
+	{
+		const size_t mask = entries.size() - 1;
+
+		size_t i = static_cast<size_t>(type_id) & mask;
+		while (entries[i].ref.storage != nullptr and entries[i].type_id != type_id)
+			i = (i + 1) & mask;
+
+		return i;
+	}
+
+	/**
+	 * Doubles the number of entries (a power of two) and re-inserts them
+	 */
+	void Grow()
+	{
+		std::vector<Entry> old_entries(entries.empty() ? 8 : entries.size() * 2);
+		old_entries.swap(entries);
+
+		for (auto& entry : old_entries)
+			if (entry.ref.storage != nullptr)
+				entries[Probe(entry.type_id)] = entry;
+	}
+
+	/// Power of two number of entries, at most half of them used
+	std::vector<Entry> entries;
+
+	/// Number of used entries
+	size_t count = 0;
+
+	/// Entity that owns the table
+	ComponentRef entity{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_COMPONENT_TABLE_H
@@ -0,0 +1,125 @@
+#ifndef PIXIE_CORE_STORAGE_HANDLE_H
+#define PIXIE_CORE_STORAGE_HANDLE_H
+
+#include <cstdint>
+#include <functional>
+
+#include "Pixie/Misc/PixieExports.h"
+
+namespace pixie
+{
+
+template<class T> class ComponentStorage;
+
+/**
+ * Generational handle to an object of type T that lives in the scene storage.
+ *
+ * A handle is made of an index, which points to a slot of the per-type
+ * storage, and the generation of that slot at the time the object was
+ * constructed. Every time an object is destroyed, the generation of its slot
+ * is bumped. Hence, a handle that outlives its object is detected in O(1)
+ * by comparing the two generations, even if the slot is reused by a newer
+ * object of the same type.
+ *
+ * Unlike a raw pointer, a handle does not pin the object to a memory
+ * address. The storage is free to relocate the object (e.g. see
+ * Scene::Compact) and the handle will still resolve to it.
+ *
+ * @tparam T Type of the object this handle refers to
+ * @note Handles are trivially copyable and cheap to pass around by value
+ * @warning Handles are only meaningful within the scene that created them
+ */
+template<class T>
+class Handle
+{
+	friend class ComponentStorage<T>;
+
+public:
+	/** Default constructor. Constructs a null handle */
+	Handle() = default;
+
+	/**
+	 * Resolves the handle to the object it refers to
+	 * @return A pointer to the object if it is still alive; otherwise a nullptr
+	 * @warning Do NOT delete this pointer, and do not hold on to it beyond the
+	 * current call as the object may be relocated by the scene
+	 */
+	PIXIE_EXPORT T* Get() const
+	{
+		return storage ? storage->Get(*this) : nullptr;
+	}
+
+	/**
+	 * Checks whether the object this handle refers to is still alive
+	 * @return True if the object is alive; otherwise false
+	 */
+	PIXIE_EXPORT bool IsValid() const
+	{
+		return storage and storage->Contains(*this);
+	}
+
+	/** Same as IsValid */
+	PIXIE_EXPORT explicit operator bool() const { return IsValid(); }
+
+	/**
+	 * Member access to the object this handle refers to
+	 * @warning Accessing a stale or null handle is undefined behavior. Check
+	 * IsValid first if you are not certain the object is still alive
+	 */
+	PIXIE_EXPORT T* operator->() const { return Get(); }
+
+	/** @see operator-> */
+	PIXIE_EXPORT T& operator*() const { return *Get(); }
+
+	/** Returns the index of the storage slot this handle points to */
+	uint32_t GetIndex() const { return index; }
+
+	/** Returns the generation of the slot this handle was issued for */
+	uint32_t GetGeneration() const { return generation; }
+
+	/** Returns the storage this handle resolves through */
+	ComponentStorage<T>* GetStorage() const { return storage; }
+
+	bool operator==(const Handle& other) const
+	{
+		return storage == other.storage and index == other.index and generation == other.generation;
+	}
+
+	bool operator!=(const Handle& other) const { return not (*this == other); }
+
+private:
+	/**
+	 * (Constructor) Only the storage is allowed to issue new handles
+	 * @param [in] storage Storage of type T that holds the object
+	 * @param [in] index Index of the slot that holds the object
+	 * @param [in] generation Current generation of the slot
+	 */
+	Handle(ComponentStorage<T>* storage, uint32_t index, uint32_t generation)
+			: storage(storage), index(index), generation(generation)
+	{}
+
+	/// Storage that holds the object this handle refers to
+	ComponentStorage<T>* storage = nullptr;
+
+	/// Index of the storage slot
+	uint32_t index = 0;
+
+	/// Generation of the slot at the time this handle was issued
+	uint32_t generation = 0;
+};
+
+} // namespace pixie
+
+namespace std
+{
+template<class T>
+struct hash<pixie::Handle<T>>
+{
+	size_t operator()(const pixie::Handle<T>& handle) const noexcept
+	{
+		return hash<uint64_t>()((uint64_t(handle.GetIndex()) << 32u) | handle.GetGeneration());
+	}
+};
+} // namespace std
+
+#endif //PIXIE_CORE_STORAGE_HANDLE_H
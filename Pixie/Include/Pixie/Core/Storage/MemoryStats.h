@@ -0,0 +1,140 @@
+#ifndef PIXIE_CORE_STORAGE_MEMORY_STATS_H
+#define PIXIE_CORE_STORAGE_MEMORY_STATS_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace pixie
+{
+
+/**
+ * Number of live instances and the bytes they occupy
+ * @note Counters are maintained incrementally as objects are created and
+ * destroyed, hence reading them never walks over the objects themselves
+ */
+struct MemoryCounter
+{
+	/**
+	 * Records the creation of an instance
+	 * @param [in] size Size of the instance in bytes
+	 */
+	void Add(size_t size)
+	{
+		++instances;
+		bytes += size;
+	}
+
+	/**
+	 * Records the destruction of an instance
+	 * @param [in] size Size of the instance in bytes
+	 */
+	void Remove(size_t size)
+	{
+		--instances;
+		bytes -= size;
+	}
+
+	/// Number of live instances
+	size_t instances = 0;
+
+	/// Bytes occupied by the live instances
+	size_t bytes = 0;
+};
+
+/**
+ * Live and reserved memory of a storage, optionally forwarded to the account
+ * of its owner (e.g. the scene) so that the totals are always up to date
+ */
+struct MemoryAccount
+{
+	/**
+	 * Records the creation of an instance of the given size
+	 */
+	void AddInstance(size_t size)
+	{
+		live.Add(size);
+		if (parent)
+			parent->AddInstance(size);
+	}
+
+	/**
+	 * Records the destruction of an instance of the given size
+	 */
+	void RemoveInstance(size_t size)
+	{
+		live.Remove(size);
+		if (parent)
+			parent->RemoveInstance(size);
+	}
+
+	/**
+	 * Records a change in the allocated memory
+	 * @param [in] bytes Number of bytes that were allocated (positive) or
+	 * released (negative)
+	 */
+	void Reserve(std::ptrdiff_t bytes)
+	{
+		reserved_bytes += bytes;
+		if (parent)
+			parent->Reserve(bytes);
+	}
+
+	/// Live instances
+	MemoryCounter live{};
+
+	/// Allocated bytes, live or not
+	size_t reserved_bytes = 0;
+
+	/// Account of the owner, if any
+	MemoryAccount* parent = nullptr;
+};
+
+/**
+ * Memory used by the objects of a single type
+ */
+struct TypeMemoryStats
+{
+	/// Name of the type
+	std::string_view type_name{};
+
+	/// Live instances of the type
+	MemoryCounter live{};
+
+	/// Bytes allocated by the storage of this type, live or not
+	size_t reserved_bytes = 0;
+};
+
+/**
+ * Memory used by an entity and all the components in its tree
+ */
+struct TreeMemoryStats
+{
+	/// Tick group of the tree
+	int tick_group = 0;
+
+	/// Live instances of the tree
+	MemoryCounter live{};
+};
+
+/**
+ * Snapshot of the memory used by a scene
+ */
+struct MemoryStats
+{
+	/// Per component type, sorted by their live bytes in descending order
+	std::vector<TypeMemoryStats> types{};
+
+	/// Per tree (i.e. entity), in tick group order
+	std::vector<TreeMemoryStats> trees{};
+
+	/// All the live instances of the scene
+	MemoryCounter scene{};
+
+	/// Bytes allocated by all the storages of the scene, live or not
+	size_t reserved_bytes = 0;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_MEMORY_STATS_H
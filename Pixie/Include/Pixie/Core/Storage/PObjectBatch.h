@@ -0,0 +1,195 @@
+#ifndef PIXIE_CORE_STORAGE_POBJECT_BATCH_H
+#define PIXIE_CORE_STORAGE_POBJECT_BATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Pixie/Concepts/Virtual/Tick.h"
+
+namespace pixie
+{
+
+/**
+ * Type erased interface of a PObjectBatch so that the batches of all the
+ * types can be ticked in one loop, with a single virtual call per type
+ */
+class PObjectBatchBase
+{
+public:
+	/** Default virtual destructor */
+	virtual ~PObjectBatchBase() = default;
+
+	/**
+	 * Ticks all the registered objects of this batch
+	 */
+	virtual void TickAll() = 0;
+
+	/**
+	 * Unregisters the object at the given index. The index is recycled by
+	 * the next registered object
+	 * @param [in] index Index returned when the object was registered
+	 */
+	void Erase(uint32_t index)
+	{
+		objects[index] = nullptr;
+		free_indices.push_back(index);
+		--live_count;
+	}
+
+	/** Returns the number of registered objects */
+	size_t Size() const { return live_count; }
+
+protected:
+	/**
+	 * Registers the object and returns its index within the batch
+	 */
+	uint32_t Insert(void* object)
+	{
+		++live_count;
+
+		if (not free_indices.empty())
+		{
+			uint32_t index = free_indices.back();
+			free_indices.pop_back();
+			objects[index] = object;
+			return index;
+		}
+
+		objects.push_back(object);
+		return static_cast<uint32_t>(objects.size() - 1);
+	}
+
+	/// Registered objects. Erased objects leave a nullptr behind
+	std::vector<void*> objects;
+
+	/// Indices of the erased objects
+	std::vector<uint32_t> free_indices;
+
+	/// Number of registered objects
+	size_t live_count = 0;
+};
+
+
+/**
+ * Tickable objects of type T that are owned by PObjects, i.e. that live
+ * inside of their outer object rather than in the scene storage.
+ *
+ * The objects are registered by their address once, when their PObject is
+ * constructed, and are ticked through a direct (and inlinable) call to
+ * T::Tick. Hence, ticking them involves neither a variant visit nor a
+ * virtual call per object.
+ *
+ * @tparam T Type of the registered objects. Must implement Tick or TickBatch
+ * @note The objects of a PObject are allocated on the heap and do not move
+ * when their outer object is relocated (see Scene::Compact)
+ */
+template<class T>
+class PObjectBatch final : public PObjectBatchBase
+{
+	static_assert(IsTickable<T>, "PObjectBatch requires an object that implements Tick or TickBatch");
+
+public:
+	/**
+	 * Registers an object to be ticked by this batch
+	 * @param [in] object The object to tick
+	 * @return Index of the object within the batch
+	 */
+	uint32_t Add(T* object)
+	{
+		return Insert(object);
+	}
+
+	void TickAll() override
+	{
+		for (void* ptr : objects)
+		{
+			if (ptr == nullptr)
+				continue;
+
+			// The objects are not contiguous; tick them as batches of one
+			auto* object = static_cast<T*>(ptr);
+			if constexpr (HasTick<T>)
+				object->Tick();
+			else
+				T::TickBatch(Span<T>(object, 1));
+		}
+	}
+};
+
+
+/**
+ * Reference to an object registered in a PObjectBatch
+ */
+struct PObjectBatchRef
+{
+	/** Unregisters the object from its batch, if registered */
+	void Erase()
+	{
+		if (batch)
+			batch->Erase(index);
+
+		batch = nullptr;
+	}
+
+	/** Checks whether the reference points to a registered object */
+	bool IsValid() const { return batch != nullptr; }
+
+	/// The batch the object is registered in
+	PObjectBatchBase* batch = nullptr;
+
+	/// Index of the object within its batch
+	uint32_t index = 0;
+};
+
+
+/**
+ * The PObjectBatch of every type, ticked in the order the first object of
+ * each type was registered
+ */
+class PObjectBatches
+{
+public:
+	/**
+	 * Registers an object in the batch of its type. Creates the batch if this
+	 * is the first object of its type
+	 * @tparam T (Automatically deduced) Type of the object
+	 * @param [in] object The object to tick
+	 * @return Reference to the registered object
+	 */
+	template<class T>
+	PObjectBatchRef Add(T* object)
+	{
+		auto& batch = batches[std::type_index(typeid(T))];
+		if (not batch)
+		{
+			batch = std::make_unique<PObjectBatch<T>>();
+			order.push_back(batch.get());
+		}
+
+		uint32_t index = static_cast<PObjectBatch<T>&>(*batch).Add(object);
+		return {batch.get(), index};
+	}
+
+	/**
+	 * Ticks the objects of all the batches
+	 */
+	void TickAll()
+	{
+		for (auto* batch : order)
+			batch->TickAll();
+	}
+
+private:
+	/// Batch of each type
+	std::unordered_map<std::type_index, std::unique_ptr<PObjectBatchBase>> batches;
+
+	/// Batches in the order they are ticked
+	std::vector<PObjectBatchBase*> order;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_POBJECT_BATCH_H
@@ -0,0 +1,268 @@
+#ifndef PIXIE_CORE_STORAGE_SPARSE_SET_H
+#define PIXIE_CORE_STORAGE_SPARSE_SET_H
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Concepts/Virtual/Tick.h"
+#include "Pixie/Core/Storage/MemoryStats.h"
+#include "Pixie/Utility/Span.h"
+#include "Pixie/Utility/TypeTraits.h"
+
+namespace pixie
+{
+
+/** Storage policy of the types that are stored in the per-type chunked storage (the default) */
+struct DenseStorage {};
+
+/**
+ * Storage policy of the types that are stored in a sparse set.
+ * Meant for components that only a few entities carry at a time (e.g. tags,
+ * status effects, buffs) and that come and go while the scene is running.
+ * Select it by declaring the following alias within the type:
+ * using storage_policy = pixie::SparseStorage;
+ */
+struct SparseStorage {};
+
+/** Utility type trait that reads the storage policy declared by class T */
+template<class T>
+using CheckStoragePolicy = typename T::storage_policy;
+
+/**
+ * Template utility type traits boolean that is true if class T is stored in a sparse set
+ * @tparam T Type of the class to check
+ */
+template<class T>
+constexpr bool IsSparse = std::is_same_v<typename pixie::type_traits::detected_or<DenseStorage, CheckStoragePolicy, T>::type, SparseStorage>;
+
+/**
+ * Identifies the entity a sparse component is attached to
+ */
+struct EntityKey
+{
+	/// Identifier of the storage of the entity type
+	uint32_t storage_id = 0;
+
+	/// Index of the storage slot of the entity
+	uint32_t index = 0;
+
+	bool operator==(const EntityKey& other) const
+	{
+		return storage_id == other.storage_id and index == other.index;
+	}
+};
+
+
+/**
+ * Type erased base of a sparse set
+ */
+class SparseSetBase
+{
+public:
+	/// Marks an entity that doesn't have a component in the set
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * (Constructor)
+	 * @param [in] element_size Size of the stored type in bytes
+	 * @param [in] type_name Name of the stored type
+	 */
+	SparseSetBase(size_t element_size, std::string_view type_name)
+			: element_size(element_size), type_name(type_name)
+	{}
+
+	/** Default virtual destructor */
+	virtual ~SparseSetBase() = default;
+
+	/**
+	 * Destroys the component of the given entity
+	 * @return True if the entity had one; otherwise false
+	 */
+	virtual bool Remove(EntityKey key) = 0;
+
+	/**
+	 * Ticks all the components in a single batch, if their type is tickable
+	 */
+	virtual void TickAll() = 0;
+
+	/** Checks whether the given entity has a component in this set */
+	bool Contains(EntityKey key) const { return DenseIndex(key) != npos; }
+
+	/** Returns the number of components */
+	size_t Size() const { return owners.size(); }
+
+	/** Returns the entity of each component, in the order of the components */
+	const std::vector<EntityKey>& GetOwners() const { return owners; }
+
+	/** Returns the name of the stored type */
+	std::string_view TypeName() const { return type_name; }
+
+	/** Returns the live and reserved memory of this set */
+	const MemoryAccount& GetMemoryAccount() const { return memory; }
+
+	/** Forwards all the changes in the memory of this set to the input account */
+	void SetParentAccount(MemoryAccount* parent) { memory.parent = parent; }
+
+protected:
+	/**
+	 * Returns the index of the component of the given entity in the dense
+	 * array, or npos if it has none
+	 */
+	uint32_t DenseIndex(EntityKey key) const
+	{
+		if (key.storage_id >= sparse.size() or key.index >= sparse[key.storage_id].size())
+			return npos;
+
+		return sparse[key.storage_id][key.index];
+	}
+
+	/**
+	 * Points the given entity to a dense index, growing the sparse index as needed
+	 */
+	void SetDenseIndex(EntityKey key, uint32_t dense_index)
+	{
+		if (key.storage_id >= sparse.size())
+			sparse.resize(key.storage_id + 1);
+
+		auto& page = sparse[key.storage_id];
+		if (key.index >= page.size())
+			page.resize(key.index + 1, npos);
+
+		page[key.index] = dense_index;
+	}
+
+	/// Per entity storage, entity slot index -> dense index
+	std::vector<std::vector<uint32_t>> sparse{};
+
+	/// Dense index -> entity
+	std::vector<EntityKey> owners{};
+
+	/// Live and allocated memory of this set
+	MemoryAccount memory{};
+
+	/// Size of the stored type in bytes
+	const size_t element_size;
+
+	/// Name of the stored type
+	const std::string_view type_name;
+};
+
+
+/**
+ * Sparse set of the components of type T.
+ *
+ * The components are packed in a dense array, in no particular order, and a
+ * sparse index maps each entity to its component. Adding, removing, and
+ * looking up the component of an entity are constant time, and iterating
+ * over all the components is a walk over a contiguous array.
+ *
+ * @tparam T Type of the stored components. Must be move assignable
+ * @warning Adding or removing components moves the others. Do not hold on
+ * to a pointer to a component beyond the next Add or Remove of its type
+ */
+template<class T>
+class SparseSet final : public SparseSetBase
+{
+public:
+	/** Default constructor */
+	SparseSet()
+			: SparseSetBase(sizeof(T), type_traits::experimental::type_name<T>())
+	{}
+
+	/** Releases the accounted memory */
+	~SparseSet() override
+	{
+		memory.Reserve(-static_cast<std::ptrdiff_t>(memory.reserved_bytes));
+	}
+
+	/**
+	 * Constructs the component of the given entity. Replaces the current one
+	 * if the entity already has a component of type T
+	 * @param [in] key The entity
+	 * @param [in] args Arguments forwarded to the constructor of T
+	 * @return A reference to the component
+	 */
+	template<class... Args>
+	T& Add(EntityKey key, Args&&... args)
+	{
+		uint32_t dense_index = DenseIndex(key);
+		if (dense_index != npos)
+		{
+			components[dense_index] = T(std::forward<Args>(args)...);
+			return components[dense_index];
+		}
+
+		components.emplace_back(std::forward<Args>(args)...);
+		owners.push_back(key);
+		SetDenseIndex(key, static_cast<uint32_t>(components.size() - 1));
+
+		memory.AddInstance(element_size);
+		UpdateReserved();
+
+		return components.back();
+	}
+
+	bool Remove(EntityKey key) override
+	{
+		uint32_t dense_index = DenseIndex(key);
+		if (dense_index == npos)
+			return false;
+
+		// Move the last component into the hole
+		if (dense_index + 1 != components.size())
+		{
+			components[dense_index] = std::move(components.back());
+			owners[dense_index] = owners.back();
+			SetDenseIndex(owners[dense_index], dense_index);
+		}
+
+		components.pop_back();
+		owners.pop_back();
+		SetDenseIndex(key, npos);
+
+		memory.RemoveInstance(element_size);
+
+		return true;
+	}
+
+	/**
+	 * Returns the component of the given entity, or a nullptr if it has none
+	 */
+	T* Find(EntityKey key)
+	{
+		uint32_t dense_index = DenseIndex(key);
+		return dense_index != npos ? &components[dense_index] : nullptr;
+	}
+
+	/**
+	 * Returns all the components, contiguous in memory
+	 * @note The entity of each component is at the same index in GetOwners
+	 */
+	Span<T> GetAll() { return Span<T>(components); }
+
+	void TickAll() override
+	{
+		if constexpr (IsTickable<T>)
+			pixie::TickBatch(Span<T>(components));
+	}
+
+private:
+	/**
+	 * Reports a change in the capacity of the dense array
+	 */
+	void UpdateReserved()
+	{
+		auto reserved = static_cast<std::ptrdiff_t>(components.capacity() * sizeof(T));
+		memory.Reserve(reserved - static_cast<std::ptrdiff_t>(memory.reserved_bytes));
+	}
+
+	/// Dense array of components
+	std::vector<T> components{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_CORE_STORAGE_SPARSE_SET_H
@@ -0,0 +1,147 @@
+#ifndef PIXIE_ENVIRONMENT_C_API_H
+#define PIXIE_ENVIRONMENT_C_API_H
+
+/*
+ * C interface to the environments registered with pixie::EnvironmentRegistry,
+ * meant to be driven through an FFI such as ctypes or cffi.
+ *
+ * An environment holds a batch of instances of a registered environment. Its
+ * observations and actions are fields of fixed shape, each laid out as a
+ * C-contiguous block of shape [batch size, field shape...]. Stepping copies
+ * the actions from buffers owned by the caller, runs one frame and copies
+ * the observations into buffers owned by the caller. Nothing is allocated
+ * per step; resetting rebuilds the instances.
+ *
+ * The core of Pixie is static, so only one environment exists at a time.
+ * Batch several instances into it instead.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Pixie/Misc/PixieExports.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Result of the functions of the C API */
+typedef enum pixie_status
+{
+	PIXIE_OK = 0,
+	PIXIE_ERROR_INVALID_ARGUMENT = 1,
+	PIXIE_ERROR_UNKNOWN_ENVIRONMENT = 2,
+	PIXIE_ERROR_BUSY = 3,
+	PIXIE_ERROR_INTERNAL = 4
+} pixie_status;
+
+/* Buffers of an environment */
+typedef enum pixie_buffer
+{
+	PIXIE_OBSERVATIONS = 0,
+	PIXIE_ACTIONS = 1
+} pixie_buffer;
+
+/* Kinds of spaces, see pixie::Space */
+typedef enum pixie_space_kind
+{
+	PIXIE_BOX = 0,
+	PIXIE_DISCRETE = 1,
+	PIXIE_MULTI_DISCRETE = 2
+} pixie_space_kind;
+
+#define PIXIE_MAX_DIMENSIONS 8
+
+/* Dense tensor laid out like a DLTensor, see pixie::TensorView */
+typedef struct pixie_tensor
+{
+	/* First element of the tensor */
+	void* data;
+
+	/* DLPack type: code (0 int, 1 uint, 2 float), bits and lanes */
+	uint8_t code;
+	uint8_t bits;
+	uint16_t lanes;
+
+	/* Number of dimensions, the first being the batch */
+	int32_t ndim;
+
+	/* Size of each dimension */
+	int64_t shape[PIXIE_MAX_DIMENSIONS];
+
+	/* Distance between two consecutive indices of each dimension, in elements */
+	int64_t strides[PIXIE_MAX_DIMENSIONS];
+} pixie_tensor;
+
+/* Description of a field of the observations or the actions */
+typedef struct pixie_field
+{
+	/* Name of the field, valid until the environment is reset or destroyed */
+	const char* name;
+
+	pixie_space_kind kind;
+
+	/* Bounds of a box */
+	float low;
+	float high;
+
+	/* Number of values of each element of a (multi) discrete space, and their
+	   count. Valid until the environment is reset or destroyed */
+	const int64_t* counts;
+	size_t count_size;
+
+	/* Size of the field for the whole batch, in bytes */
+	size_t byte_size;
+
+	/* Storage of the field inside the environment, written in place by
+	   the objects. Valid until the environment is reset or destroyed */
+	pixie_tensor tensor;
+} pixie_field;
+
+/* Opaque environment */
+typedef struct pixie_env pixie_env;
+
+/*
+ * Creates a batch of instances of a registered environment, ready to step
+ * name:       Name the environment was registered with
+ * batch_size: Number of instances
+ * out:        Receives the environment
+ */
+PIXIE_API pixie_status pixie_create(const char* name, size_t batch_size, pixie_env** out);
+
+/* Ends and destroys an environment. Accepts a null pointer */
+PIXIE_API void pixie_destroy(pixie_env* env);
+
+/*
+ * Rebuilds the instances of an environment and begins a new episode
+ * observations: One buffer per observation field, or a null array. A null
+ *               buffer skips its field
+ */
+PIXIE_API pixie_status pixie_reset(pixie_env* env, void* const* observations);
+
+/*
+ * Runs one frame of the environment
+ * actions:      One buffer per action field, or a null array. A null buffer
+ *               keeps the previous actions of its field
+ * observations: One buffer per observation field, or a null array. A null
+ *               buffer skips its field
+ */
+PIXIE_API pixie_status pixie_step(pixie_env* env, const void* const* actions, void* const* observations);
+
+/* Returns the number of instances of an environment */
+PIXIE_API size_t pixie_batch_size(const pixie_env* env);
+
+/* Returns the number of fields of the observations or the actions */
+PIXIE_API size_t pixie_field_count(const pixie_env* env, pixie_buffer buffer);
+
+/* Describes a field of the observations or the actions */
+PIXIE_API pixie_status pixie_get_field(const pixie_env* env, pixie_buffer buffer, size_t index, pixie_field* out);
+
+/* Returns the message of the last error on the calling thread */
+PIXIE_API const char* pixie_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PIXIE_ENVIRONMENT_C_API_H */
@@ -0,0 +1,56 @@
+#ifndef PIXIE_ENVIRONMENT_ENVIRONMENT_REGISTRY_H
+#define PIXIE_ENVIRONMENT_ENVIRONMENT_REGISTRY_H
+
+#include <functional>
+#include <string>
+
+#include "Pixie/Misc/PixieExports.h"
+
+namespace pixie
+{
+
+/**
+ * Static registry of the environments that can be created by name, e.g.
+ * through the C API from Python.
+ *
+ * An environment is registered with the function that populates a freshly
+ * initialized core with a batch of instances. The function declares the
+ * observation and action spaces, whose batch size is already set, and
+ * constructs the game manager and the objects:
+ * @code
+ * EnvironmentRegistry::Register("GridChase", [](size_t batch_size)
+ * {
+ *     ObjectInitializer::GetObservations()->Add("view", Space::Box({2, 7, 7}, 0.0f, 1.0f));
+ *     ObjectInitializer::GetObservations()->Add("reward", Space::Box({}));
+ *     ObjectInitializer::GetActions()->Add("move", Space::Discrete(5));
+ *
+ *     ObjectInitializer::ConstructGameManager<GridChase>();
+ *     for (size_t i = 0; i < batch_size; ++i)
+ *         ObjectInitializer::ConstructEntity<Chaser>();
+ * });
+ * @endcode
+ */
+class PIXIE_API EnvironmentRegistry
+{
+public:
+	/// Populates the core with a batch of environments
+	using Constructor = std::function<void(size_t batch_size)>;
+
+	/**
+	 * Registers an environment, replacing any environment of the same name
+	 * @param [in] name Name the environment is created by
+	 * @param [in] constructor Populates the core with a batch of environments
+	 */
+	static void Register(const std::string& name, Constructor constructor);
+
+	/**
+	 * Looks up an environment
+	 * @return The constructor of the environment, or a nullptr if no
+	 * environment has the given name
+	 */
+	static const Constructor* Find(const std::string& name);
+};
+
+} // namespace pixie
+
+#endif //PIXIE_ENVIRONMENT_ENVIRONMENT_REGISTRY_H
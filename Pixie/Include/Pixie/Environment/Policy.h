@@ -0,0 +1,39 @@
+#ifndef PIXIE_ENVIRONMENT_POLICY_H
+#define PIXIE_ENVIRONMENT_POLICY_H
+
+#include <functional>
+
+#include "Pixie/Environment/SpaceBuffer.h"
+
+namespace pixie
+{
+
+/**
+ * Decides the actions of every agent of the scene at once, e.g. a local
+ * ONNX session or a hand-written MLP.
+ *
+ * Instead of each agent running inference inside its own Tick, a frame is
+ * split in three stages:
+ * - gather: during Tick (or Begin), each agent stores its observation in its
+ *   slot of the scene observations
+ * - infer: once all the objects and the game manager are done, the policy
+ *   reads the whole batch of observations and writes the whole batch of
+ *   actions, e.g. as one matrix multiply per layer
+ * - scatter: on the next Tick, each agent reads its action from its slot of
+ *   the scene actions
+ *
+ * @code
+ * Core::SetPolicy([&](const SpaceBuffer& observations, SpaceBuffer& actions)
+ * {
+ *     network.Forward(observations.Get<float>(0), actions.Get<float>(0), observations.BatchSize());
+ * });
+ * @endcode
+ *
+ * @note Actions passed to pixie_step are copied in right before the frame,
+ * so they take precedence over the ones of the policy
+ */
+using Policy = std::function<void(const SpaceBuffer& observations, SpaceBuffer& actions)>;
+
+} // namespace pixie
+
+#endif //PIXIE_ENVIRONMENT_POLICY_H
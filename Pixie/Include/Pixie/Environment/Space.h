@@ -0,0 +1,195 @@
+#ifndef PIXIE_ENVIRONMENT_SPACE_H
+#define PIXIE_ENVIRONMENT_SPACE_H
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace pixie
+{
+
+/**
+ * Type of the elements of a tensor, with the type codes of DLPack so that
+ * it maps one to one to a DLDataType
+ */
+struct TensorType
+{
+	/// Code of the DLPack type: 0 for signed integers, 1 for unsigned, 2 for floats
+	uint8_t code = 2;
+
+	/// Number of bits per element
+	uint8_t bits = 32;
+
+	/// Number of lanes per element, always 1
+	uint16_t lanes = 1;
+
+	static constexpr TensorType Float32() { return {2, 32, 1}; }
+	static constexpr TensorType Int32() { return {0, 32, 1}; }
+
+	/** Returns the size of an element in bytes */
+	constexpr size_t ByteSize() const { return bits / 8u * lanes; }
+
+	constexpr bool operator==(const TensorType& other) const { return code == other.code and bits == other.bits and lanes == other.lanes; }
+	constexpr bool operator!=(const TensorType& other) const { return not (*this == other); }
+};
+
+
+/**
+ * Declarative description of the values of an observation or an action,
+ * after the spaces of Gym:
+ * - Box: an array of floats in [low, high]
+ * - Discrete: one integer in [0, n)
+ * - MultiDiscrete: an array of integers, each in [0, nvec[i])
+ *
+ * @code
+ * Space::Box({7, 7, 3}, 0.0f, 1.0f);    // egocentric grid view
+ * Space::Discrete(4);                   // move up, down, left or right
+ * Space::MultiDiscrete({3, 2});         // turn left/none/right, fire or not
+ * @endcode
+ */
+class Space
+{
+public:
+	enum class Kind : uint8_t
+	{
+		Box,
+		Discrete,
+		MultiDiscrete
+	};
+
+	/**
+	 * Returns a space of floats
+	 * @param [in] shape Dimensions of the array
+	 * @param [in] low, high Bounds of every value
+	 */
+	static Space Box(std::vector<int64_t> shape, float low = -std::numeric_limits<float>::infinity(),
+					 float high = std::numeric_limits<float>::infinity())
+	{
+		Space space(Kind::Box, std::move(shape));
+		space.low = low;
+		space.high = high;
+		return space;
+	}
+
+	/** Returns a space of one integer in [0, n) */
+	static Space Discrete(int64_t n)
+	{
+		if (n <= 0)
+			throw std::invalid_argument("A discrete space needs at least one value");
+
+		Space space(Kind::Discrete, {});
+		space.counts = {n};
+		return space;
+	}
+
+	/** Returns a space of integers, the i-th in [0, nvec[i]) */
+	static Space MultiDiscrete(std::vector<int64_t> nvec)
+	{
+		for (int64_t n : nvec)
+			if (n <= 0)
+				throw std::invalid_argument("Each value of a multi-discrete space needs at least one value");
+
+		Space space(Kind::MultiDiscrete, {static_cast<int64_t>(nvec.size())});
+		space.counts = std::move(nvec);
+		return space;
+	}
+
+	Kind GetKind() const { return kind; }
+
+	/** Returns the dimensions of one value of the space. Empty for a scalar */
+	const std::vector<int64_t>& GetShape() const { return shape; }
+
+	/** Returns the type of the elements: float for a Box, int32 otherwise */
+	TensorType GetType() const { return kind == Kind::Box ? TensorType::Float32() : TensorType::Int32(); }
+
+	/** Returns the number of elements of one value of the space */
+	size_t ElementCount() const
+	{
+		size_t count = 1;
+		for (int64_t dimension : shape)
+			count *= static_cast<size_t>(dimension);
+
+		return count;
+	}
+
+	/** Returns the number of bytes of one value of the space */
+	size_t ByteSize() const { return ElementCount() * GetType().ByteSize(); }
+
+	float GetLow() const { return low; }
+	float GetHigh() const { return high; }
+
+	/** Returns the number of values of each element of a discrete space */
+	const std::vector<int64_t>& GetCounts() const { return counts; }
+
+	/**
+	 * Whether a value belongs to the space
+	 * @param [in] value ElementCount() elements of the type of the space
+	 */
+	bool Contains(const void* value) const
+	{
+		if (kind == Kind::Box)
+		{
+			const auto* floats = static_cast<const float*>(value);
+			for (size_t i = 0; i < ElementCount(); ++i)
+				if (not (floats[i] >= low and floats[i] <= high))
+					return false;
+		}
+		else
+		{
+			const auto* ints = static_cast<const int32_t*>(value);
+			for (size_t i = 0; i < counts.size(); ++i)
+				if (ints[i] < 0 or ints[i] >= counts[i])
+					return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Writes a uniformly drawn value of the space, e.g. a random action
+	 * @param [in] random Random engine
+	 * @param [out] value ElementCount() elements of the type of the space
+	 * @note Unbounded dimensions of a Box are drawn from a standard normal distribution
+	 */
+	template<class Random>
+	void Sample(Random& random, void* value) const
+	{
+		if (kind == Kind::Box)
+		{
+			auto* floats = static_cast<float*>(value);
+			const bool is_bounded = low > -std::numeric_limits<float>::infinity() and high < std::numeric_limits<float>::infinity();
+
+			std::uniform_real_distribution<float> uniform(is_bounded ? low : 0.0f, is_bounded ? high : 1.0f);
+			std::normal_distribution<float> normal;
+			for (size_t i = 0; i < ElementCount(); ++i)
+				floats[i] = is_bounded ? uniform(random) : normal(random);
+		}
+		else
+		{
+			auto* ints = static_cast<int32_t*>(value);
+			for (size_t i = 0; i < counts.size(); ++i)
+				ints[i] = std::uniform_int_distribution<int32_t>(0, static_cast<int32_t>(counts[i] - 1))(random);
+		}
+	}
+
+private:
+	Space(Kind kind, std::vector<int64_t> shape) : kind(kind), shape(std::move(shape)) {}
+
+	Kind kind = Kind::Box;
+
+	/// Dimensions of one value
+	std::vector<int64_t> shape{};
+
+	/// Bounds of a Box
+	float low = 0.0f;
+	float high = 0.0f;
+
+	/// Number of values of each element of a (multi) discrete space
+	std::vector<int64_t> counts{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_ENVIRONMENT_SPACE_H
@@ -0,0 +1,286 @@
+#ifndef PIXIE_ENVIRONMENT_SPACE_BUFFER_H
+#define PIXIE_ENVIRONMENT_SPACE_BUFFER_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Pixie/Environment/Space.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Non owning description of a dense tensor, laid out like a DLTensor so
+ * that it can be handed to DLPack consumers, or to NumPy through its byte
+ * strides, without copying the data
+ */
+struct TensorView
+{
+	static constexpr int32_t max_dimensions = 8;
+
+	/// First element of the tensor
+	void* data = nullptr;
+
+	/// Type of the elements
+	TensorType type{};
+
+	/// Number of dimensions
+	int32_t ndim = 0;
+
+	/// Size of each dimension
+	int64_t shape[max_dimensions] = {};
+
+	/// Distance between two consecutive indices of each dimension, in elements as in DLPack
+	int64_t strides[max_dimensions] = {};
+
+	/** Returns the distance between two consecutive indices of a dimension in bytes, as in NumPy */
+	int64_t ByteStride(int32_t dimension) const { return strides[dimension] * static_cast<int64_t>(type.ByteSize()); }
+
+	/** Returns the number of elements of the tensor */
+	size_t ElementCount() const
+	{
+		size_t count = 1;
+		for (int32_t i = 0; i < ndim; ++i)
+			count *= static_cast<size_t>(shape[i]);
+
+		return count;
+	}
+};
+
+
+/**
+ * Storage of the observations or the actions of a batch of agents, in a
+ * single aligned allocation.
+ *
+ * Each field is a named space. Its values for the whole batch form one
+ * C-contiguous block of shape [batch size, space shape...], starting on a
+ * cache line, so that:
+ * - a field can be exposed as a tensor without copy, see GetTensor
+ * - an observation is written by storing straight into the block, either
+ *   one agent at a time or by a batched kernel over the whole field
+ *
+ * @code
+ * SpaceBuffer observations(agent_count);
+ * const size_t view = observations.Add("view", Space::Box({7, 7, 2}, 0.0f, 1.0f));
+ * const size_t health = observations.Add("health", Space::Box({1}, 0.0f, 100.0f));
+ *
+ * grid.Observe(agents, 3, observations.Get<float>(view));
+ * observations.Get<float>(health, agent)[0] = hit_points;
+ * @endcode
+ *
+ * @warning Adding a field or resizing the batch reallocates the storage and
+ * invalidates every span and tensor previously returned
+ */
+class SpaceBuffer
+{
+public:
+	/// Alignment of the storage and of the block of each field, in bytes
+	static constexpr size_t alignment = 64;
+
+	/// Returned by Find when no field has the given name
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	SpaceBuffer() = default;
+
+	/**
+	 * (Constructor) Creates an empty buffer
+	 * @param [in] batch_size Number of agents or environments of the batch
+	 */
+	explicit SpaceBuffer(size_t batch_size) : batch_size(batch_size) {}
+
+	SpaceBuffer(const SpaceBuffer&) = delete;
+	SpaceBuffer& operator=(const SpaceBuffer&) = delete;
+	SpaceBuffer(SpaceBuffer&&) noexcept = default;
+	SpaceBuffer& operator=(SpaceBuffer&&) noexcept = default;
+
+	/**
+	 * Adds a field, zero initialized for the whole batch
+	 * @param [in] name Name of the field, unique within the buffer
+	 * @param [in] space Values of the field
+	 * @return The index of the field
+	 * @throw std::invalid_argument if the name is taken or the space has too many dimensions
+	 */
+	size_t Add(std::string name, Space space)
+	{
+		if (Find(name) != npos)
+			throw std::invalid_argument("A field named " + name + " already exists");
+		if (space.GetShape().size() + 1 > static_cast<size_t>(TensorView::max_dimensions))
+			throw std::invalid_argument("The space of " + name + " has too many dimensions");
+
+		fields.push_back({std::move(name), std::move(space), 0});
+		Allocate();
+		return fields.size() - 1;
+	}
+
+	/** Returns the index of the field with the given name, or npos */
+	size_t Find(const std::string& name) const
+	{
+		for (size_t i = 0; i < fields.size(); ++i)
+			if (fields[i].name == name)
+				return i;
+
+		return npos;
+	}
+
+	/**
+	 * Changes the number of agents of the batch. The values are reset to zero
+	 * @param [in] size New number of agents or environments
+	 */
+	void Resize(size_t size)
+	{
+		batch_size = size;
+		Allocate();
+	}
+
+	/** Sets every value of every field to zero */
+	void Clear()
+	{
+		if (data)
+			std::memset(data, 0, byte_size);
+	}
+
+	size_t BatchSize() const { return batch_size; }
+	size_t FieldCount() const { return fields.size(); }
+
+	const std::string& GetName(size_t field) const { return fields[field].name; }
+	const Space& GetSpace(size_t field) const { return fields[field].space; }
+
+	/**
+	 * Returns the values of a field for the whole batch, agent after agent
+	 * @tparam T float for a Box, int32_t otherwise
+	 * @throw std::invalid_argument if T is not the type of the space
+	 */
+	template<class T>
+	Span<T> Get(size_t field)
+	{
+		CheckType<T>(field);
+		return {reinterpret_cast<T*>(data + fields[field].offset), batch_size * fields[field].space.ElementCount()};
+	}
+
+	template<class T>
+	Span<const T> Get(size_t field) const
+	{
+		CheckType<T>(field);
+		return {reinterpret_cast<const T*>(data + fields[field].offset), batch_size * fields[field].space.ElementCount()};
+	}
+
+	/**
+	 * Returns the values of a field for one agent
+	 * @tparam T float for a Box, int32_t otherwise
+	 * @param [in] index Index of the agent in the batch
+	 */
+	template<class T>
+	Span<T> Get(size_t field, size_t index)
+	{
+		const size_t count = fields[field].space.ElementCount();
+		return Get<T>(field).subspan(index * count, count);
+	}
+
+	template<class T>
+	Span<const T> Get(size_t field, size_t index) const
+	{
+		const size_t count = fields[field].space.ElementCount();
+		return Get<T>(field).subspan(index * count, count);
+	}
+
+	/**
+	 * Returns a field as a tensor of shape [batch size, space shape...]
+	 * @note The tensor views the storage of the buffer, see the class warning
+	 */
+	TensorView GetTensor(size_t field) const
+	{
+		const Field& source = fields[field];
+		const std::vector<int64_t>& shape = source.space.GetShape();
+
+		TensorView tensor;
+		tensor.data = data + source.offset;
+		tensor.type = source.space.GetType();
+		tensor.ndim = static_cast<int32_t>(shape.size()) + 1;
+		tensor.shape[0] = static_cast<int64_t>(batch_size);
+		for (size_t i = 0; i < shape.size(); ++i)
+			tensor.shape[i + 1] = shape[i];
+
+		int64_t stride = 1;
+		for (int32_t i = tensor.ndim - 1; i >= 0; --i)
+		{
+			tensor.strides[i] = stride;
+			stride *= tensor.shape[i];
+		}
+
+		return tensor;
+	}
+
+	/** Returns the start of the storage, aligned to 'alignment' */
+	void* Data() { return data; }
+	const void* Data() const { return data; }
+
+	/** Returns the size of the storage in bytes, padding included */
+	size_t ByteSize() const { return byte_size; }
+
+private:
+	struct Field
+	{
+		std::string name;
+		Space space;
+
+		/// Offset of the block of the field from the start of the storage
+		size_t offset;
+	};
+
+	/** Rounds a size up to a multiple of the alignment */
+	static size_t Align(size_t size) { return (size + alignment - 1) / alignment * alignment; }
+
+	/**
+	 * Lays out the blocks of the fields one after the other and allocates
+	 * zeroed storage for them
+	 */
+	void Allocate()
+	{
+		byte_size = 0;
+		for (Field& field : fields)
+		{
+			field.offset = byte_size;
+			byte_size += Align(batch_size * field.space.ByteSize());
+		}
+
+		// Over-allocate to align the start by hand, operator new only
+		// guarantees the alignment of the fundamental types
+		storage.reset(new unsigned char[byte_size + alignment]());
+		const auto address = reinterpret_cast<uintptr_t>(storage.get());
+		data = storage.get() + (Align(address) - address);
+	}
+
+	template<class T>
+	void CheckType(size_t field) const
+	{
+		static_assert(std::is_same<std::remove_const_t<T>, float>::value or std::is_same<std::remove_const_t<T>, int32_t>::value,
+					  "The values of a space are either float or int32_t");
+
+		const TensorType expected = std::is_floating_point<T>::value ? TensorType::Float32() : TensorType::Int32();
+		if (fields[field].space.GetType() != expected)
+			throw std::invalid_argument("The values of " + fields[field].name + " are not of the requested type");
+	}
+
+	/// Number of agents or environments of the batch
+	size_t batch_size = 1;
+
+	/// Fields in the order they were added
+	std::vector<Field> fields{};
+
+	/// Storage of the blocks, and its aligned start
+	std::unique_ptr<unsigned char[]> storage{};
+	unsigned char* data = nullptr;
+
+	/// Size of the blocks in bytes
+	size_t byte_size = 0;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_ENVIRONMENT_SPACE_BUFFER_H
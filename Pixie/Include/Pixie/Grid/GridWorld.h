@@ -0,0 +1,357 @@
+#ifndef PIXIE_GRID_GRID_WORLD_H
+#define PIXIE_GRID_GRID_WORLD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "Pixie/Core/Engine/WorkerPool.h"
+#include "Pixie/Grid/TileLayer.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Direction an agent faces. Rows grow southward, columns eastward
+ */
+enum class Facing : uint8_t
+{
+	North,
+	East,
+	South,
+	West
+};
+
+/**
+ * Tiles counted as neighbors of a tile
+ */
+enum class Neighborhood : uint8_t
+{
+	/// The four orthogonal tiles
+	VonNeumann,
+
+	/// The eight surrounding tiles
+	Moore
+};
+
+/**
+ * Position and facing of an agent on a grid
+ */
+struct GridAgent
+{
+	int x = 0;
+	int y = 0;
+	Facing facing = Facing::North;
+};
+
+
+/**
+ * Counts the set neighbors of every tile, 64 tiles at a time: the shifted
+ * neighbor rows are summed into bit planes with word-wide adders, then the
+ * planes are spread into one byte per tile.
+ * @param [in] layer Tiles to count
+ * @param [out] counts Number of set neighbors of each tile. Must have the size of the layer
+ * @param [in] neighborhood Tiles counted as neighbors
+ */
+inline void CountNeighbors(const BitLayer& layer, ByteLayer& counts, Neighborhood neighborhood = Neighborhood::Moore)
+{
+	const int words = static_cast<int>(layer.WordsPerRow());
+	const int width = layer.Width();
+
+	auto word_at = [&](int y, int w) -> uint64_t
+	{
+		return y >= 0 and y < layer.Height() and w >= 0 and w < words ? layer.Row(y)[w] : 0;
+	};
+
+	// Bit x holds tile x - 1 (west neighbor) or x + 1 (east neighbor)
+	auto west = [&](int y, int w) { return (word_at(y, w) << 1) | (word_at(y, w - 1) >> 63); };
+	auto east = [&](int y, int w) { return (word_at(y, w) >> 1) | (word_at(y, w + 1) << 63); };
+
+	for (int y = 0; y < layer.Height(); ++y)
+	{
+		uint8_t* row = counts.Row(y);
+
+		for (int w = 0; w < words; ++w)
+		{
+			const uint64_t up = word_at(y - 1, w);
+			const uint64_t down = word_at(y + 1, w);
+			const uint64_t left = west(y, w);
+			const uint64_t right = east(y, w);
+
+			uint64_t b0, b1, b2, b3 = 0;
+			if (neighborhood == Neighborhood::VonNeumann)
+			{
+				const uint64_t s = up ^ down ^ left;
+				const uint64_t c = (up & down) | (left & (up ^ down));
+
+				b0 = s ^ right;
+				const uint64_t c2 = s & right;
+				b1 = c ^ c2;
+				b2 = c & c2;
+			}
+			else
+			{
+				const uint64_t up_left = west(y - 1, w), up_right = east(y - 1, w);
+				const uint64_t down_left = west(y + 1, w), down_right = east(y + 1, w);
+
+				// Ones of three groups of neighbors, and their carries
+				const uint64_t s0 = up_left ^ up ^ up_right;
+				const uint64_t c0 = (up_left & up) | (up_right & (up_left ^ up));
+				const uint64_t s1 = left ^ right ^ down_left;
+				const uint64_t c1 = (left & right) | (down_left & (left ^ right));
+				const uint64_t s2 = down ^ down_right;
+				const uint64_t c2 = down & down_right;
+
+				b0 = s0 ^ s1 ^ s2;
+				const uint64_t c3 = (s0 & s1) | (s2 & (s0 ^ s1));
+
+				// Twos
+				const uint64_t t = c0 ^ c1 ^ c2;
+				const uint64_t c4 = (c0 & c1) | (c2 & (c0 ^ c1));
+				b1 = t ^ c3;
+				const uint64_t c5 = t & c3;
+
+				// Fours and eights
+				b2 = c4 ^ c5;
+				b3 = c4 & c5;
+			}
+
+			const int first = w * BitLayer::word_bits;
+			const int last = std::min(first + BitLayer::word_bits, width);
+			for (int x = first, bit = 0; x < last; ++x, ++bit)
+			{
+				row[x] = static_cast<uint8_t>(((b0 >> bit) & 1u) | ((b1 >> bit) & 1u) << 1 |
+											  ((b2 >> bit) & 1u) << 2 | ((b3 >> bit) & 1u) << 3);
+			}
+		}
+	}
+}
+
+/**
+ * Whether the straight line between two tiles crosses no blocking tile. The
+ * end tiles themselves are not checked, so a wall is seen but not what is
+ * behind it
+ */
+inline bool HasLineOfSight(const BitLayer& blockers, int x0, int y0, int x1, int y1)
+{
+	const int dx = std::abs(x1 - x0);
+	const int dy = -std::abs(y1 - y0);
+	const int step_x = x0 < x1 ? 1 : -1;
+	const int step_y = y0 < y1 ? 1 : -1;
+
+	if (dx == 0 and dy == 0)
+		return true;
+
+	int error = dx + dy;
+	int x = x0, y = y0;
+	while (true)
+	{
+		const int doubled = 2 * error;
+		if (doubled >= dy)
+		{
+			error += dy;
+			x += step_x;
+		}
+		if (doubled <= dx)
+		{
+			error += dx;
+			y += step_y;
+		}
+
+		if (x == x1 and y == y1)
+			return true;
+
+		if (blockers.Get(x, y))
+			return false;
+	}
+}
+
+/**
+ * Computes which tiles around a position are in sight
+ * @param [in] blockers Tiles that block the sight
+ * @param [in] x, y Position seeing
+ * @param [in] radius Distance seen in each direction
+ * @param [out] visible Square of (2 * radius + 1) tiles centered on the
+ * position, north up; resized if needed
+ */
+inline void ComputeVisibility(const BitLayer& blockers, int x, int y, int radius, BitLayer& visible)
+{
+	const int side = 2 * radius + 1;
+	if (visible.Width() != side or visible.Height() != side)
+		visible = BitLayer(side, side);
+	else
+		visible.Fill(false);
+
+	for (int row = 0; row < side; ++row)
+		for (int column = 0; column < side; ++column)
+		{
+			const int target_x = x + column - radius;
+			const int target_y = y + row - radius;
+
+			if (HasLineOfSight(blockers, x, y, target_x, target_y))
+				visible.Set(column, row);
+		}
+}
+
+
+/**
+ * Grid world made of bit and byte tile layers of the same size, with
+ * egocentric observations written straight into observation buffers.
+ *
+ * A world is a plain object, usually owned by the Tickable that runs the
+ * environment:
+ * @code
+ * GridWorld world(64, 64);
+ * const size_t walls = world.AddBitLayer();
+ * const size_t food = world.AddByteLayer();
+ *
+ * std::vector<float> observations(agents.size() * world.ObservationSize(radius));
+ * world.Observe(Span<const GridAgent>(agents), radius, Span<float>(observations), &Core::GetWorkerPool(), walls);
+ * @endcode
+ */
+class GridWorld
+{
+public:
+	/// Marks the absence of a layer
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	/// Number of agents observed per chunk of work
+	static constexpr size_t agents_per_chunk = 32;
+
+	/**
+	 * (Constructor) Constructs a world without layers
+	 * @param [in] width Number of tiles per row
+	 * @param [in] height Number of rows
+	 */
+	GridWorld(int width, int height) : width(width), height(height) {}
+
+	int Width() const { return width; }
+	int Height() const { return height; }
+
+	/**
+	 * Adds a layer of one bit per tile, all cleared
+	 * @return Index of the layer
+	 */
+	size_t AddBitLayer()
+	{
+		bit_layers.emplace_back(width, height);
+		return bit_layers.size() - 1;
+	}
+
+	/**
+	 * Adds a layer of one byte per tile, all 0
+	 * @return Index of the layer
+	 */
+	size_t AddByteLayer()
+	{
+		byte_layers.emplace_back(width, height);
+		return byte_layers.size() - 1;
+	}
+
+	BitLayer& GetBitLayer(size_t index) { return bit_layers[index]; }
+	const BitLayer& GetBitLayer(size_t index) const { return bit_layers[index]; }
+
+	ByteLayer& GetByteLayer(size_t index) { return byte_layers[index]; }
+	const ByteLayer& GetByteLayer(size_t index) const { return byte_layers[index]; }
+
+	/** Returns the number of channels of an observation: the bit layers, then the byte layers */
+	size_t ChannelCount() const { return bit_layers.size() + byte_layers.size(); }
+
+	/** Returns the number of values of the observation of one agent */
+	size_t ObservationSize(int radius) const
+	{
+		const auto side = static_cast<size_t>(2 * radius + 1);
+		return ChannelCount() * side * side;
+	}
+
+	/**
+	 * Maps a tile of an egocentric view to the world
+	 * @param [in] agent Agent viewing
+	 * @param [in] radius Distance viewed in each direction
+	 * @param [in] column, row Tile of the view, facing up
+	 * @param [out] x, y Tile of the world
+	 */
+	static void ToWorld(const GridAgent& agent, int radius, int column, int row, int& x, int& y)
+	{
+		// Negative forward is ahead of the agent
+		const int right = column - radius;
+		const int forward = row - radius;
+
+		switch (agent.facing)
+		{
+			case Facing::North: x = agent.x + right; y = agent.y + forward; break;
+			case Facing::East: x = agent.x - forward; y = agent.y + right; break;
+			case Facing::South: x = agent.x - right; y = agent.y - forward; break;
+			case Facing::West: x = agent.x + forward; y = agent.y - right; break;
+		}
+	}
+
+	/**
+	 * Writes the egocentric view of each agent: a square of (2 * radius + 1)
+	 * tiles centered on the agent and rotated so that it faces up, laid out
+	 * [agent][channel][row][column]. Tiles off the grid or out of sight are 0.
+	 * @tparam T Value type of the observations, e.g. float or uint8_t
+	 * @param [in] agents Agents to observe
+	 * @param [in] radius Distance viewed in each direction
+	 * @param [out] observations Holds agents.size() * ObservationSize(radius) values
+	 * @param [in] workers Workers to split the agents across, or nullptr
+	 * @param [in] blockers Bit layer that blocks the sight, or npos to see everything
+	 */
+	template<class T>
+	void Observe(Span<const GridAgent> agents, int radius, Span<T> observations,
+				 WorkerPool* workers = nullptr, size_t blockers = npos) const
+	{
+		auto observe = [&](size_t begin, size_t end)
+		{
+			BitLayer visible;
+			for (size_t i = begin; i < end; ++i)
+				ObserveAgent(agents[i], radius, observations.data() + i * ObservationSize(radius), blockers, visible);
+		};
+
+		if (workers)
+			workers->ParallelFor(agents.size(), agents_per_chunk, observe);
+		else
+			observe(0, agents.size());
+	}
+
+private:
+	template<class T>
+	void ObserveAgent(const GridAgent& agent, int radius, T* out, size_t blockers, BitLayer& visible) const
+	{
+		const int side = 2 * radius + 1;
+		const size_t tiles = static_cast<size_t>(side) * side;
+
+		if (blockers != npos)
+			ComputeVisibility(bit_layers[blockers], agent.x, agent.y, radius, visible);
+
+		for (int row = 0; row < side; ++row)
+			for (int column = 0; column < side; ++column)
+			{
+				int x, y;
+				ToWorld(agent, radius, column, row, x, y);
+
+				const size_t tile = static_cast<size_t>(row) * side + column;
+				const bool is_seen = (x >= 0 and y >= 0 and x < width and y < height) and
+									 (blockers == npos or visible.Get(x - agent.x + radius, y - agent.y + radius));
+
+				size_t channel = 0;
+				for (const auto& layer : bit_layers)
+					out[channel++ * tiles + tile] = is_seen ? static_cast<T>(layer.Get(x, y)) : T(0);
+
+				for (const auto& layer : byte_layers)
+					out[channel++ * tiles + tile] = is_seen ? static_cast<T>(layer.Row(y)[x]) : T(0);
+			}
+	}
+
+	int width = 0;
+	int height = 0;
+
+	std::vector<BitLayer> bit_layers{};
+	std::vector<ByteLayer> byte_layers{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_GRID_GRID_WORLD_H
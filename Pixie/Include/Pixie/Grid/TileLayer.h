@@ -0,0 +1,179 @@
+#ifndef PIXIE_GRID_TILE_LAYER_H
+#define PIXIE_GRID_TILE_LAYER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace pixie
+{
+
+/** Returns the number of set bits of a word */
+inline int Popcount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<int>(__popcnt64(word));
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ull);
+	word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+
+/**
+ * Grid layer of one bit per tile, e.g. walls or occupancy.
+ *
+ * Each row is padded to a whole number of 64 bit words, tile x of a row
+ * being bit x % 64 of word x / 64. The padding bits are always 0, so that
+ * kernels can process a row 64 tiles at a time without masking.
+ */
+class BitLayer
+{
+public:
+	/// Number of tiles per word
+	static constexpr int word_bits = 64;
+
+	/** Default constructor. Constructs an empty layer */
+	BitLayer() = default;
+
+	/**
+	 * (Constructor) Constructs a layer with every tile cleared
+	 * @param [in] width Number of tiles per row
+	 * @param [in] height Number of rows
+	 */
+	BitLayer(int width, int height)
+			: width(width), height(height), words_per_row((width + word_bits - 1) / word_bits),
+			  words(words_per_row * static_cast<size_t>(height), 0)
+	{
+	}
+
+	int Width() const { return width; }
+	int Height() const { return height; }
+	size_t WordsPerRow() const { return words_per_row; }
+
+	/** Whether a position is on the grid */
+	bool Contains(int x, int y) const { return x >= 0 and y >= 0 and x < width and y < height; }
+
+	/** Returns whether a tile is set. Tiles off the grid are not */
+	bool Get(int x, int y) const
+	{
+		if (not Contains(x, y))
+			return false;
+
+		return (Row(y)[x / word_bits] >> (x % word_bits)) & 1u;
+	}
+
+	/** Sets or clears a tile on the grid */
+	void Set(int x, int y, bool value = true)
+	{
+		uint64_t& word = Row(y)[x / word_bits];
+		const uint64_t bit = uint64_t(1) << (x % word_bits);
+		word = value ? word | bit : word & ~bit;
+	}
+
+	/** Sets or clears every tile */
+	void Fill(bool value)
+	{
+		std::fill(words.begin(), words.end(), value ? ~uint64_t(0) : uint64_t(0));
+
+		// Keep the padding bits cleared
+		const int tail = width % word_bits;
+		if (value and tail != 0)
+			for (int y = 0; y < height; ++y)
+				Row(y)[words_per_row - 1] = (uint64_t(1) << tail) - 1;
+	}
+
+	/** Returns the number of set tiles */
+	size_t Count() const
+	{
+		size_t count = 0;
+		for (uint64_t word : words)
+			count += Popcount(word);
+
+		return count;
+	}
+
+	/** Returns the words of a row */
+	uint64_t* Row(int y) { return words.data() + y * words_per_row; }
+	const uint64_t* Row(int y) const { return words.data() + y * words_per_row; }
+
+private:
+	int width = 0;
+	int height = 0;
+	size_t words_per_row = 0;
+
+	/// Rows of words, one after the other
+	std::vector<uint64_t> words{};
+};
+
+
+/**
+ * Grid layer of one byte per tile, e.g. terrain types or item counts.
+ *
+ * Each row is padded to a multiple of 16 bytes so that rows can be processed
+ * with whole vector registers.
+ */
+class ByteLayer
+{
+public:
+	/// Rows are padded to a multiple of this many bytes
+	static constexpr size_t row_alignment = 16;
+
+	/** Default constructor. Constructs an empty layer */
+	ByteLayer() = default;
+
+	/**
+	 * (Constructor) Constructs a layer with every tile set to 0
+	 * @param [in] width Number of tiles per row
+	 * @param [in] height Number of rows
+	 */
+	ByteLayer(int width, int height)
+			: width(width), height(height),
+			  stride((static_cast<size_t>(width) + row_alignment - 1) / row_alignment * row_alignment),
+			  bytes(stride * static_cast<size_t>(height), 0)
+	{
+	}
+
+	int Width() const { return width; }
+	int Height() const { return height; }
+
+	/** Returns the distance in bytes between two rows */
+	size_t Stride() const { return stride; }
+
+	/** Whether a position is on the grid */
+	bool Contains(int x, int y) const { return x >= 0 and y >= 0 and x < width and y < height; }
+
+	/** Returns the value of a tile. Tiles off the grid are 0 */
+	uint8_t Get(int x, int y) const { return Contains(x, y) ? Row(y)[x] : 0; }
+
+	/** Sets the value of a tile on the grid */
+	void Set(int x, int y, uint8_t value) { Row(y)[x] = value; }
+
+	/** Sets every tile to a value */
+	void Fill(uint8_t value) { std::fill(bytes.begin(), bytes.end(), value); }
+
+	/** Returns the bytes of a row */
+	uint8_t* Row(int y) { return bytes.data() + y * stride; }
+	const uint8_t* Row(int y) const { return bytes.data() + y * stride; }
+
+private:
+	int width = 0;
+	int height = 0;
+	size_t stride = 0;
+
+	/// Rows of bytes, one after the other
+	std::vector<uint8_t> bytes{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_GRID_TILE_LAYER_H
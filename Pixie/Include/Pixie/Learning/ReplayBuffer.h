@@ -0,0 +1,311 @@
+#ifndef PIXIE_LEARNING_REPLAY_BUFFER_H
+#define PIXIE_LEARNING_REPLAY_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "Pixie/Environment/SpaceBuffer.h"
+#include "Pixie/Learning/SumTree.h"
+#include "Pixie/Math/Float4.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Slot of a replay buffer claimed by a producer
+ */
+struct ReplaySlot
+{
+	/// Index of the slot in the columns
+	uint32_t index;
+
+	/// Number of transitions appended before this one
+	uint64_t ticket;
+};
+
+
+/**
+ * Fixed capacity store of transitions, overwriting the oldest once full,
+ * with uniform or prioritized sampling.
+ *
+ * Transitions are stored by column, each column a space whose values for
+ * every slot form one contiguous block (see SpaceBuffer). Any number of
+ * producers, e.g. the workers stepping environments, append without a lock:
+ * @code
+ * ReplayBuffer replay(1 << 20);
+ * const size_t observation = replay.AddColumn("observation", Space::Box({8}));
+ * const size_t action = replay.AddColumn("action", Space::Discrete(4));
+ * const size_t reward = replay.AddColumn("reward", Space::Box({}));
+ *
+ * // Producer thread
+ * replay.Append({observation_values, &chosen_action, &reward_value});
+ *
+ * // Learner thread
+ * replay.SamplePrioritized(random, indices, weights, 0.4f);
+ * replay.Gather(observation, indices, observation_batch);
+ * ...
+ * replay.UpdatePriorities(indices, td_errors);
+ * @endcode
+ *
+ * A producer claims the next slot with an atomic counter and marks it as
+ * being written, so that sampling skips it until it is published. A slot is
+ * not protected against being overwritten between its sampling and its
+ * gathering: size the buffer so that producers cannot append a full
+ * capacity of transitions meanwhile.
+ */
+class ReplayBuffer
+{
+public:
+	/**
+	 * (Constructor) Creates a buffer without columns
+	 * @param [in] capacity Maximum number of transitions, below 2^32
+	 * @param [in] alpha Exponent applied to the priorities, 0 for uniform and 1 for proportional sampling
+	 */
+	explicit ReplayBuffer(size_t capacity, float alpha = 0.6f)
+			: capacity(capacity), alpha(alpha), columns(capacity), priorities(capacity), versions(new std::atomic<uint64_t>[capacity])
+	{
+		for (size_t i = 0; i < capacity; ++i)
+			versions[i].store(0, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Adds a column to the transitions
+	 * @return The index of the column
+	 * @warning Call before appending any transition
+	 */
+	size_t AddColumn(std::string name, Space space) { return columns.Add(std::move(name), std::move(space)); }
+
+	/** Returns the columns, e.g. to look one up by name or to read its space */
+	const SpaceBuffer& GetColumns() const { return columns; }
+
+	/**
+	 * Claims the slot of the next transition, evicting the oldest transition
+	 * once the buffer is full. The slot is skipped by sampling until it is
+	 * published
+	 * @note Thread safe
+	 */
+	ReplaySlot Claim()
+	{
+		const uint64_t ticket = head.fetch_add(1, std::memory_order_relaxed);
+		const auto index = static_cast<uint32_t>(ticket % capacity);
+
+		versions[index].store(2 * ticket + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		priorities.Set(index, 0.0);
+		return {index, ticket};
+	}
+
+	/**
+	 * Returns the values of a column in a claimed slot, to write them in place
+	 * @tparam T float for a Box, int32_t otherwise
+	 */
+	template<class T>
+	Span<T> Get(size_t column, const ReplaySlot& slot) { return columns.Get<T>(column, slot.index); }
+
+	/**
+	 * Makes a claimed slot available to sampling
+	 * @param [in] priority Priority of the transition, e.g. its TD error.
+	 * Negative for the highest priority seen so far
+	 * @note Thread safe
+	 */
+	void Publish(const ReplaySlot& slot, float priority = -1.0f)
+	{
+		versions[slot.index].store(2 * slot.ticket + 2, std::memory_order_release);
+		SetPriority(slot.index, priority < 0.0f ? max_priority.load(std::memory_order_relaxed) : priority);
+	}
+
+	/**
+	 * Appends a transition by copying the value of each column
+	 * @param [in] values One pointer per column, to ElementCount() values of its space
+	 * @param [in] priority See Publish
+	 * @return The slot the transition was stored in
+	 * @note Thread safe
+	 */
+	ReplaySlot Append(std::initializer_list<const void*> values, float priority = -1.0f)
+	{
+		if (values.size() != columns.FieldCount())
+			throw std::invalid_argument("Append needs one value per column");
+
+		const ReplaySlot slot = Claim();
+		size_t column = 0;
+		for (const void* value : values)
+		{
+			const size_t size = columns.GetSpace(column).ByteSize();
+			std::memcpy(static_cast<unsigned char*>(columns.GetTensor(column).data) + slot.index * size, value, size);
+			++column;
+		}
+
+		Publish(slot, priority);
+		return slot;
+	}
+
+	/**
+	 * Draws transitions uniformly, with replacement
+	 * @param [in] random Random engine
+	 * @param [out] indices Slots of the drawn transitions
+	 * @return The number of transitions drawn: all of them, or none if the buffer is empty
+	 */
+	template<class Random>
+	size_t SampleUniform(Random& random, Span<uint32_t> indices) const
+	{
+		const size_t count = Size();
+		if (count == 0)
+			return 0;
+
+		std::uniform_int_distribution<size_t> uniform(0, count - 1);
+		for (uint32_t& index : indices)
+		{
+			do
+				index = static_cast<uint32_t>(uniform(random));
+			while (not IsPublished(index));
+		}
+
+		return indices.size();
+	}
+
+	/**
+	 * Draws transitions with a probability proportional to their priority,
+	 * one from each of indices.size() equal strata of the total priority
+	 * @param [in] random Random engine
+	 * @param [out] indices Slots of the drawn transitions
+	 * @param [out] weights Importance sampling weights (size * P(i))^-beta, divided by their maximum
+	 * @param [in] beta Exponent of the weights, from 0 for none to 1 for a full correction
+	 * @return The number of transitions drawn: all of them, or none if the buffer is empty
+	 */
+	template<class Random>
+	size_t SamplePrioritized(Random& random, Span<uint32_t> indices, Span<float> weights, float beta) const
+	{
+		const size_t count = Size();
+		const double total = priorities.Total();
+		if (count == 0 or not (total > 0.0))
+			return 0;
+
+		const double stratum = total / static_cast<double>(indices.size());
+		std::uniform_real_distribution<double> uniform(0.0, stratum);
+
+		float max_weight = 0.0f;
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			auto index = static_cast<uint32_t>(priorities.Find(stratum * static_cast<double>(i) + uniform(random)));
+			double priority = priorities.Get(index);
+
+			// A slot claimed meanwhile has a null priority and lowered the
+			// total, draw again over the current total
+			while (not (priority > 0.0) or not IsPublished(index))
+			{
+				index = static_cast<uint32_t>(priorities.Find(std::uniform_real_distribution<double>(0.0, priorities.Total())(random)));
+				priority = priorities.Get(index);
+			}
+
+			indices[i] = index;
+			weights[i] = static_cast<float>(std::pow(static_cast<double>(count) * priority / total, -static_cast<double>(beta)));
+			max_weight = std::max(max_weight, weights[i]);
+		}
+
+		for (float& weight : weights)
+			weight /= max_weight;
+
+		return indices.size();
+	}
+
+	/**
+	 * Sets the priorities of sampled transitions, e.g. to their new TD errors
+	 * @note Thread safe
+	 */
+	void UpdatePriorities(Span<const uint32_t> indices, Span<const float> values)
+	{
+		for (size_t i = 0; i < indices.size(); ++i)
+			SetPriority(indices[i], values[i]);
+	}
+
+	/**
+	 * Copies the values of a column for sampled transitions into a batch
+	 * @param [in] column Index of the column
+	 * @param [in] indices Slots of the transitions
+	 * @param [out] out indices.size() * ElementCount() values of the space of the column
+	 */
+	void Gather(size_t column, Span<const uint32_t> indices, void* out) const
+	{
+		const size_t count = columns.GetSpace(column).ElementCount();
+		const auto* source = static_cast<const unsigned char*>(columns.GetTensor(column).data);
+		auto* target = static_cast<unsigned char*>(out);
+		const size_t row_size = count * sizeof(float);
+
+		// Values are 32-bit floats or integers alike, moved by four through
+		// the float lanes without any arithmetic
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			const auto* row = reinterpret_cast<const float*>(source + indices[i] * row_size);
+			auto* destination = reinterpret_cast<float*>(target + i * row_size);
+
+			size_t j = 0;
+			for (; j + 4 <= count; j += 4)
+				Float4::Load(row + j).Store(destination + j);
+
+			std::memcpy(destination + j, row + j, (count - j) * sizeof(float));
+		}
+	}
+
+	/** Returns the number of transitions stored, including the ones being written */
+	size_t Size() const { return static_cast<size_t>(std::min<uint64_t>(head.load(std::memory_order_relaxed), capacity)); }
+
+	size_t Capacity() const { return capacity; }
+
+	/** Returns the number of transitions appended since the creation, evicted ones included */
+	uint64_t AppendCount() const { return head.load(std::memory_order_relaxed); }
+
+private:
+	/** Whether the transition in a slot is fully written */
+	bool IsPublished(uint32_t index) const
+	{
+		const uint64_t version = versions[index].load(std::memory_order_acquire);
+		return version != 0 and version % 2 == 0;
+	}
+
+	void SetPriority(uint32_t index, float priority)
+	{
+		float seen = max_priority.load(std::memory_order_relaxed);
+		while (priority > seen and not max_priority.compare_exchange_weak(seen, priority, std::memory_order_relaxed))
+		{
+		}
+
+		priorities.Set(index, std::pow(static_cast<double>(std::max(priority, min_priority)), static_cast<double>(alpha)));
+	}
+
+	/// Floor of the priorities, so that every transition can be drawn
+	static constexpr float min_priority = 1e-6f;
+
+	/// Maximum number of transitions
+	size_t capacity;
+
+	/// Exponent applied to the priorities
+	float alpha;
+
+	/// Values of the transitions, one block per column
+	SpaceBuffer columns;
+
+	/// Priorities of the slots, raised to alpha
+	SumTree priorities;
+
+	/// Per slot: 0 if never written, 2 * ticket + 1 while being written, 2 * ticket + 2 once published
+	std::unique_ptr<std::atomic<uint64_t>[]> versions;
+
+	/// Number of transitions claimed so far
+	std::atomic<uint64_t> head{0};
+
+	/// Highest priority seen, given to the transitions appended without one
+	std::atomic<float> max_priority{1.0f};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_LEARNING_REPLAY_BUFFER_H
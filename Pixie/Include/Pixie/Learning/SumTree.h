@@ -0,0 +1,115 @@
+#ifndef PIXIE_LEARNING_SUM_TREE_H
+#define PIXIE_LEARNING_SUM_TREE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace pixie
+{
+
+/**
+ * Binary tree whose leaves hold the priorities of a fixed number of items
+ * and whose inner nodes hold the sums of their subtrees, so that an item is
+ * drawn with a probability proportional to its priority in O(log n).
+ *
+ * Priorities can be set from several threads at once without a lock: a
+ * leaf is exchanged, then the change is added to each of its ancestors by
+ * compare and swap. Concurrent readers may see a sum that is missing an
+ * update in flight, which only skews a draw for the duration of that update.
+ */
+class SumTree
+{
+public:
+	/**
+	 * (Constructor) Creates a tree with every priority set to zero
+	 * @param [in] capacity Number of items
+	 */
+	explicit SumTree(size_t capacity) : capacity(capacity)
+	{
+		while (leaf_count < capacity)
+			leaf_count *= 2;
+
+		nodes.reset(new std::atomic<double>[2 * leaf_count]);
+		for (size_t i = 0; i < 2 * leaf_count; ++i)
+			nodes[i].store(0.0, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Sets the priority of an item
+	 * @note Thread safe
+	 */
+	void Set(size_t index, double priority)
+	{
+		size_t node = leaf_count + index;
+		const double delta = priority - nodes[node].exchange(priority, std::memory_order_relaxed);
+
+		for (node /= 2; node >= 1; node /= 2)
+		{
+			double sum = nodes[node].load(std::memory_order_relaxed);
+			while (not nodes[node].compare_exchange_weak(sum, sum + delta, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	/** Returns the priority of an item */
+	double Get(size_t index) const { return nodes[leaf_count + index].load(std::memory_order_relaxed); }
+
+	/** Returns the sum of all the priorities */
+	double Total() const { return nodes[1].load(std::memory_order_relaxed); }
+
+	/**
+	 * Looks up the item at which the running sum of the priorities reaches a value
+	 * @param [in] value Value in [0, Total())
+	 * @return The index of the item, clamped to the last item
+	 */
+	size_t Find(double value) const
+	{
+		size_t node = 1;
+		while (node < leaf_count)
+		{
+			const double left = nodes[2 * node].load(std::memory_order_relaxed);
+			if (value < left)
+			{
+				node = 2 * node;
+			}
+			else
+			{
+				value -= left;
+				node = 2 * node + 1;
+			}
+		}
+
+		const size_t index = node - leaf_count;
+		return index < capacity ? index : capacity - 1;
+	}
+
+	/**
+	 * Recomputes the inner nodes from the leaves, discarding the rounding
+	 * errors accumulated by the updates
+	 * @warning Not thread safe, call while no priority is being set
+	 */
+	void Rebuild()
+	{
+		for (size_t node = leaf_count - 1; node >= 1; --node)
+			nodes[node].store(nodes[2 * node].load(std::memory_order_relaxed) + nodes[2 * node + 1].load(std::memory_order_relaxed),
+							  std::memory_order_relaxed);
+	}
+
+	size_t Capacity() const { return capacity; }
+
+private:
+	/// Number of items
+	size_t capacity;
+
+	/// Number of leaves, the capacity rounded up to a power of two
+	size_t leaf_count = 1;
+
+	/// Nodes of the tree, the root at 1 and the children of n at 2n and 2n + 1
+	std::unique_ptr<std::atomic<double>[]> nodes{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_LEARNING_SUM_TREE_H
@@ -0,0 +1,377 @@
+#ifndef PIXIE_LEARNING_TRAJECTORY_RECORDER_H
+#define PIXIE_LEARNING_TRAJECTORY_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Pixie/Environment/SpaceBuffer.h"
+#include "Pixie/Utility/MappedFile.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Header of a trajectory file, followed by its rows from byte
+ * sizeof(TrajectoryHeader) on, e.g. for NumPy:
+ * @code
+ * numpy.memmap(path, dtype=numpy.float32, mode="r", offset=128, shape=(count, *shape))
+ * @endcode
+ */
+struct TrajectoryHeader
+{
+	static constexpr uint32_t current_version = 1;
+
+	/// "PIXTRAJ" followed by a null character
+	char magic[8];
+
+	/// Version of the format
+	uint32_t version;
+
+	/// Number of dimensions of a row
+	int32_t ndim;
+
+	/// Type of the elements
+	TensorType type;
+
+	/// Size of a row in bytes
+	uint32_t row_size;
+
+	/// Number of rows the file has room for
+	uint64_t capacity;
+
+	/// Number of rows written to the disk
+	uint64_t count;
+
+	/// Size of each dimension of a row
+	int64_t shape[TensorView::max_dimensions];
+
+	/// Rounds the header up to two cache lines, which aligns the rows
+	uint8_t padding[24];
+
+	/** Whether the header starts a trajectory file of a known version */
+	bool IsValid() const { return std::memcmp(magic, "PIXTRAJ", 8) == 0 and version == current_version; }
+};
+
+static_assert(sizeof(TrajectoryHeader) == 128, "The header of a trajectory file spans 128 bytes");
+
+
+/**
+ * Records episodes for offline learning, one memory mapped file per field
+ * (observation, action, reward, done, ...), each holding one row per step.
+ *
+ * Files are sized for the whole recording upfront, so that recording a step
+ * is a memcpy per field into the mapping. A background thread writes the
+ * recorded rows to the disk, then publishes their count in the header, so
+ * that readers (see TrajectoryReader) can map the files and train from them
+ * while they are being recorded.
+ *
+ * @code
+ * TrajectoryRecorder recorder("episodes", 1000000);
+ * recorder.AddFields(*ObjectInitializer::GetObservations());
+ * const size_t action = recorder.AddField("action", Space::Discrete(4));
+ *
+ * // Each step
+ * recorder.Record({observations.GetTensor(0).data, ..., &chosen_action});
+ * @endcode
+ *
+ * @note Steps are recorded from a single thread
+ */
+class TrajectoryRecorder
+{
+public:
+	/// Extension of the trajectory files
+	static constexpr const char* extension = ".pxt";
+
+	/**
+	 * (Constructor) Creates a recorder without fields
+	 * @param [in] directory Existing directory the files are created in
+	 * @param [in] capacity Number of steps the files have room for
+	 * @param [in] flush_interval Time between two writes to the disk
+	 */
+	TrajectoryRecorder(std::string directory, size_t capacity,
+					   std::chrono::milliseconds flush_interval = std::chrono::milliseconds(500))
+			: directory(std::move(directory)), capacity(capacity), flush_interval(flush_interval) {}
+
+	~TrajectoryRecorder() { Close(); }
+
+	TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+	TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+	/** Returns the path of the file of a field */
+	static std::string GetPath(const std::string& directory, const std::string& name)
+	{
+		return directory + "/" + name + extension;
+	}
+
+	/**
+	 * Adds a field whose rows are values of a space, creating its file
+	 * @return The index of the field
+	 * @throw std::runtime_error if the file cannot be created
+	 * @warning Call before recording any step
+	 */
+	size_t AddField(const std::string& name, const Space& space)
+	{
+		return AddField(name, space.GetType(), space.GetShape());
+	}
+
+	/**
+	 * Adds one field per field of a buffer, whose rows are its values for the
+	 * whole batch, e.g. the observations of a scene
+	 * @return The index of the first field added
+	 */
+	size_t AddFields(const SpaceBuffer& buffer)
+	{
+		const size_t first = fields.size();
+		for (size_t i = 0; i < buffer.FieldCount(); ++i)
+		{
+			const TensorView tensor = buffer.GetTensor(i);
+			AddField(buffer.GetName(i), tensor.type, std::vector<int64_t>(tensor.shape, tensor.shape + tensor.ndim));
+		}
+
+		return first;
+	}
+
+	/**
+	 * Records a step
+	 * @param [in] values One pointer per field, to a row of the field
+	 * @return True if recorded; false if the files are full or closed
+	 */
+	bool Record(std::initializer_list<const void*> values)
+	{
+		if (values.size() != fields.size())
+			throw std::invalid_argument("Record needs one value per field");
+
+		const uint64_t row = count.load(std::memory_order_relaxed);
+		if (row == capacity or is_closed)
+			return false;
+
+		if (not flusher.joinable())
+			flusher = std::thread([this] { RunFlusher(); });
+
+		size_t field = 0;
+		for (const void* value : values)
+		{
+			Field& target = fields[field++];
+			std::memcpy(static_cast<unsigned char*>(target.file.Data()) + sizeof(TrajectoryHeader) + row * target.row_size,
+						value, target.row_size);
+		}
+
+		count.store(row + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Writes the recorded steps to the disk and publishes their count now,
+	 * rather than at the next interval
+	 */
+	void Flush()
+	{
+		std::lock_guard<std::mutex> lock(flush_mutex);
+
+		const uint64_t recorded = count.load(std::memory_order_acquire);
+		if (recorded == flushed)
+			return;
+
+		for (Field& field : fields)
+		{
+			// Rows first, so that the count never covers rows that are not on the disk
+			field.file.Flush(sizeof(TrajectoryHeader) + flushed * field.row_size, (recorded - flushed) * field.row_size);
+
+			GetHeader(field).count = recorded;
+			field.file.Flush(0, sizeof(TrajectoryHeader));
+		}
+
+		flushed = recorded;
+	}
+
+	/**
+	 * Stops the background thread, writes the remaining steps and closes the
+	 * files. Called on destruction
+	 */
+	void Close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(wake_mutex);
+			is_stopping = true;
+		}
+		wake.notify_one();
+
+		if (flusher.joinable())
+			flusher.join();
+
+		Flush();
+		for (Field& field : fields)
+			field.file.Close();
+
+		is_closed = true;
+	}
+
+	/** Returns the number of steps recorded */
+	size_t Size() const { return static_cast<size_t>(count.load(std::memory_order_relaxed)); }
+
+	size_t Capacity() const { return capacity; }
+
+	size_t FieldCount() const { return fields.size(); }
+
+private:
+	struct Field
+	{
+		MappedFile file;
+
+		/// Size of a row in bytes
+		size_t row_size;
+	};
+
+	size_t AddField(const std::string& name, TensorType type, const std::vector<int64_t>& shape)
+	{
+		if (flusher.joinable())
+			throw std::logic_error("Fields are added before recording");
+		if (shape.size() + 1 > static_cast<size_t>(TensorView::max_dimensions))
+			throw std::invalid_argument("The rows of " + name + " have too many dimensions");
+
+		size_t row_size = type.ByteSize();
+		for (int64_t dimension : shape)
+			row_size *= static_cast<size_t>(dimension);
+
+		Field field{MappedFile::Create(GetPath(directory, name), sizeof(TrajectoryHeader) + capacity * row_size), row_size};
+
+		TrajectoryHeader& header = GetHeader(field);
+		header = TrajectoryHeader();
+		std::memcpy(header.magic, "PIXTRAJ", 8);
+		header.version = TrajectoryHeader::current_version;
+		header.ndim = static_cast<int32_t>(shape.size());
+		header.type = type;
+		header.row_size = static_cast<uint32_t>(row_size);
+		header.capacity = capacity;
+		header.count = 0;
+		for (size_t i = 0; i < shape.size(); ++i)
+			header.shape[i] = shape[i];
+
+		field.file.Flush(0, sizeof(TrajectoryHeader));
+		fields.push_back(std::move(field));
+		return fields.size() - 1;
+	}
+
+	static TrajectoryHeader& GetHeader(Field& field) { return *static_cast<TrajectoryHeader*>(field.file.Data()); }
+
+	/** Writes the recorded steps at regular intervals until the recorder is closed */
+	void RunFlusher()
+	{
+		std::unique_lock<std::mutex> lock(wake_mutex);
+		while (not is_stopping)
+		{
+			wake.wait_for(lock, flush_interval, [this] { return is_stopping; });
+
+			lock.unlock();
+			Flush();
+			lock.lock();
+		}
+	}
+
+	/// Directory of the files
+	std::string directory;
+
+	/// Number of steps the files have room for
+	size_t capacity;
+
+	/// Time between two writes to the disk
+	std::chrono::milliseconds flush_interval;
+
+	/// Files of the fields
+	std::vector<Field> fields{};
+
+	/// Number of steps recorded
+	std::atomic<uint64_t> count{0};
+
+	/// Whether the files are closed
+	bool is_closed = false;
+
+	/// Number of steps written to the disk, guarded by flush_mutex
+	uint64_t flushed = 0;
+	std::mutex flush_mutex{};
+
+	/// Background thread writing to the disk, woken up early to stop
+	std::thread flusher{};
+	std::mutex wake_mutex{};
+	std::condition_variable wake{};
+	bool is_stopping = false;
+};
+
+
+/**
+ * Maps a trajectory file for reading, e.g. to train from a recording,
+ * possibly while it is still being recorded
+ */
+class TrajectoryReader
+{
+public:
+	/**
+	 * (Constructor) Maps a trajectory file
+	 * @throw std::runtime_error if the file cannot be mapped or is not a trajectory file
+	 */
+	explicit TrajectoryReader(const std::string& path) : file(MappedFile::OpenRead(path))
+	{
+		if (file.Size() < sizeof(TrajectoryHeader) or not GetHeader().IsValid())
+			throw std::runtime_error(path + " is not a trajectory file");
+	}
+
+	const TrajectoryHeader& GetHeader() const { return *static_cast<const TrajectoryHeader*>(file.Data()); }
+
+	/** Returns the number of rows written to the disk so far */
+	size_t Size() const { return static_cast<size_t>(GetHeader().count); }
+
+	/**
+	 * Returns a row
+	 * @tparam T float or int32_t, the type of the elements
+	 */
+	template<class T>
+	Span<const T> Get(size_t row) const
+	{
+		const TrajectoryHeader& header = GetHeader();
+		return {reinterpret_cast<const T*>(static_cast<const unsigned char*>(file.Data()) + sizeof(TrajectoryHeader) + row * header.row_size),
+				header.row_size / sizeof(T)};
+	}
+
+	/**
+	 * Returns the rows written so far as a tensor of shape [rows, row shape...]
+	 * @warning The storage is mapped read-only
+	 */
+	TensorView GetTensor() const
+	{
+		const TrajectoryHeader& header = GetHeader();
+
+		TensorView tensor;
+		tensor.data = const_cast<unsigned char*>(static_cast<const unsigned char*>(file.Data()) + sizeof(TrajectoryHeader));
+		tensor.type = header.type;
+		tensor.ndim = header.ndim + 1;
+		tensor.shape[0] = static_cast<int64_t>(header.count);
+		for (int32_t i = 1; i < tensor.ndim; ++i)
+			tensor.shape[i] = header.shape[i - 1];
+
+		int64_t stride = 1;
+		for (int32_t i = tensor.ndim - 1; i >= 0; --i)
+		{
+			tensor.strides[i] = stride;
+			stride *= tensor.shape[i];
+		}
+
+		return tensor;
+	}
+
+private:
+	MappedFile file;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_LEARNING_TRAJECTORY_RECORDER_H
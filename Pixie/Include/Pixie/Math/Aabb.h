@@ -0,0 +1,34 @@
+#ifndef PIXIE_MATH_AABB_H
+#define PIXIE_MATH_AABB_H
+
+#include "Pixie/Math/Vector.h"
+
+namespace pixie
+{
+
+/**
+ * Axis-aligned bounding box
+ */
+struct Aabb
+{
+	Vec3 min{};
+	Vec3 max{};
+
+	/** Returns the smallest box that holds both boxes */
+	static Aabb Union(const Aabb& a, const Aabb& b) { return {Min(a.min, b.min), Max(a.max, b.max)}; }
+
+	/** Returns the center of the box */
+	Vec3 Center() const { return (min + max) * 0.5f; }
+
+	/** Whether two boxes overlap, touching included */
+	static bool Overlap(const Aabb& a, const Aabb& b)
+	{
+		return a.min.x <= b.max.x and b.min.x <= a.max.x and
+			   a.min.y <= b.max.y and b.min.y <= a.max.y and
+			   a.min.z <= b.max.z and b.min.z <= a.max.z;
+	}
+};
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_AABB_H
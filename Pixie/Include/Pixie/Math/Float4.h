@@ -0,0 +1,213 @@
+#ifndef PIXIE_MATH_FLOAT4_H
+#define PIXIE_MATH_FLOAT4_H
+
+#include <cstdint>
+
+// SSE2 is picked at compile time, with a scalar fallback
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXIE_SSE 1
+#include <emmintrin.h>
+#if defined(__FMA__)
+#include <immintrin.h>
+#endif
+#else
+#define PIXIE_SSE 0
+#include <algorithm>
+#endif
+
+namespace pixie
+{
+
+/**
+ * Lane mask of a Float4 comparison
+ */
+struct Mask4
+{
+#if PIXIE_SSE
+	__m128 v;
+#else
+	bool v[4];
+#endif
+
+	/** Returns one bit per lane, lane 0 in the lowest bit */
+	int Bits() const
+	{
+#if PIXIE_SSE
+		return _mm_movemask_ps(v);
+#else
+		return int(v[0]) | int(v[1]) << 1 | int(v[2]) << 2 | int(v[3]) << 3;
+#endif
+	}
+
+	/** Whether any lane is set */
+	bool Any() const { return Bits() != 0; }
+
+	friend Mask4 operator&(const Mask4& a, const Mask4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_and_ps(a.v, b.v)};
+#else
+		return {{a.v[0] and b.v[0], a.v[1] and b.v[1], a.v[2] and b.v[2], a.v[3] and b.v[3]}};
+#endif
+	}
+};
+
+
+/**
+ * Four packed floats, processed in a single instruction where supported
+ */
+struct Float4
+{
+#if PIXIE_SSE
+	__m128 v;
+#else
+	float v[4];
+#endif
+
+	/** Returns all four lanes set to 'value' */
+	static Float4 Broadcast(float value)
+	{
+#if PIXIE_SSE
+		return {_mm_set1_ps(value)};
+#else
+		return {{value, value, value, value}};
+#endif
+	}
+
+	/** Loads four floats (no alignment required) */
+	static Float4 Load(const float* values)
+	{
+#if PIXIE_SSE
+		return {_mm_loadu_ps(values)};
+#else
+		return {{values[0], values[1], values[2], values[3]}};
+#endif
+	}
+
+	/** Stores the four lanes (no alignment required) */
+	void Store(float* values) const
+	{
+#if PIXIE_SSE
+		_mm_storeu_ps(values, v);
+#else
+		for (int i = 0; i < 4; ++i)
+			values[i] = v[i];
+#endif
+	}
+
+	/** Returns the value of a lane */
+	float Lane(int lane) const
+	{
+		float values[4];
+		Store(values);
+		return values[lane];
+	}
+
+	friend Float4 operator+(const Float4& a, const Float4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_add_ps(a.v, b.v)};
+#else
+		return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+#endif
+	}
+
+	friend Float4 operator-(const Float4& a, const Float4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_sub_ps(a.v, b.v)};
+#else
+		return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+#endif
+	}
+
+	friend Float4 operator*(const Float4& a, const Float4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_mul_ps(a.v, b.v)};
+#else
+		return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+#endif
+	}
+
+	/** Lane-wise a <= b */
+	friend Mask4 operator<=(const Float4& a, const Float4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_cmple_ps(a.v, b.v)};
+#else
+		return {{a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3]}};
+#endif
+	}
+
+	/** Lane-wise a < b */
+	friend Mask4 operator<(const Float4& a, const Float4& b)
+	{
+#if PIXIE_SSE
+		return {_mm_cmplt_ps(a.v, b.v)};
+#else
+		return {{a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3]}};
+#endif
+	}
+};
+
+/**
+ * Lane-wise minimum. Like minps, returns b if either lane is NaN
+ */
+inline Float4 Min(const Float4& a, const Float4& b)
+{
+#if PIXIE_SSE
+	return {_mm_min_ps(a.v, b.v)};
+#else
+	Float4 result;
+	for (int i = 0; i < 4; ++i)
+		result.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+	return result;
+#endif
+}
+
+/**
+ * Lane-wise maximum. Like maxps, returns b if either lane is NaN
+ */
+inline Float4 Max(const Float4& a, const Float4& b)
+{
+#if PIXIE_SSE
+	return {_mm_max_ps(a.v, b.v)};
+#else
+	Float4 result;
+	for (int i = 0; i < 4; ++i)
+		result.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+	return result;
+#endif
+}
+
+/**
+ * Lane-wise mask ? a : b
+ */
+inline Float4 Select(const Mask4& mask, const Float4& a, const Float4& b)
+{
+#if PIXIE_SSE
+	return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+#else
+	Float4 result;
+	for (int i = 0; i < 4; ++i)
+		result.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+	return result;
+#endif
+}
+
+/**
+ * Lane-wise a * b + c, fused where FMA is available
+ */
+inline Float4 MulAdd(const Float4& a, const Float4& b, const Float4& c)
+{
+#if PIXIE_SSE && defined(__FMA__)
+	return {_mm_fmadd_ps(a.v, b.v, c.v)};
+#else
+	return a * b + c;
+#endif
+}
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_FLOAT4_H
@@ -0,0 +1,104 @@
+#ifndef PIXIE_MATH_FLOAT8_H
+#define PIXIE_MATH_FLOAT8_H
+
+#include "Pixie/Math/Float4.h"
+
+// AVX2 is picked at compile time (e.g. -mavx2, /arch:AVX2), with two Float4 as fallback
+#if defined(__AVX2__)
+#define PIXIE_AVX2 1
+#include <immintrin.h>
+#else
+#define PIXIE_AVX2 0
+#endif
+
+namespace pixie
+{
+
+/**
+ * Eight packed floats: a single AVX register where supported, otherwise a
+ * pair of Float4
+ */
+struct Float8
+{
+#if PIXIE_AVX2
+	__m256 v;
+#else
+	Float4 low, high;
+#endif
+
+	/** Returns all eight lanes set to 'value' */
+	static Float8 Broadcast(float value)
+	{
+#if PIXIE_AVX2
+		return {_mm256_set1_ps(value)};
+#else
+		return {Float4::Broadcast(value), Float4::Broadcast(value)};
+#endif
+	}
+
+	/** Loads eight floats (no alignment required) */
+	static Float8 Load(const float* values)
+	{
+#if PIXIE_AVX2
+		return {_mm256_loadu_ps(values)};
+#else
+		return {Float4::Load(values), Float4::Load(values + 4)};
+#endif
+	}
+
+	/** Stores the eight lanes (no alignment required) */
+	void Store(float* values) const
+	{
+#if PIXIE_AVX2
+		_mm256_storeu_ps(values, v);
+#else
+		low.Store(values);
+		high.Store(values + 4);
+#endif
+	}
+
+	friend Float8 operator+(const Float8& a, const Float8& b)
+	{
+#if PIXIE_AVX2
+		return {_mm256_add_ps(a.v, b.v)};
+#else
+		return {a.low + b.low, a.high + b.high};
+#endif
+	}
+
+	friend Float8 operator-(const Float8& a, const Float8& b)
+	{
+#if PIXIE_AVX2
+		return {_mm256_sub_ps(a.v, b.v)};
+#else
+		return {a.low - b.low, a.high - b.high};
+#endif
+	}
+
+	friend Float8 operator*(const Float8& a, const Float8& b)
+	{
+#if PIXIE_AVX2
+		return {_mm256_mul_ps(a.v, b.v)};
+#else
+		return {a.low * b.low, a.high * b.high};
+#endif
+	}
+};
+
+/**
+ * Lane-wise a * b + c, fused where FMA is available
+ */
+inline Float8 MulAdd(const Float8& a, const Float8& b, const Float8& c)
+{
+#if PIXIE_AVX2 && defined(__FMA__)
+	return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+#elif PIXIE_AVX2
+	return a * b + c;
+#else
+	return {MulAdd(a.low, b.low, c.low), MulAdd(a.high, b.high, c.high)};
+#endif
+}
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_FLOAT8_H
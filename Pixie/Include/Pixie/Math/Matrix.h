@@ -0,0 +1,154 @@
+#ifndef PIXIE_MATH_MATRIX_H
+#define PIXIE_MATH_MATRIX_H
+
+#include "Pixie/Math/Float4.h"
+#include "Pixie/Math/Quat.h"
+#include "Pixie/Math/Vector.h"
+
+namespace pixie
+{
+
+/**
+ * 3x3 matrix of floats, stored by column
+ */
+struct Mat3
+{
+	Vec3 columns[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+	/** Returns the identity matrix */
+	static constexpr Mat3 Identity() { return {}; }
+
+	/** Returns the rotation matrix of a unit quaternion */
+	static constexpr Mat3 FromQuat(const Quat& q)
+	{
+		const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+		const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+		const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+		return {{{1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)},
+				 {2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)},
+				 {2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)}}};
+	}
+
+	/** Returns the matrix times a vector */
+	constexpr Vec3 operator*(const Vec3& v) const
+	{
+		return columns[0] * v.x + columns[1] * v.y + columns[2] * v.z;
+	}
+
+	/** Returns the matrix that applies 'other' first, then this one */
+	constexpr Mat3 operator*(const Mat3& other) const
+	{
+		return {{*this * other.columns[0], *this * other.columns[1], *this * other.columns[2]}};
+	}
+
+	/** Returns the transposed matrix, i.e. the inverse of a rotation */
+	constexpr Mat3 Transposed() const
+	{
+		return {{{columns[0].x, columns[1].x, columns[2].x},
+				 {columns[0].y, columns[1].y, columns[2].y},
+				 {columns[0].z, columns[1].z, columns[2].z}}};
+	}
+
+	/** Returns the determinant of the matrix */
+	constexpr float Determinant() const { return Dot(columns[0], Cross(columns[1], columns[2])); }
+};
+
+
+/**
+ * 4x4 matrix of floats, stored by column, e.g. an affine transform whose
+ * last column is the translation
+ */
+struct alignas(16) Mat4
+{
+	Vec4 columns[4] = {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}};
+
+	/** Returns the identity matrix */
+	static constexpr Mat4 Identity() { return {}; }
+
+	/** Returns a translation */
+	static constexpr Mat4 Translation(const Vec3& t)
+	{
+		Mat4 result;
+		result.columns[3] = {t.x, t.y, t.z, 1.0f};
+		return result;
+	}
+
+	/** Returns a scale along each axis */
+	static constexpr Mat4 Scale(const Vec3& s)
+	{
+		Mat4 result;
+		result.columns[0].x = s.x;
+		result.columns[1].y = s.y;
+		result.columns[2].z = s.z;
+		return result;
+	}
+
+	/** Returns a scale, then a rotation, then a translation */
+	static constexpr Mat4 Trs(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+	{
+		const Mat3 r = Mat3::FromQuat(rotation);
+
+		Mat4 result;
+		result.columns[0] = {r.columns[0].x * scale.x, r.columns[0].y * scale.x, r.columns[0].z * scale.x, 0.0f};
+		result.columns[1] = {r.columns[1].x * scale.y, r.columns[1].y * scale.y, r.columns[1].z * scale.y, 0.0f};
+		result.columns[2] = {r.columns[2].x * scale.z, r.columns[2].y * scale.z, r.columns[2].z * scale.z, 0.0f};
+		result.columns[3] = {translation.x, translation.y, translation.z, 1.0f};
+		return result;
+	}
+
+	/** Returns the matrix times a vector */
+	Vec4 operator*(const Vec4& v) const
+	{
+		const Float4 result = MulAdd(Column(0), Float4::Broadcast(v.x),
+							  MulAdd(Column(1), Float4::Broadcast(v.y),
+							  MulAdd(Column(2), Float4::Broadcast(v.z),
+									 Column(3) * Float4::Broadcast(v.w))));
+
+		Vec4 out;
+		result.Store(&out.x);
+		return out;
+	}
+
+	/** Returns the matrix that applies 'other' first, then this one */
+	Mat4 operator*(const Mat4& other) const
+	{
+		Mat4 result;
+		for (int i = 0; i < 4; ++i)
+			result.columns[i] = *this * other.columns[i];
+
+		return result;
+	}
+
+	/** Applies the transform to a point */
+	Vec3 TransformPoint(const Vec3& p) const { return (*this * Vec4{p.x, p.y, p.z, 1.0f}).XYZ(); }
+
+	/** Applies the transform to a direction, ignoring the translation */
+	Vec3 TransformVector(const Vec3& v) const { return (*this * Vec4{v.x, v.y, v.z, 0.0f}).XYZ(); }
+
+	/** Returns the translation of an affine transform */
+	constexpr Vec3 GetTranslation() const { return columns[3].XYZ(); }
+
+	/** Returns the transposed matrix */
+	constexpr Mat4 Transposed() const
+	{
+		return {{{columns[0].x, columns[1].x, columns[2].x, columns[3].x},
+				 {columns[0].y, columns[1].y, columns[2].y, columns[3].y},
+				 {columns[0].z, columns[1].z, columns[2].z, columns[3].z},
+				 {columns[0].w, columns[1].w, columns[2].w, columns[3].w}}};
+	}
+
+	/** Returns a column as packed floats */
+	Float4 Column(int index) const { return Float4::Load(&columns[index].x); }
+
+	constexpr bool operator==(const Mat4& other) const
+	{
+		return columns[0] == other.columns[0] and columns[1] == other.columns[1] and
+			   columns[2] == other.columns[2] and columns[3] == other.columns[3];
+	}
+	constexpr bool operator!=(const Mat4& other) const { return not (*this == other); }
+};
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_MATRIX_H
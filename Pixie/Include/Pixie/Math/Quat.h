@@ -0,0 +1,84 @@
+#ifndef PIXIE_MATH_QUAT_H
+#define PIXIE_MATH_QUAT_H
+
+#include <cmath>
+
+#include "Pixie/Math/Vector.h"
+
+namespace pixie
+{
+
+/**
+ * Rotation stored as a unit quaternion x i + y j + z k + w
+ */
+struct alignas(16) Quat
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 1.0f;
+
+	/** Returns the rotation that does nothing */
+	static constexpr Quat Identity() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+
+	/**
+	 * Returns a rotation around an axis
+	 * @param [in] axis Unit axis of rotation
+	 * @param [in] radians Angle, counterclockwise when the axis points at the viewer
+	 */
+	static Quat FromAxisAngle(const Vec3& axis, float radians)
+	{
+		const float half_sin = std::sin(0.5f * radians);
+		return {axis.x * half_sin, axis.y * half_sin, axis.z * half_sin, std::cos(0.5f * radians)};
+	}
+
+	/** Returns the rotation that applies 'other' first, then this one */
+	constexpr Quat operator*(const Quat& other) const
+	{
+		return {w * other.x + x * other.w + y * other.z - z * other.y,
+				w * other.y - x * other.z + y * other.w + z * other.x,
+				w * other.z + x * other.y - y * other.x + z * other.w,
+				w * other.w - x * other.x - y * other.y - z * other.z};
+	}
+
+	constexpr bool operator==(const Quat& other) const { return x == other.x and y == other.y and z == other.z and w == other.w; }
+	constexpr bool operator!=(const Quat& other) const { return not (*this == other); }
+};
+
+/** Returns the dot product of two quaternions */
+constexpr float Dot(const Quat& a, const Quat& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+/** Returns the inverse of a unit quaternion */
+constexpr Quat Conjugate(const Quat& q) { return {-q.x, -q.y, -q.z, q.w}; }
+
+/** Returns the quaternion scaled to a length of 1 */
+inline Quat Normalize(const Quat& q)
+{
+	const float scale = 1.0f / std::sqrt(Dot(q, q));
+	return {q.x * scale, q.y * scale, q.z * scale, q.w * scale};
+}
+
+/** Rotates a vector by a unit quaternion */
+constexpr Vec3 Rotate(const Quat& q, const Vec3& v)
+{
+	// v + 2 w (u x v) + 2 u x (u x v), u being the vector part
+	const Vec3 u{q.x, q.y, q.z};
+	const Vec3 t = Cross(u, v) * 2.0f;
+	return v + t * q.w + Cross(u, t);
+}
+
+/**
+ * Interpolates between two rotations along the shortest path, normalizing
+ * the linear blend. Close to Slerp for nearby rotations and much cheaper
+ */
+inline Quat Nlerp(const Quat& a, const Quat& b, float t)
+{
+	const float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+	const float u = 1.0f - t;
+	const float v = t * sign;
+	return Normalize({a.x * u + b.x * v, a.y * u + b.y * v, a.z * u + b.z * v, a.w * u + b.w * v});
+}
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_QUAT_H
@@ -0,0 +1,96 @@
+#ifndef PIXIE_MATH_TRANSFORM_KERNELS_H
+#define PIXIE_MATH_TRANSFORM_KERNELS_H
+
+#include <cstddef>
+
+#include "Pixie/Math/Float8.h"
+#include "Pixie/Math/Matrix.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Applies a transform to an array of points, one point per Float4
+ * @param [in] transform Affine transform
+ * @param [in] points Points to transform
+ * @param [out] out Transformed points, as many as the inputs. May be the input array
+ */
+inline void TransformPoints(const Mat4& transform, Span<const Vec3> points, Span<Vec3> out)
+{
+	const Float4 c0 = transform.Column(0);
+	const Float4 c1 = transform.Column(1);
+	const Float4 c2 = transform.Column(2);
+	const Float4 c3 = transform.Column(3);
+
+	for (size_t i = 0; i < points.size(); ++i)
+	{
+		const Vec3 p = points[i];
+		const Float4 result = MulAdd(c0, Float4::Broadcast(p.x), MulAdd(c1, Float4::Broadcast(p.y), MulAdd(c2, Float4::Broadcast(p.z), c3)));
+
+		float values[4];
+		result.Store(values);
+		out[i] = {values[0], values[1], values[2]};
+	}
+}
+
+/**
+ * Applies a transform to an array of points stored as one array per
+ * coordinate, eight points per Float8
+ * @param [in] transform Affine transform
+ * @param [in] x, y, z Coordinates of the points, of the same size
+ * @param [out] out_x, out_y, out_z Coordinates of the transformed points. May be the input arrays
+ */
+inline void TransformPoints(const Mat4& transform, Span<const float> x, Span<const float> y, Span<const float> z,
+							Span<float> out_x, Span<float> out_y, Span<float> out_z)
+{
+	const Vec4* m = transform.columns;
+	const Float8 m00 = Float8::Broadcast(m[0].x), m01 = Float8::Broadcast(m[1].x), m02 = Float8::Broadcast(m[2].x), m03 = Float8::Broadcast(m[3].x);
+	const Float8 m10 = Float8::Broadcast(m[0].y), m11 = Float8::Broadcast(m[1].y), m12 = Float8::Broadcast(m[2].y), m13 = Float8::Broadcast(m[3].y);
+	const Float8 m20 = Float8::Broadcast(m[0].z), m21 = Float8::Broadcast(m[1].z), m22 = Float8::Broadcast(m[2].z), m23 = Float8::Broadcast(m[3].z);
+
+	const size_t count = x.size();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const Float8 px = Float8::Load(&x[i]);
+		const Float8 py = Float8::Load(&y[i]);
+		const Float8 pz = Float8::Load(&z[i]);
+
+		MulAdd(m00, px, MulAdd(m01, py, MulAdd(m02, pz, m03))).Store(&out_x[i]);
+		MulAdd(m10, px, MulAdd(m11, py, MulAdd(m12, pz, m13))).Store(&out_y[i]);
+		MulAdd(m20, px, MulAdd(m21, py, MulAdd(m22, pz, m23))).Store(&out_z[i]);
+	}
+
+	for (; i < count; ++i)
+	{
+		const Vec3 p = transform.TransformPoint({x[i], y[i], z[i]});
+		out_x[i] = p.x;
+		out_y[i] = p.y;
+		out_z[i] = p.z;
+	}
+}
+
+/**
+ * Composes two arrays of transforms pairwise: out[i] = parents[i] * locals[i]
+ * @param [out] out Composed transforms. May be either input array
+ */
+inline void ComposeTransforms(Span<const Mat4> parents, Span<const Mat4> locals, Span<Mat4> out)
+{
+	for (size_t i = 0; i < locals.size(); ++i)
+		out[i] = parents[i] * locals[i];
+}
+
+/**
+ * Composes a transform with an array of transforms: out[i] = parent * locals[i]
+ * @param [out] out Composed transforms. May be the input array
+ */
+inline void ComposeTransforms(const Mat4& parent, Span<const Mat4> locals, Span<Mat4> out)
+{
+	for (size_t i = 0; i < locals.size(); ++i)
+		out[i] = parent * locals[i];
+}
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_TRANSFORM_KERNELS_H
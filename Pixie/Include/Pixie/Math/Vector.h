@@ -0,0 +1,125 @@
+#ifndef PIXIE_MATH_VECTOR_H
+#define PIXIE_MATH_VECTOR_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace pixie
+{
+
+/**
+ * Two dimensional vector of floats
+ */
+struct Vec2
+{
+	float x = 0.0f;
+	float y = 0.0f;
+
+	constexpr Vec2 operator+(const Vec2& other) const { return {x + other.x, y + other.y}; }
+	constexpr Vec2 operator-(const Vec2& other) const { return {x - other.x, y - other.y}; }
+	constexpr Vec2 operator*(float scale) const { return {x * scale, y * scale}; }
+	constexpr Vec2 operator-() const { return {-x, -y}; }
+
+	Vec2& operator+=(const Vec2& other) { x += other.x; y += other.y; return *this; }
+	Vec2& operator-=(const Vec2& other) { x -= other.x; y -= other.y; return *this; }
+	Vec2& operator*=(float scale) { x *= scale; y *= scale; return *this; }
+
+	constexpr bool operator==(const Vec2& other) const { return x == other.x and y == other.y; }
+	constexpr bool operator!=(const Vec2& other) const { return not (*this == other); }
+};
+
+/**
+ * Three dimensional vector of floats
+ * @note 2D scenes can use it with z = 0
+ */
+struct Vec3
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+
+	constexpr Vec3 operator+(const Vec3& other) const { return {x + other.x, y + other.y, z + other.z}; }
+	constexpr Vec3 operator-(const Vec3& other) const { return {x - other.x, y - other.y, z - other.z}; }
+	constexpr Vec3 operator*(float scale) const { return {x * scale, y * scale, z * scale}; }
+	constexpr Vec3 operator-() const { return {-x, -y, -z}; }
+
+	Vec3& operator+=(const Vec3& other) { x += other.x; y += other.y; z += other.z; return *this; }
+	Vec3& operator-=(const Vec3& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+	Vec3& operator*=(float scale) { x *= scale; y *= scale; z *= scale; return *this; }
+
+	constexpr bool operator==(const Vec3& other) const { return x == other.x and y == other.y and z == other.z; }
+	constexpr bool operator!=(const Vec3& other) const { return not (*this == other); }
+};
+
+/**
+ * Four dimensional vector of floats, e.g. homogeneous coordinates or a
+ * column of a Mat4
+ */
+struct alignas(16) Vec4
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 0.0f;
+
+	constexpr Vec4 operator+(const Vec4& other) const { return {x + other.x, y + other.y, z + other.z, w + other.w}; }
+	constexpr Vec4 operator-(const Vec4& other) const { return {x - other.x, y - other.y, z - other.z, w - other.w}; }
+	constexpr Vec4 operator*(float scale) const { return {x * scale, y * scale, z * scale, w * scale}; }
+	constexpr Vec4 operator-() const { return {-x, -y, -z, -w}; }
+
+	constexpr bool operator==(const Vec4& other) const { return x == other.x and y == other.y and z == other.z and w == other.w; }
+	constexpr bool operator!=(const Vec4& other) const { return not (*this == other); }
+
+	/** Returns the first three components */
+	constexpr Vec3 XYZ() const { return {x, y, z}; }
+};
+
+/** Returns the dot product of two vectors */
+constexpr float Dot(const Vec2& a, const Vec2& b) { return a.x * b.x + a.y * b.y; }
+
+/** Returns the z component of the cross product of two vectors of the xy plane */
+constexpr float Cross(const Vec2& a, const Vec2& b) { return a.x * b.y - a.y * b.x; }
+
+/** Returns the squared length of a vector */
+constexpr float LengthSquared(const Vec2& v) { return Dot(v, v); }
+
+/** Returns the length of a vector */
+inline float Length(const Vec2& v) { return std::sqrt(LengthSquared(v)); }
+
+/** Returns the dot product of two vectors */
+constexpr float Dot(const Vec4& a, const Vec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+/** Returns the dot product of two vectors */
+constexpr float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+/** Returns the cross product of two vectors */
+constexpr Vec3 Cross(const Vec3& a, const Vec3& b)
+{
+	return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+/** Returns the squared length of a vector */
+constexpr float LengthSquared(const Vec3& v) { return Dot(v, v); }
+
+/** Returns the length of a vector */
+inline float Length(const Vec3& v) { return std::sqrt(LengthSquared(v)); }
+
+/** Returns the squared distance between two points */
+constexpr float DistanceSquared(const Vec3& a, const Vec3& b) { return LengthSquared(a - b); }
+
+/** Returns the component-wise minimum of two vectors */
+inline Vec3 Min(const Vec3& a, const Vec3& b) { return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)}; }
+
+/** Returns the vector scaled to a length of 1, or the input if it has no length */
+inline Vec3 Normalize(const Vec3& v)
+{
+	const float length = Length(v);
+	return length > 0.0f ? v * (1.0f / length) : v;
+}
+
+/** Returns the component-wise maximum of two vectors */
+inline Vec3 Max(const Vec3& a, const Vec3& b) { return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)}; }
+
+} // namespace pixie
+
+#endif //PIXIE_MATH_VECTOR_H
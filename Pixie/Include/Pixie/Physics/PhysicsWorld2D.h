@@ -0,0 +1,563 @@
+#ifndef PIXIE_PHYSICS_PHYSICS_WORLD_2D_H
+#define PIXIE_PHYSICS_PHYSICS_WORLD_2D_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Pixie/Core/Engine/WorkerPool.h"
+#include "Pixie/Math/Float4.h"
+#include "Pixie/Math/Vector.h"
+
+namespace pixie
+{
+
+/**
+ * Initial state of a 2D rigid body, a disk in the xy plane
+ */
+struct BodyDesc2D
+{
+	/// Center of the body, z is ignored
+	Vec3 position{};
+
+	/// Rotation around z, in radians
+	float angle = 0.0f;
+
+	/// Linear velocity, z is ignored
+	Vec3 velocity{};
+
+	/// Rotation speed around z, in radians per second
+	float angular_velocity = 0.0f;
+
+	/// Mass of the body, 0 for a static body. Static bodies still move by their velocity
+	float mass = 1.0f;
+
+	/// Radius of the disk
+	float radius = 0.5f;
+
+	/// Scale of the gravity applied to the body
+	float gravity_scale = 1.0f;
+};
+
+/**
+ * Settings shared by all the bodies of a physics world
+ */
+struct PhysicsSettings2D
+{
+	/// Acceleration applied to every dynamic body, z is ignored
+	Vec3 gravity{0.0f, -9.81f, 0.0f};
+
+	/// Number of substeps per time step
+	uint32_t substeps = 4;
+
+	/// Number of velocity iterations over the contacts per substep
+	uint32_t iterations = 8;
+
+	/// Bounciness of the contacts, from 0 (inelastic) to 1 (elastic)
+	float restitution = 0.2f;
+
+	/// Coulomb friction coefficient of the contacts
+	float friction = 0.4f;
+};
+
+
+/**
+ * 2D rigid-body dynamics of disks, stepped once per frame by the scene
+ * between the Tick of its objects and the Tick of its game manager.
+ *
+ * The state of the bodies is stored as structure of arrays and integrated
+ * four bodies at a time. Each time step is split into substeps; every
+ * substep integrates the velocities, finds the contacts with a sweep along
+ * x, groups the bodies in touch into islands and solves the islands
+ * independently, split across the workers, before integrating the
+ * positions. The results do not depend on the number of workers.
+ *
+ * @code
+ * auto* physics = ObjectInitializer::GetPhysics();
+ * body = physics->AddBody({{0.0f, 10.0f, 0.0f}});   // e.g. in Begin
+ * physics->ApplyForce(body, {0.0f, 20.0f, 0.0f});    // in Tick, for this frame
+ * @endcode
+ */
+class PhysicsWorld2D
+{
+public:
+	/// Marks an invalid body
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/// Number of bodies from which the islands are solved across the workers
+	static constexpr size_t parallel_body_count = 256;
+
+	/**
+	 * Adds a body
+	 * @return Identifier of the body, reused once it is removed
+	 */
+	uint32_t AddBody(const BodyDesc2D& desc)
+	{
+		uint32_t body;
+		if (free_bodies.empty())
+		{
+			body = static_cast<uint32_t>(x.size());
+			for (auto* column : {&x, &y, &angle, &vx, &vy, &w, &fx, &fy, &torque, &inv_mass, &inv_inertia, &radius, &gravity_scale})
+				column->push_back(0.0f);
+			is_live.push_back(false);
+		}
+		else
+		{
+			body = free_bodies.back();
+			free_bodies.pop_back();
+		}
+
+		x[body] = desc.position.x;
+		y[body] = desc.position.y;
+		angle[body] = desc.angle;
+		vx[body] = desc.velocity.x;
+		vy[body] = desc.velocity.y;
+		w[body] = desc.angular_velocity;
+		radius[body] = desc.radius;
+
+		const bool is_dynamic = desc.mass > 0.0f;
+		inv_mass[body] = is_dynamic ? 1.0f / desc.mass : 0.0f;
+		inv_inertia[body] = is_dynamic and desc.radius > 0.0f ? 2.0f / (desc.mass * desc.radius * desc.radius) : 0.0f;
+		gravity_scale[body] = is_dynamic ? desc.gravity_scale : 0.0f;
+
+		is_live[body] = true;
+		is_order_dirty = true;
+		++body_count;
+
+		return body;
+	}
+
+	/**
+	 * Removes a body
+	 * @return True if the body was live; otherwise false
+	 */
+	bool RemoveBody(uint32_t body)
+	{
+		if (body >= is_live.size() or not is_live[body])
+			return false;
+
+		// A removed body stays in the arrays as a still, massless one
+		for (auto* column : {&vx, &vy, &w, &fx, &fy, &torque, &inv_mass, &inv_inertia, &gravity_scale})
+			(*column)[body] = 0.0f;
+
+		is_live[body] = false;
+		is_order_dirty = true;
+		free_bodies.push_back(body);
+		--body_count;
+
+		return true;
+	}
+
+	/** Returns the number of live bodies */
+	size_t Size() const { return body_count; }
+
+	Vec3 GetPosition(uint32_t body) const { return {x[body], y[body], 0.0f}; }
+	Vec3 GetVelocity(uint32_t body) const { return {vx[body], vy[body], 0.0f}; }
+	float GetAngle(uint32_t body) const { return angle[body]; }
+	float GetAngularVelocity(uint32_t body) const { return w[body]; }
+
+	void SetPosition(uint32_t body, const Vec3& position) { x[body] = position.x; y[body] = position.y; }
+	void SetVelocity(uint32_t body, const Vec3& velocity) { vx[body] = velocity.x; vy[body] = velocity.y; }
+	void SetAngularVelocity(uint32_t body, float velocity) { w[body] = velocity; }
+
+	/** Applies a force at the center of a body for the next step */
+	void ApplyForce(uint32_t body, const Vec3& force)
+	{
+		fx[body] += force.x;
+		fy[body] += force.y;
+	}
+
+	/** Applies a torque to a body for the next step */
+	void ApplyTorque(uint32_t body, float value) { torque[body] += value; }
+
+	/** Changes the velocity of a body at once */
+	void ApplyImpulse(uint32_t body, const Vec3& impulse)
+	{
+		vx[body] += impulse.x * inv_mass[body];
+		vy[body] += impulse.y * inv_mass[body];
+	}
+
+	PhysicsSettings2D& GetSettings() { return settings; }
+	const PhysicsSettings2D& GetSettings() const { return settings; }
+
+	/**
+	 * Sets the time a step advances by
+	 * @note Set by the engine to the fixed time step of its clock every frame
+	 */
+	void SetTimeStep(float seconds) { time_step = seconds; }
+	float GetTimeStep() const { return time_step; }
+
+	/**
+	 * Sets the workers that the islands are solved across, or nullptr to
+	 * step on the calling thread only
+	 * @note Set by the engine once there are parallel_body_count bodies
+	 */
+	void SetWorkers(WorkerPool* in_workers) { workers = in_workers; }
+	WorkerPool* GetWorkers() const { return workers; }
+
+	/** Returns the number of islands solved in the last substep */
+	size_t IslandCount() const { return island_count; }
+
+	/** Returns the number of contacts found in the last substep */
+	size_t ContactCount() const { return contacts.size(); }
+
+	/**
+	 * Advances every body by the time step, then clears the forces
+	 */
+	void Step()
+	{
+		if (body_count > 0 and time_step > 0.0f)
+		{
+			const uint32_t substeps = std::max<uint32_t>(settings.substeps, 1);
+			const float dt = time_step / static_cast<float>(substeps);
+
+			for (uint32_t substep = 0; substep < substeps; ++substep)
+			{
+				IntegrateVelocities(dt);
+				FindContacts(dt);
+				BuildIslands();
+				SolveIslands();
+				IntegratePositions(dt);
+			}
+		}
+
+		std::fill(fx.begin(), fx.end(), 0.0f);
+		std::fill(fy.begin(), fy.end(), 0.0f);
+		std::fill(torque.begin(), torque.end(), 0.0f);
+	}
+
+private:
+	struct Contact
+	{
+		uint32_t a, b;
+
+		/// Normal from a to b
+		float nx, ny;
+
+		/// Target separating speed along the normal: bounce and penetration recovery
+		float bias;
+
+		/// Impulses accumulated over the iterations
+		float normal_impulse, tangent_impulse;
+	};
+
+	/// Fraction of the penetration recovered per substep
+	static constexpr float position_correction = 0.2f;
+
+	/// Penetration left uncorrected to keep resting contacts stable
+	static constexpr float penetration_slop = 0.005f;
+
+	/// Closing speed below which contacts do not bounce
+	static constexpr float bounce_threshold = 0.5f;
+
+	/** v += (gravity + force / m) * dt, w += torque / I * dt */
+	void IntegrateVelocities(float dt)
+	{
+		const Float4 step = Float4::Broadcast(dt);
+		const Float4 gravity_x = Float4::Broadcast(settings.gravity.x * dt);
+		const Float4 gravity_y = Float4::Broadcast(settings.gravity.y * dt);
+
+		const size_t count = x.size();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const Float4 im = Float4::Load(&inv_mass[i]);
+			const Float4 scale = Float4::Load(&gravity_scale[i]);
+
+			(Float4::Load(&vx[i]) + gravity_x * scale + Float4::Load(&fx[i]) * im * step).Store(&vx[i]);
+			(Float4::Load(&vy[i]) + gravity_y * scale + Float4::Load(&fy[i]) * im * step).Store(&vy[i]);
+			(Float4::Load(&w[i]) + Float4::Load(&torque[i]) * Float4::Load(&inv_inertia[i]) * step).Store(&w[i]);
+		}
+
+		for (; i < count; ++i)
+		{
+			vx[i] += settings.gravity.x * dt * gravity_scale[i] + fx[i] * inv_mass[i] * dt;
+			vy[i] += settings.gravity.y * dt * gravity_scale[i] + fy[i] * inv_mass[i] * dt;
+			w[i] += torque[i] * inv_inertia[i] * dt;
+		}
+	}
+
+	/** p += v * dt, angle += w * dt */
+	void IntegratePositions(float dt)
+	{
+		const Float4 step = Float4::Broadcast(dt);
+
+		const size_t count = x.size();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			(Float4::Load(&x[i]) + Float4::Load(&vx[i]) * step).Store(&x[i]);
+			(Float4::Load(&y[i]) + Float4::Load(&vy[i]) * step).Store(&y[i]);
+			(Float4::Load(&angle[i]) + Float4::Load(&w[i]) * step).Store(&angle[i]);
+		}
+
+		for (; i < count; ++i)
+		{
+			x[i] += vx[i] * dt;
+			y[i] += vy[i] * dt;
+			angle[i] += w[i] * dt;
+		}
+	}
+
+	/**
+	 * Sorts the bodies by their left edge, by insertion sort since they
+	 * barely move between two substeps, then sweeps them for touching disks
+	 */
+	void FindContacts(float dt)
+	{
+		if (is_order_dirty)
+		{
+			sweep_order.clear();
+			for (uint32_t body = 0; body < is_live.size(); ++body)
+				if (is_live[body])
+					sweep_order.push_back(body);
+
+			is_order_dirty = false;
+		}
+
+		auto left = [this](uint32_t body) { return x[body] - radius[body]; };
+
+		for (size_t i = 1; i < sweep_order.size(); ++i)
+		{
+			const uint32_t body = sweep_order[i];
+			const float edge = left(body);
+
+			size_t j = i;
+			for (; j > 0 and edge < left(sweep_order[j - 1]); --j)
+				sweep_order[j] = sweep_order[j - 1];
+
+			sweep_order[j] = body;
+		}
+
+		contacts.clear();
+		for (size_t i = 0; i < sweep_order.size(); ++i)
+		{
+			const uint32_t a = sweep_order[i];
+			const float right = x[a] + radius[a];
+
+			for (size_t j = i + 1; j < sweep_order.size() and left(sweep_order[j]) <= right; ++j)
+			{
+				const uint32_t b = sweep_order[j];
+				if (inv_mass[a] == 0.0f and inv_mass[b] == 0.0f)
+					continue;
+
+				const float dx = x[b] - x[a];
+				const float dy = y[b] - y[a];
+				const float reach = radius[a] + radius[b];
+				const float distance_squared = dx * dx + dy * dy;
+				if (distance_squared >= reach * reach)
+					continue;
+
+				const float distance = std::sqrt(distance_squared);
+				Contact contact{a, b, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+				if (distance > 0.0f)
+				{
+					contact.nx = dx / distance;
+					contact.ny = dy / distance;
+				}
+
+				// Closing speed is unaffected by spin since disks touch along the normal
+				const float closing = (vx[b] - vx[a]) * contact.nx + (vy[b] - vy[a]) * contact.ny;
+				const float bounce = closing < -bounce_threshold ? -settings.restitution * closing : 0.0f;
+				const float recovery = position_correction / dt * std::max(reach - distance - penetration_slop, 0.0f);
+				contact.bias = std::max(bounce, recovery);
+
+				contacts.push_back(contact);
+			}
+		}
+	}
+
+	/** Returns the root of the island of a body, halving the path on the way */
+	uint32_t FindIsland(uint32_t body)
+	{
+		while (island_parent[body] != body)
+		{
+			island_parent[body] = island_parent[island_parent[body]];
+			body = island_parent[body];
+		}
+
+		return body;
+	}
+
+	/**
+	 * Groups the contacts by island: dynamic bodies in touch, directly or
+	 * not. Static bodies belong to no island, so that the islands only
+	 * write to their own bodies
+	 */
+	void BuildIslands()
+	{
+		island_parent.resize(x.size());
+		for (uint32_t body = 0; body < island_parent.size(); ++body)
+			island_parent[body] = body;
+
+		for (const auto& contact : contacts)
+		{
+			if (inv_mass[contact.a] > 0.0f and inv_mass[contact.b] > 0.0f)
+			{
+				const uint32_t a = FindIsland(contact.a);
+				const uint32_t b = FindIsland(contact.b);
+				island_parent[std::max(a, b)] = std::min(a, b);
+			}
+		}
+
+		// Number the islands in order of their first contact, then sort the contacts by island
+		island_index.assign(x.size(), npos);
+		island_offsets.assign(1, 0);
+		contact_islands.resize(contacts.size());
+		for (size_t i = 0; i < contacts.size(); ++i)
+		{
+			const uint32_t root = FindIsland(inv_mass[contacts[i].a] > 0.0f ? contacts[i].a : contacts[i].b);
+			if (island_index[root] == npos)
+			{
+				island_index[root] = static_cast<uint32_t>(island_offsets.size() - 1);
+				island_offsets.push_back(0);
+			}
+
+			contact_islands[i] = island_index[root];
+			++island_offsets[contact_islands[i] + 1];
+		}
+
+		island_count = island_offsets.size() - 1;
+		for (size_t island = 0; island < island_count; ++island)
+			island_offsets[island + 1] += island_offsets[island];
+
+		island_contacts.resize(contacts.size());
+		island_fill.assign(island_offsets.begin(), island_offsets.end() - 1);
+		for (uint32_t i = 0; i < contacts.size(); ++i)
+			island_contacts[island_fill[contact_islands[i]]++] = i;
+	}
+
+	/** Solves every island, across the workers if there are enough bodies */
+	void SolveIslands()
+	{
+		auto solve = [this](size_t begin, size_t end)
+		{
+			for (size_t island = begin; island < end; ++island)
+				SolveIsland(island);
+		};
+
+		if (workers and island_count > 1 and body_count >= parallel_body_count)
+			workers->ParallelFor(island_count, std::max<size_t>(island_count / (4 * workers->Size()), 1), solve);
+		else
+			solve(0, island_count);
+	}
+
+	/**
+	 * Sequential impulses over the contacts of an island: a non-negative
+	 * impulse along the normal, and a friction impulse along the tangent
+	 * bounded by the normal one
+	 */
+	void SolveIsland(size_t island)
+	{
+		for (uint32_t iteration = 0; iteration < settings.iterations; ++iteration)
+		{
+			for (uint32_t i = island_offsets[island]; i < island_offsets[island + 1]; ++i)
+			{
+				Contact& contact = contacts[island_contacts[i]];
+				const uint32_t a = contact.a;
+				const uint32_t b = contact.b;
+
+				// Contact point relative to each center
+				const float ra_x = contact.nx * radius[a], ra_y = contact.ny * radius[a];
+				const float rb_x = -contact.nx * radius[b], rb_y = -contact.ny * radius[b];
+
+				auto relative_velocity = [&](float& rvx, float& rvy)
+				{
+					rvx = (vx[b] - w[b] * rb_y) - (vx[a] - w[a] * ra_y);
+					rvy = (vy[b] + w[b] * rb_x) - (vy[a] + w[a] * ra_x);
+				};
+
+				auto apply = [&](float px, float py)
+				{
+					if (inv_mass[a] > 0.0f)
+					{
+						vx[a] -= px * inv_mass[a];
+						vy[a] -= py * inv_mass[a];
+						w[a] -= inv_inertia[a] * (ra_x * py - ra_y * px);
+					}
+					if (inv_mass[b] > 0.0f)
+					{
+						vx[b] += px * inv_mass[b];
+						vy[b] += py * inv_mass[b];
+						w[b] += inv_inertia[b] * (rb_x * py - rb_y * px);
+					}
+				};
+
+				float rvx, rvy;
+				relative_velocity(rvx, rvy);
+
+				// Normal
+				const float normal_mass = inv_mass[a] + inv_mass[b];
+				const float closing = rvx * contact.nx + rvy * contact.ny;
+				const float accumulated = std::max(contact.normal_impulse + (contact.bias - closing) / normal_mass, 0.0f);
+				const float normal = accumulated - contact.normal_impulse;
+				contact.normal_impulse = accumulated;
+				apply(normal * contact.nx, normal * contact.ny);
+
+				// Friction
+				relative_velocity(rvx, rvy);
+				const float tx = -contact.ny, ty = contact.nx;
+				const float ra_t = ra_x * ty - ra_y * tx;
+				const float rb_t = rb_x * ty - rb_y * tx;
+				const float tangent_mass = normal_mass + inv_inertia[a] * ra_t * ra_t + inv_inertia[b] * rb_t * rb_t;
+
+				const float limit = settings.friction * contact.normal_impulse;
+				const float sliding = std::min(std::max(contact.tangent_impulse - (rvx * tx + rvy * ty) / tangent_mass, -limit), limit);
+				const float tangent = sliding - contact.tangent_impulse;
+				contact.tangent_impulse = sliding;
+				apply(tangent * tx, tangent * ty);
+			}
+		}
+	}
+
+	/// State of each body
+	std::vector<float> x{}, y{}, angle{};
+	std::vector<float> vx{}, vy{}, w{};
+
+	/// Forces applied for the next step
+	std::vector<float> fx{}, fy{}, torque{};
+
+	/// Shape and mass of each body, inverse masses are 0 for static bodies
+	std::vector<float> inv_mass{}, inv_inertia{}, radius{}, gravity_scale{};
+
+	/// Whether each body is live
+	std::vector<bool> is_live{};
+
+	/// Number of live bodies
+	size_t body_count = 0;
+
+	/// Bodies that can be reused
+	std::vector<uint32_t> free_bodies{};
+
+	/// Live bodies sorted by their left edge, and whether bodies were added or removed since
+	std::vector<uint32_t> sweep_order{};
+	bool is_order_dirty = false;
+
+	/// Contacts of the current substep
+	std::vector<Contact> contacts{};
+
+	/// Island building state: union-find parents, island of each root and of each contact
+	std::vector<uint32_t> island_parent{};
+	std::vector<uint32_t> island_index{};
+	std::vector<uint32_t> contact_islands{};
+	std::vector<uint32_t> island_fill{};
+
+	/// Island -> first of its contacts in island_contacts, plus one past the last
+	std::vector<uint32_t> island_offsets{};
+	std::vector<uint32_t> island_contacts{};
+	size_t island_count = 0;
+
+	PhysicsSettings2D settings{};
+
+	/// Time a step advances by
+	float time_step = 1.0f / 60.0f;
+
+	/// Workers the islands are solved across
+	WorkerPool* workers = nullptr;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_PHYSICS_PHYSICS_WORLD_2D_H
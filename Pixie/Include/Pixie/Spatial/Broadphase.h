@@ -0,0 +1,286 @@
+#ifndef PIXIE_SPATIAL_BROADPHASE_H
+#define PIXIE_SPATIAL_BROADPHASE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "Pixie/Math/Aabb.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Two proxies whose bounds overlap, the lowest identifier first
+ */
+struct OverlapPair
+{
+	uint32_t a = 0;
+	uint32_t b = 0;
+
+	bool operator==(const OverlapPair& other) const { return a == other.a and b == other.b; }
+};
+
+/**
+ * Event emitted by the scene when two proxies of its broadphase start overlapping
+ */
+struct OverlapBegin
+{
+	OverlapPair pair{};
+};
+
+/**
+ * Event emitted by the scene when two proxies of its broadphase stop
+ * overlapping, or when one of them is removed
+ */
+struct OverlapEnd
+{
+	OverlapPair pair{};
+};
+
+
+/**
+ * Broadphase collision detection by incremental sweep and prune.
+ *
+ * Bounds are stored as structure of arrays. The x endpoints of every proxy
+ * stay sorted from one commit to the next and are re-sorted by insertion
+ * sort, which is close to linear since bodies barely move between two
+ * frames. A sweep along the sorted endpoints then finds the overlapping
+ * pairs, and the difference with the previous commit gives the pairs that
+ * began and ended overlapping.
+ *
+ * Changes are staged and applied by Commit, which the scene calls at the end
+ * of Begin and of Tick before emitting OverlapBegin and OverlapEnd events.
+ *
+ * @code
+ * auto* broadphase = ObjectInitializer::GetBroadphase();
+ * proxy = broadphase->Insert(bounds);          // e.g. in Begin
+ * broadphase->SetBounds(proxy, bounds);        // every Tick
+ *
+ * Core::Subscribe<OverlapBegin>([](Span<const OverlapBegin> events) { ... });
+ * @endcode
+ */
+class Broadphase
+{
+public:
+	/// Marks an invalid proxy
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * Adds a proxy, found overlapping from the next commit on
+	 * @return Identifier of the proxy, reused once it is removed and committed
+	 */
+	uint32_t Insert(const Aabb& bounds)
+	{
+		uint32_t proxy;
+		if (free_proxies.empty())
+		{
+			proxy = static_cast<uint32_t>(min_x.size());
+			min_x.push_back(0.0f); max_x.push_back(0.0f);
+			min_y.push_back(0.0f); max_y.push_back(0.0f);
+			min_z.push_back(0.0f); max_z.push_back(0.0f);
+			is_live.push_back(false);
+		}
+		else
+		{
+			proxy = free_proxies.back();
+			free_proxies.pop_back();
+		}
+
+		is_live[proxy] = true;
+		SetBounds(proxy, bounds);
+		endpoints.push_back({min_x[proxy], proxy << 1});
+		endpoints.push_back({max_x[proxy], proxy << 1 | 1u});
+		++proxy_count;
+
+		return proxy;
+	}
+
+	/**
+	 * Sets the bounds of a proxy
+	 * @note Applied by the next Commit
+	 */
+	void SetBounds(uint32_t proxy, const Aabb& bounds)
+	{
+		min_x[proxy] = bounds.min.x; max_x[proxy] = bounds.max.x;
+		min_y[proxy] = bounds.min.y; max_y[proxy] = bounds.max.y;
+		min_z[proxy] = bounds.min.z; max_z[proxy] = bounds.max.z;
+	}
+
+	/** Returns the bounds of a proxy */
+	Aabb GetBounds(uint32_t proxy) const
+	{
+		return {{min_x[proxy], min_y[proxy], min_z[proxy]}, {max_x[proxy], max_y[proxy], max_z[proxy]}};
+	}
+
+	/**
+	 * Removes a proxy. Its overlaps end on the next commit
+	 * @return True if the proxy was live; otherwise false
+	 */
+	bool Remove(uint32_t proxy)
+	{
+		if (proxy >= is_live.size() or not is_live[proxy])
+			return false;
+
+		is_live[proxy] = false;
+		removed_proxies.push_back(proxy);
+		--proxy_count;
+
+		return true;
+	}
+
+	/** Returns the number of live proxies */
+	size_t Size() const { return proxy_count; }
+
+	/**
+	 * Applies the staged changes and finds the overlapping pairs
+	 */
+	void Commit()
+	{
+		if (not removed_proxies.empty())
+		{
+			endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+										   [this](const Endpoint& endpoint) { return not is_live[endpoint.owner >> 1]; }),
+							endpoints.end());
+		}
+
+		// Refresh the endpoints from the bounds, then restore their order
+		for (auto& endpoint : endpoints)
+			endpoint.value = endpoint.owner & 1u ? max_x[endpoint.owner >> 1] : min_x[endpoint.owner >> 1];
+
+		for (size_t i = 1; i < endpoints.size(); ++i)
+		{
+			const Endpoint endpoint = endpoints[i];
+
+			size_t j = i;
+			for (; j > 0 and endpoint < endpoints[j - 1]; --j)
+				endpoints[j] = endpoints[j - 1];
+
+			endpoints[j] = endpoint;
+		}
+
+		previous_pairs.swap(pairs);
+		Sweep();
+
+		began.clear();
+		ended.clear();
+		std::set_difference(pairs.begin(), pairs.end(), previous_pairs.begin(), previous_pairs.end(), std::back_inserter(began));
+		std::set_difference(previous_pairs.begin(), previous_pairs.end(), pairs.begin(), pairs.end(), std::back_inserter(ended));
+
+		// Identifiers are reused only once the end of their overlaps is reported
+		free_proxies.insert(free_proxies.end(), removed_proxies.begin(), removed_proxies.end());
+		removed_proxies.clear();
+	}
+
+	/** Returns the pairs that overlap as of the last commit, sorted */
+	Span<const uint64_t> Pairs() const { return Span<const uint64_t>(pairs); }
+
+	/** Returns the pairs that started overlapping at the last commit, sorted */
+	Span<const uint64_t> Began() const { return Span<const uint64_t>(began); }
+
+	/** Returns the pairs that stopped overlapping at the last commit, sorted */
+	Span<const uint64_t> Ended() const { return Span<const uint64_t>(ended); }
+
+	/** Encodes a pair as a sortable key, the lowest identifier in the high bits */
+	static uint64_t ToKey(uint32_t a, uint32_t b)
+	{
+		return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+	}
+
+	/** Decodes a pair key */
+	static OverlapPair ToPair(uint64_t key)
+	{
+		return {static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)};
+	}
+
+private:
+	struct Endpoint
+	{
+		/// Position on the x axis
+		float value;
+
+		/// Proxy << 1, plus 1 for a max endpoint
+		uint32_t owner;
+
+		/** Ordered by position, min endpoints first so that touching bounds overlap */
+		bool operator<(const Endpoint& other) const
+		{
+			return value < other.value or (value == other.value and (owner & 1u) < (other.owner & 1u));
+		}
+	};
+
+	/**
+	 * Walks the sorted endpoints, keeping the proxies whose x interval is
+	 * open, and tests the y and z intervals of every proxy entering it
+	 */
+	void Sweep()
+	{
+		pairs.clear();
+		active.clear();
+		active_slots.resize(min_x.size());
+
+		for (const auto& endpoint : endpoints)
+		{
+			const uint32_t proxy = endpoint.owner >> 1;
+
+			if (endpoint.owner & 1u)
+			{
+				// Swap and pop out of the active proxies
+				const uint32_t slot = active_slots[proxy];
+				active[slot] = active.back();
+				active_slots[active[slot]] = slot;
+				active.pop_back();
+				continue;
+			}
+
+			for (uint32_t other : active)
+			{
+				if (min_y[proxy] <= max_y[other] and min_y[other] <= max_y[proxy] and
+					min_z[proxy] <= max_z[other] and min_z[other] <= max_z[proxy])
+					pairs.push_back(ToKey(proxy, other));
+			}
+
+			active_slots[proxy] = static_cast<uint32_t>(active.size());
+			active.push_back(proxy);
+		}
+
+		std::sort(pairs.begin(), pairs.end());
+	}
+
+	/// Bounds of each proxy
+	std::vector<float> min_x{}, max_x{};
+	std::vector<float> min_y{}, max_y{};
+	std::vector<float> min_z{}, max_z{};
+
+	/// Whether each proxy is live
+	std::vector<bool> is_live{};
+
+	/// Number of live proxies
+	size_t proxy_count = 0;
+
+	/// Proxies that can be reused
+	std::vector<uint32_t> free_proxies{};
+
+	/// Proxies removed since the last commit
+	std::vector<uint32_t> removed_proxies{};
+
+	/// Min and max x of every proxy, sorted as of the last commit
+	std::vector<Endpoint> endpoints{};
+
+	/// Sweep state: proxies whose x interval is open, and their index in it
+	std::vector<uint32_t> active{};
+	std::vector<uint32_t> active_slots{};
+
+	/// Pair keys of the last and previous commits, and their differences
+	std::vector<uint64_t> pairs{};
+	std::vector<uint64_t> previous_pairs{};
+	std::vector<uint64_t> began{};
+	std::vector<uint64_t> ended{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_SPATIAL_BROADPHASE_H
@@ -0,0 +1,298 @@
+#ifndef PIXIE_SPATIAL_BVH_H
+#define PIXIE_SPATIAL_BVH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Pixie/Math/Aabb.h"
+#include "Pixie/Math/Float4.h"
+#include "Pixie/Math/Vector.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Ray with a finite range
+ */
+struct Ray
+{
+	/// Start point
+	Vec3 origin{};
+
+	/// Direction, not necessarily normalized. Distances are in its units
+	Vec3 direction{};
+
+	/// Farthest distance the ray reaches
+	float max_distance = std::numeric_limits<float>::max();
+};
+
+
+/**
+ * Four rays traced together, one per SIMD lane
+ */
+struct RayPacket
+{
+	/// Origin of each ray
+	Float4 ox, oy, oz;
+
+	/// Inverse direction of each ray
+	Float4 ix, iy, iz;
+
+	/// Closest hit so far (or max distance) of each ray. Negative for unused lanes
+	Float4 t;
+
+	/// Primitive hit by each ray, npos if none
+	uint32_t hit[4];
+
+	/**
+	 * Intersects the four rays with a box
+	 * @param [out] entry Distance at which each ray enters the box
+	 * @return The lanes whose ray enters the box before its closest hit
+	 */
+	Mask4 Intersect(const Aabb& box, Float4& entry) const
+	{
+		const Float4 x1 = (Float4::Broadcast(box.min.x) - ox) * ix;
+		const Float4 x2 = (Float4::Broadcast(box.max.x) - ox) * ix;
+		const Float4 y1 = (Float4::Broadcast(box.min.y) - oy) * iy;
+		const Float4 y2 = (Float4::Broadcast(box.max.y) - oy) * iy;
+		const Float4 z1 = (Float4::Broadcast(box.min.z) - oz) * iz;
+		const Float4 z2 = (Float4::Broadcast(box.max.z) - oz) * iz;
+
+		const Float4 t_enter = Max(Max(Min(x1, x2), Min(y1, y2)), Max(Min(z1, z2), Float4::Broadcast(0.0f)));
+		const Float4 t_exit = Min(Min(Max(x1, x2), Max(y1, y2)), Min(Max(z1, z2), t));
+
+		entry = t_enter;
+		return t_enter <= t_exit;
+	}
+};
+
+
+/**
+ * Bounding volume hierarchy over axis-aligned boxes, traced by packets of
+ * four rays at a time.
+ *
+ * Built top-down by splitting the boxes at the median of their centers
+ * along the widest axis. When the boxes move without being added or
+ * removed, Refit updates the bounds of the nodes in a single bottom-up pass
+ * instead of rebuilding the tree.
+ */
+class Bvh
+{
+public:
+	/// Marks no primitive
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/// Maximum number of primitives per leaf
+	static constexpr uint32_t leaf_size = 4;
+
+	/**
+	 * Rebuilds the tree
+	 * @param [in] boxes Bounds of the primitives
+	 * @param [in] ids Identifier reported for each primitive on a hit
+	 */
+	void Build(Span<const Aabb> boxes, Span<const uint32_t> ids)
+	{
+		primitives.assign(boxes.begin(), boxes.end());
+		primitive_ids.assign(ids.begin(), ids.end());
+
+		order.resize(primitives.size());
+		for (uint32_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+
+		nodes.clear();
+		if (primitives.empty())
+			return;
+
+		nodes.reserve(2 * primitives.size());
+		nodes.emplace_back();
+		Split(0, 0, static_cast<uint32_t>(primitives.size()));
+	}
+
+	/**
+	 * Updates the bounds of the primitives and of every node, keeping the
+	 * structure of the tree
+	 * @param [in] boxes New bounds, in the order given to Build
+	 */
+	void Refit(Span<const Aabb> boxes)
+	{
+		primitives.assign(boxes.begin(), boxes.end());
+
+		// Children are always stored after their parent
+		for (size_t i = nodes.size(); i-- > 0;)
+		{
+			Node& node = nodes[i];
+			node.bounds = node.count > 0 ? LeafBounds(node) : Aabb::Union(nodes[node.first].bounds, nodes[node.first + 1].bounds);
+		}
+	}
+
+	/**
+	 * Traces a packet of rays, keeping the closest hit of each of them
+	 * @param [in,out] packet Rays along with their closest hit so far
+	 */
+	void Trace(RayPacket& packet) const
+	{
+		if (nodes.empty())
+			return;
+
+		uint32_t stack[64];
+		int size = 0;
+		stack[size++] = 0;
+
+		while (size > 0)
+		{
+			const Node& node = nodes[stack[--size]];
+
+			Float4 entry;
+			if (not packet.Intersect(node.bounds, entry).Any())
+				continue;
+
+			if (node.count > 0)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; ++i)
+				{
+					const uint32_t primitive = order[i];
+
+					// Strictly closer, ties keep the earlier hit
+					const Mask4 hits = packet.Intersect(primitives[primitive], entry);
+					const Mask4 closer = hits & (entry < packet.t);
+					const int lanes = closer.Bits();
+					if (lanes == 0)
+						continue;
+
+					packet.t = Select(closer, entry, packet.t);
+
+					for (int lane = 0; lane < 4; ++lane)
+						if (lanes & (1 << lane))
+							packet.hit[lane] = primitive_ids[primitive];
+				}
+			}
+			else
+			{
+				// Visit the child the rays enter first, first
+				Float4 left_entry, right_entry;
+				const int left = packet.Intersect(nodes[node.first].bounds, left_entry).Bits();
+				const int right = packet.Intersect(nodes[node.first + 1].bounds, right_entry).Bits();
+
+				const bool right_first = right and (not left or NearestLane(right_entry, right) < NearestLane(left_entry, left));
+
+				if (right_first)
+				{
+					if (left) stack[size++] = node.first;
+					stack[size++] = node.first + 1;
+				}
+				else
+				{
+					if (right) stack[size++] = node.first + 1;
+					if (left) stack[size++] = node.first;
+				}
+			}
+		}
+	}
+
+	/** Returns the number of primitives */
+	size_t Size() const { return primitives.size(); }
+
+	/** Returns the bounds of all the primitives */
+	Aabb Bounds() const { return nodes.empty() ? Aabb() : nodes[0].bounds; }
+
+private:
+	struct Node
+	{
+		/// Bounds of every primitive under this node
+		Aabb bounds{};
+
+		/// First primitive (in order) if a leaf; otherwise the left child, followed by the right one
+		uint32_t first = 0;
+
+		/// Number of primitives if a leaf; 0 otherwise
+		uint32_t count = 0;
+	};
+
+	/** Returns the smallest entry distance among the given lanes */
+	static float NearestLane(const Float4& entry, int lanes)
+	{
+		float values[4];
+		entry.Store(values);
+
+		float nearest = std::numeric_limits<float>::max();
+		for (int lane = 0; lane < 4; ++lane)
+			if (lanes & (1 << lane))
+				nearest = std::min(nearest, values[lane]);
+
+		return nearest;
+	}
+
+	Aabb LeafBounds(const Node& node) const
+	{
+		Aabb bounds = primitives[order[node.first]];
+		for (uint32_t i = node.first + 1; i < node.first + node.count; ++i)
+			bounds = Aabb::Union(bounds, primitives[order[i]]);
+
+		return bounds;
+	}
+
+	/**
+	 * Turns node 'index' into the root of the subtree of order[first, first + count)
+	 */
+	void Split(uint32_t index, uint32_t first, uint32_t count)
+	{
+		nodes[index].first = first;
+		nodes[index].count = count;
+		nodes[index].bounds = LeafBounds(nodes[index]);
+
+		if (count <= leaf_size)
+			return;
+
+		// Widest axis of the centers
+		Vec3 lo = primitives[order[first]].Center();
+		Vec3 hi = lo;
+		for (uint32_t i = first + 1; i < first + count; ++i)
+		{
+			lo = Min(lo, primitives[order[i]].Center());
+			hi = Max(hi, primitives[order[i]].Center());
+		}
+
+		const Vec3 extent = hi - lo;
+		const int axis = extent.x >= extent.y and extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+		auto center = [&](uint32_t primitive)
+		{
+			const Vec3 c = primitives[primitive].Center();
+			return axis == 0 ? c.x : (axis == 1 ? c.y : c.z);
+		};
+
+		const uint32_t half = count / 2;
+		std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+						 [&](uint32_t a, uint32_t b) { return center(a) < center(b); });
+
+		// Depth stays under the size of the traversal stack since the split is balanced
+		const auto left = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+		nodes.emplace_back();
+
+		nodes[index].first = left;
+		nodes[index].count = 0;
+
+		Split(left, first, half);
+		Split(left + 1, first + half, count - half);
+	}
+
+	/// Nodes, the root first
+	std::vector<Node> nodes{};
+
+	/// Bounds of each primitive
+	std::vector<Aabb> primitives{};
+
+	/// Identifier of each primitive
+	std::vector<uint32_t> primitive_ids{};
+
+	/// Primitives in leaf order
+	std::vector<uint32_t> order{};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_SPATIAL_BVH_H
@@ -0,0 +1,217 @@
+#ifndef PIXIE_SPATIAL_RAYCASTER_H
+#define PIXIE_SPATIAL_RAYCASTER_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Pixie/Core/Engine/WorkerPool.h"
+#include "Pixie/Spatial/Bvh.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Scene geometry for ray casts, e.g. lidar or vision-ray observations.
+ *
+ * The geometry is a set of boxes split in two hierarchies: one over the
+ * static boxes, rebuilt only when static boxes are added, and one over the
+ * dynamic boxes, refitted when they move and rebuilt when they are added
+ * or removed. Changes are applied by Commit, which the scene calls at the
+ * end of Begin and of Tick.
+ *
+ * @code
+ * auto* geometry = ObjectInitializer::GetRaycaster();
+ * geometry->AddStatic({{0, 0, 0}, {1, 1, 1}});
+ * geometry->Raycast(rays, distances, hits, &Core::GetWorkerPool());
+ * @endcode
+ */
+class Raycaster
+{
+public:
+	/// Marks no hit
+	static constexpr uint32_t npos = Bvh::npos;
+
+	/// Number of rays per chunk of work
+	static constexpr size_t rays_per_chunk = 256;
+
+	/**
+	 * Adds a box that never moves
+	 * @return Identifier of the box, reported on a hit
+	 */
+	uint32_t AddStatic(const Aabb& box)
+	{
+		static_boxes.push_back(box);
+		static_ids.push_back(next_id);
+		dynamic_slots.push_back(npos);
+		is_static_dirty = true;
+
+		return next_id++;
+	}
+
+	/**
+	 * Adds a box that can move (see SetBounds) and be removed
+	 * @return Identifier of the box, reported on a hit
+	 */
+	uint32_t AddDynamic(const Aabb& box)
+	{
+		dynamic_slots.push_back(static_cast<uint32_t>(dynamic_boxes.size()));
+		dynamic_boxes.push_back(box);
+		dynamic_ids.push_back(next_id);
+		is_dynamic_rebuilt = true;
+
+		return next_id++;
+	}
+
+	/**
+	 * Moves a dynamic box
+	 * @note Applied by the next Commit
+	 */
+	void SetBounds(uint32_t id, const Aabb& box)
+	{
+		dynamic_boxes[dynamic_slots[id]] = box;
+		is_dynamic_moved = true;
+	}
+
+	/**
+	 * Removes a dynamic box
+	 * @return True if it was a live dynamic box; otherwise false
+	 */
+	bool RemoveDynamic(uint32_t id)
+	{
+		if (id >= dynamic_slots.size() or dynamic_slots[id] == npos)
+			return false;
+
+		// The last box takes the place of the removed one
+		const uint32_t slot = dynamic_slots[id];
+		dynamic_boxes[slot] = dynamic_boxes.back();
+		dynamic_ids[slot] = dynamic_ids.back();
+		dynamic_slots[dynamic_ids[slot]] = slot;
+
+		dynamic_boxes.pop_back();
+		dynamic_ids.pop_back();
+		dynamic_slots[id] = npos;
+		is_dynamic_rebuilt = true;
+
+		return true;
+	}
+
+	/**
+	 * Applies the changes to the hierarchies: rebuilds the ones whose set
+	 * of boxes changed and refits the dynamic one if its boxes only moved
+	 */
+	void Commit()
+	{
+		if (is_static_dirty)
+			static_tree.Build(Span<const Aabb>(static_boxes), Span<const uint32_t>(static_ids));
+
+		if (is_dynamic_rebuilt)
+			dynamic_tree.Build(Span<const Aabb>(dynamic_boxes), Span<const uint32_t>(dynamic_ids));
+		else if (is_dynamic_moved)
+			dynamic_tree.Refit(Span<const Aabb>(dynamic_boxes));
+
+		is_static_dirty = is_dynamic_rebuilt = is_dynamic_moved = false;
+	}
+
+	/**
+	 * Casts a batch of rays against the committed geometry. Rays are traced
+	 * four at a time and the batch is split across the input workers.
+	 * @param [in] rays Rays to cast
+	 * @param [out] distances Distance to the closest hit of each ray, or its
+	 * max_distance if it hits nothing. Can be used as an observation as is
+	 * @param [out] hits Identifier of the box hit by each ray, or npos.
+	 * Optional, may be empty
+	 * @param [in] workers Workers to split the batch across, or nullptr to
+	 * cast on the calling thread only
+	 */
+	void Raycast(Span<const Ray> rays, Span<float> distances, Span<uint32_t> hits = {}, WorkerPool* workers = nullptr) const
+	{
+		auto cast = [&](size_t begin, size_t end)
+		{
+			for (size_t first = begin; first < end; first += 4)
+				CastPacket(rays, first, std::min<size_t>(4, end - first), distances, hits);
+		};
+
+		if (workers)
+			workers->ParallelFor(rays.size(), rays_per_chunk, cast);
+		else
+			cast(0, rays.size());
+	}
+
+	/** Returns the number of static boxes */
+	size_t StaticCount() const { return static_boxes.size(); }
+
+	/** Returns the number of dynamic boxes */
+	size_t DynamicCount() const { return dynamic_boxes.size(); }
+
+private:
+	/**
+	 * Traces up to four consecutive rays as a single packet
+	 */
+	void CastPacket(Span<const Ray> rays, size_t first, size_t count, Span<float> distances, Span<uint32_t> hits) const
+	{
+		alignas(16) float values[7][4];
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			// Unused lanes never hit anything
+			const Ray ray = lane < count ? rays[first + lane] : Ray{{}, {1.0f, 1.0f, 1.0f}, -1.0f};
+
+			values[0][lane] = ray.origin.x;
+			values[1][lane] = ray.origin.y;
+			values[2][lane] = ray.origin.z;
+			values[3][lane] = 1.0f / ray.direction.x;
+			values[4][lane] = 1.0f / ray.direction.y;
+			values[5][lane] = 1.0f / ray.direction.z;
+			values[6][lane] = ray.max_distance;
+		}
+
+		RayPacket packet{Float4::Load(values[0]), Float4::Load(values[1]), Float4::Load(values[2]),
+						 Float4::Load(values[3]), Float4::Load(values[4]), Float4::Load(values[5]),
+						 Float4::Load(values[6]), {npos, npos, npos, npos}};
+
+		static_tree.Trace(packet);
+		dynamic_tree.Trace(packet);
+
+		packet.t.Store(values[0]);
+		for (size_t lane = 0; lane < count; ++lane)
+		{
+			distances[first + lane] = values[0][lane];
+			if (not hits.empty())
+				hits[first + lane] = packet.hit[lane];
+		}
+	}
+
+	/// Hierarchy over the static boxes
+	Bvh static_tree{};
+
+	/// Hierarchy over the dynamic boxes
+	Bvh dynamic_tree{};
+
+	/// Bounds and identifier of each static box
+	std::vector<Aabb> static_boxes{};
+	std::vector<uint32_t> static_ids{};
+
+	/// Bounds and identifier of each dynamic box
+	std::vector<Aabb> dynamic_boxes{};
+	std::vector<uint32_t> dynamic_ids{};
+
+	/// Identifier -> index of the box among the dynamic ones, npos if static or removed
+	std::vector<uint32_t> dynamic_slots{};
+
+	/// Identifier of the next box
+	uint32_t next_id = 0;
+
+	/// Whether static boxes were added since the last commit
+	bool is_static_dirty = false;
+
+	/// Whether dynamic boxes were added or removed since the last commit
+	bool is_dynamic_rebuilt = false;
+
+	/// Whether dynamic boxes moved since the last commit
+	bool is_dynamic_moved = false;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_SPATIAL_RAYCASTER_H
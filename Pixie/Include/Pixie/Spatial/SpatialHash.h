@@ -0,0 +1,512 @@
+#ifndef PIXIE_SPATIAL_SPATIAL_HASH_H
+#define PIXIE_SPATIAL_SPATIAL_HASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Pixie/Math/Vector.h"
+#include "Pixie/Utility/Span.h"
+
+namespace pixie
+{
+
+/**
+ * Results of a batched query, one list of proxies per query point, packed
+ * back to back
+ */
+struct SpatialQueryResults
+{
+	/** Returns the proxies found for the query point at index 'query' */
+	Span<const uint32_t> operator[](size_t query) const
+	{
+		return Span<const uint32_t>(ids.data() + offsets[query], offsets[query + 1] - offsets[query]);
+	}
+
+	/** Returns the number of query points */
+	size_t Size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+	/** Removes all the results */
+	void Clear()
+	{
+		ids.clear();
+		offsets.assign(1, 0);
+	}
+
+	/// Proxies found by all the queries
+	std::vector<uint32_t> ids{};
+
+	/// Query index -> first of its proxies in ids, plus one past the last
+	std::vector<uint32_t> offsets{0};
+};
+
+
+/**
+ * Scene-level uniform grid spatial hash that answers neighbor queries
+ * without scanning every object.
+ *
+ * Objects register a proxy (a point) and move it every frame. Changes are
+ * staged and applied in one incremental pass by Commit, which the scene
+ * calls at the end of Begin and of Tick. Only the proxies that moved to a
+ * different cell touch the grid. Queries therefore always see the positions
+ * of the last committed frame, regardless of the order objects tick in.
+ *
+ * @code
+ * auto* grid = ObjectInitializer::GetSpatialHash();
+ * proxy = grid->Insert(position);                 // e.g. in Begin
+ * grid->SetPosition(proxy, position);             // every Tick
+ * grid->QueryRadius(position, 5.0f, neighbors);   // proxies within 5 units
+ * @endcode
+ */
+class SpatialHash
+{
+public:
+	/// Marks an invalid proxy
+	static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * (Constructor)
+	 * @param [in] cell_size Edge length of the cells. Ideally close to the
+	 * typical query radius
+	 */
+	explicit SpatialHash(float cell_size = 1.0f)
+			: cell_size(cell_size), inverse_cell_size(1.0f / cell_size)
+	{}
+
+	/**
+	 * Registers a proxy at the given position
+	 * @return Identifier of the proxy
+	 * @note Visible to the queries after the next Commit
+	 */
+	uint32_t Insert(const Vec3& position)
+	{
+		uint32_t id;
+		if (not free_ids.empty())
+		{
+			id = free_ids.back();
+			free_ids.pop_back();
+			proxies[id] = Proxy();
+		}
+		else
+		{
+			id = static_cast<uint32_t>(proxies.size());
+			proxies.emplace_back();
+		}
+
+		SetPosition(id, position);
+		return id;
+	}
+
+	/**
+	 * Moves a proxy
+	 * @note Applied by the next Commit. Only the last position set before
+	 * the commit is kept
+	 */
+	void SetPosition(uint32_t id, const Vec3& position)
+	{
+		Proxy& proxy = proxies[id];
+		proxy.next_position = position;
+
+		if (proxy.state == ProxyState::Committed)
+		{
+			proxy.state = ProxyState::Moved;
+			staged.push_back(id);
+		}
+		else if (proxy.state == ProxyState::Free)
+		{
+			proxy.state = ProxyState::Inserted;
+			staged.push_back(id);
+		}
+	}
+
+	/**
+	 * Unregisters a proxy
+	 * @note Applied by the next Commit, after which its identifier is recycled
+	 */
+	void Remove(uint32_t id)
+	{
+		Proxy& proxy = proxies[id];
+		if (proxy.state == ProxyState::Free or proxy.state == ProxyState::Removed or proxy.state == ProxyState::Discarded)
+			return;
+
+		if (proxy.state == ProxyState::Committed)
+			staged.push_back(id);
+
+		proxy.state = proxy.state == ProxyState::Inserted ? ProxyState::Discarded : ProxyState::Removed;
+	}
+
+	/**
+	 * Applies the staged insertions, moves and removals
+	 * @note Proportional to the number of staged changes
+	 */
+	void Commit()
+	{
+		for (uint32_t id : staged)
+		{
+			Proxy& proxy = proxies[id];
+
+			switch (proxy.state)
+			{
+				case ProxyState::Inserted:
+					proxy.position = proxy.next_position;
+					AddToCell(id, CellOf(proxy.position));
+					proxy.state = ProxyState::Committed;
+					++count;
+					break;
+
+				case ProxyState::Moved:
+				{
+					proxy.position = proxy.next_position;
+
+					const CellCoord cell = CellOf(proxy.position);
+					if (Key(cell) != proxy.cell)
+					{
+						RemoveFromCell(id);
+						AddToCell(id, cell);
+					}
+					else
+					{
+						cells[proxy.cell][proxy.slot].position = proxy.position;
+					}
+
+					proxy.state = ProxyState::Committed;
+					break;
+				}
+
+				case ProxyState::Removed:
+					RemoveFromCell(id);
+					proxy.state = ProxyState::Free;
+					free_ids.push_back(id);
+					--count;
+					break;
+
+				case ProxyState::Discarded:
+					proxy.state = ProxyState::Free;
+					free_ids.push_back(id);
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		staged.clear();
+	}
+
+	/**
+	 * Returns the committed position of a proxy
+	 */
+	Vec3 GetPosition(uint32_t id) const { return proxies[id].position; }
+
+	/** Returns the number of committed proxies */
+	size_t Size() const { return count; }
+
+	/** Returns the edge length of the cells */
+	float GetCellSize() const { return cell_size; }
+
+	/**
+	 * Appends the proxies within 'radius' of 'center' (inclusive)
+	 * @param [out] out Appended with the identifiers of the proxies
+	 */
+	void QueryRadius(const Vec3& center, float radius, std::vector<uint32_t>& out) const
+	{
+		const float radius_squared = radius * radius;
+		const Vec3 extent{radius, radius, radius};
+
+		ForEachEntry(center - extent, center + extent, [&](const Entry& entry)
+		{
+			if (DistanceSquared(entry.position, center) <= radius_squared)
+				out.push_back(entry.id);
+		});
+	}
+
+	/**
+	 * Appends the proxies inside the axis-aligned box [min, max] (inclusive)
+	 * @param [out] out Appended with the identifiers of the proxies
+	 */
+	void QueryAabb(const Vec3& min, const Vec3& max, std::vector<uint32_t>& out) const
+	{
+		ForEachEntry(min, max, [&](const Entry& entry)
+		{
+			const Vec3& p = entry.position;
+			if (p.x >= min.x and p.y >= min.y and p.z >= min.z and p.x <= max.x and p.y <= max.y and p.z <= max.z)
+				out.push_back(entry.id);
+		});
+	}
+
+	/**
+	 * Appends the k proxies closest to 'center', closest first
+	 * @param [out] out Appended with the identifiers of at most k proxies
+	 * @note Searches the cells ring by ring around the center and stops as
+	 * soon as no farther ring can hold a closer proxy
+	 */
+	void QueryNearest(const Vec3& center, size_t k, std::vector<uint32_t>& out) const
+	{
+		std::vector<Candidate> best;
+		QueryNearest(center, k, out, best);
+	}
+
+	/**
+	 * Batched QueryRadius: one query per center
+	 * @param [out] results Cleared and filled with the proxies of each center
+	 */
+	void QueryRadius(Span<const Vec3> centers, float radius, SpatialQueryResults& results) const
+	{
+		results.Clear();
+		results.offsets.reserve(centers.size() + 1);
+
+		for (auto& center : centers)
+		{
+			QueryRadius(center, radius, results.ids);
+			results.offsets.push_back(static_cast<uint32_t>(results.ids.size()));
+		}
+	}
+
+	/**
+	 * Batched QueryAabb: one box per pair of corners
+	 * @param [out] results Cleared and filled with the proxies of each box
+	 */
+	void QueryAabb(Span<const Vec3> mins, Span<const Vec3> maxs, SpatialQueryResults& results) const
+	{
+		results.Clear();
+		results.offsets.reserve(mins.size() + 1);
+
+		for (size_t i = 0; i < mins.size(); ++i)
+		{
+			QueryAabb(mins[i], maxs[i], results.ids);
+			results.offsets.push_back(static_cast<uint32_t>(results.ids.size()));
+		}
+	}
+
+	/**
+	 * Batched QueryNearest: the k closest proxies of each center
+	 * @param [out] results Cleared and filled with the proxies of each center
+	 */
+	void QueryNearest(Span<const Vec3> centers, size_t k, SpatialQueryResults& results) const
+	{
+		results.Clear();
+		results.offsets.reserve(centers.size() + 1);
+
+		std::vector<Candidate> best;
+		for (auto& center : centers)
+		{
+			QueryNearest(center, k, results.ids, best);
+			results.offsets.push_back(static_cast<uint32_t>(results.ids.size()));
+		}
+	}
+
+private:
+	/// Squared distance and identifier of a proxy
+	using Candidate = std::pair<float, uint32_t>;
+
+	/**
+	 * QueryNearest, with a reusable heap
+	 */
+	void QueryNearest(const Vec3& center, size_t k, std::vector<uint32_t>& out, std::vector<Candidate>& best) const
+	{
+		if (k == 0 or count == 0)
+			return;
+
+		// Max-heap of the k closest so far, on squared distance
+		best.clear();
+
+		const CellCoord origin = CellOf(center);
+		const int max_ring = std::max({origin.x - bounds_min.x, bounds_max.x - origin.x,
+									   origin.y - bounds_min.y, bounds_max.y - origin.y,
+									   origin.z - bounds_min.z, bounds_max.z - origin.z});
+
+		for (int ring = 0; ring <= max_ring; ++ring)
+		{
+			ForEachCellInRing(origin, ring, [&](const std::vector<Entry>& entries)
+			{
+				for (auto& entry : entries)
+				{
+					const float distance = DistanceSquared(entry.position, center);
+					if (best.size() < k)
+					{
+						best.emplace_back(distance, entry.id);
+						std::push_heap(best.begin(), best.end());
+					}
+					else if (distance < best.front().first)
+					{
+						std::pop_heap(best.begin(), best.end());
+						best.back() = {distance, entry.id};
+						std::push_heap(best.begin(), best.end());
+					}
+				}
+			});
+
+			// Every proxy beyond this ring is at least 'ring' cells away
+			const float reach = static_cast<float>(ring) * cell_size;
+			if (best.size() == k and best.front().first <= reach * reach)
+				break;
+		}
+
+		std::sort_heap(best.begin(), best.end());
+		for (auto& candidate : best)
+			out.push_back(candidate.second);
+	}
+
+	enum class ProxyState : uint8_t
+	{
+		Free,       ///< Not in use
+		Inserted,   ///< Inserted, not committed yet
+		Committed,  ///< In the grid
+		Moved,      ///< In the grid, with a staged move
+		Removed,    ///< In the grid, with a staged removal
+		Discarded   ///< Removed before it was ever committed
+	};
+
+	struct Proxy
+	{
+		/// Committed position
+		Vec3 position{};
+
+		/// Position set since the last commit
+		Vec3 next_position{};
+
+		/// Key of the cell that holds the proxy
+		uint64_t cell = 0;
+
+		/// Index of the proxy within its cell
+		uint32_t slot = 0;
+
+		/// Lifecycle of the proxy
+		ProxyState state = ProxyState::Free;
+	};
+
+	/// Member of a cell. The position is copied so that a query walks the cell contiguously
+	struct Entry
+	{
+		Vec3 position;
+		uint32_t id;
+	};
+
+	struct CellCoord
+	{
+		int x, y, z;
+	};
+
+	CellCoord CellOf(const Vec3& p) const
+	{
+		return {static_cast<int>(std::floor(p.x * inverse_cell_size)),
+				static_cast<int>(std::floor(p.y * inverse_cell_size)),
+				static_cast<int>(std::floor(p.z * inverse_cell_size))};
+	}
+
+	/** Packs the cell coordinates, 21 bits each */
+	static uint64_t Key(const CellCoord& c)
+	{
+		constexpr uint64_t mask = (uint64_t(1) << 21u) - 1;
+		return (uint64_t(uint32_t(c.x)) & mask)
+			   | ((uint64_t(uint32_t(c.y)) & mask) << 21u)
+			   | ((uint64_t(uint32_t(c.z)) & mask) << 42u);
+	}
+
+	void AddToCell(uint32_t id, const CellCoord& cell)
+	{
+		Proxy& proxy = proxies[id];
+		proxy.cell = Key(cell);
+
+		auto& entries = cells[proxy.cell];
+		proxy.slot = static_cast<uint32_t>(entries.size());
+		entries.push_back({proxy.position, id});
+
+		bounds_min = {std::min(bounds_min.x, cell.x), std::min(bounds_min.y, cell.y), std::min(bounds_min.z, cell.z)};
+		bounds_max = {std::max(bounds_max.x, cell.x), std::max(bounds_max.y, cell.y), std::max(bounds_max.z, cell.z)};
+	}
+
+	void RemoveFromCell(uint32_t id)
+	{
+		const Proxy& proxy = proxies[id];
+		auto& entries = cells[proxy.cell];
+
+		// The last member of the cell takes the place of the removed one
+		entries[proxy.slot] = entries.back();
+		proxies[entries[proxy.slot].id].slot = proxy.slot;
+		entries.pop_back();
+	}
+
+	/**
+	 * Calls the input function on each member of the cells that overlap the
+	 * box [min, max], clamped to the cells that were ever occupied
+	 */
+	template<class Function>
+	void ForEachEntry(const Vec3& min, const Vec3& max, Function&& function) const
+	{
+		if (count == 0)
+			return;
+
+		const CellCoord lo = CellOf(min);
+		const CellCoord hi = CellOf(max);
+
+		for (int z = std::max(lo.z, bounds_min.z); z <= std::min(hi.z, bounds_max.z); ++z)
+			for (int y = std::max(lo.y, bounds_min.y); y <= std::min(hi.y, bounds_max.y); ++y)
+				for (int x = std::max(lo.x, bounds_min.x); x <= std::min(hi.x, bounds_max.x); ++x)
+				{
+					auto it = cells.find(Key({x, y, z}));
+					if (it != cells.end())
+						for (auto& entry : it->second)
+							function(entry);
+				}
+	}
+
+	/**
+	 * Calls the input function on the members of each occupied cell at
+	 * exactly 'ring' cells (Chebyshev distance) from 'origin'
+	 */
+	template<class Function>
+	void ForEachCellInRing(const CellCoord& origin, int ring, Function&& function) const
+	{
+		for (int z = std::max(origin.z - ring, bounds_min.z); z <= std::min(origin.z + ring, bounds_max.z); ++z)
+			for (int y = std::max(origin.y - ring, bounds_min.y); y <= std::min(origin.y + ring, bounds_max.y); ++y)
+			{
+				const bool is_face = std::abs(z - origin.z) == ring or std::abs(y - origin.y) == ring;
+
+				// Inside the shell only the two cells at x = origin.x +/- ring belong to the ring
+				const int step = is_face or ring == 0 ? 1 : 2 * ring;
+				for (int x = origin.x - ring; x <= origin.x + ring; x += step)
+				{
+					if (x < bounds_min.x or x > bounds_max.x)
+						continue;
+
+					auto it = cells.find(Key({x, y, z}));
+					if (it != cells.end())
+						function(it->second);
+				}
+			}
+	}
+
+	/// Edge length of the cells
+	float cell_size;
+
+	/// 1 / cell_size
+	float inverse_cell_size;
+
+	/// Cell key -> members of the cell
+	std::unordered_map<uint64_t, std::vector<Entry>> cells{};
+
+	/// Proxy identifier -> proxy
+	std::vector<Proxy> proxies{};
+
+	/// Proxies with a staged change, in staging order
+	std::vector<uint32_t> staged{};
+
+	/// Identifiers that can be recycled
+	std::vector<uint32_t> free_ids{};
+
+	/// Number of committed proxies
+	size_t count = 0;
+
+	/// Range of the cells that were ever occupied
+	CellCoord bounds_min{std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+	CellCoord bounds_max{std::numeric_limits<int>::min(), std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+};
+
+} // namespace pixie
+
+#endif //PIXIE_SPATIAL_SPATIAL_HASH_H
@@ -0,0 +1,73 @@
+#ifndef PIXIE_UTILITY_MAPPED_FILE_H
+#define PIXIE_UTILITY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "Pixie/Misc/PixieExports.h"
+
+namespace pixie
+{
+
+/**
+ * File mapped into memory, with mmap on POSIX systems and a file mapping
+ * on Windows
+ */
+class PIXIE_API MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/**
+	 * Creates or truncates a file of the given size and maps it for writing
+	 * @throw std::runtime_error if the file cannot be created or mapped
+	 */
+	static MappedFile Create(const std::string& path, size_t size);
+
+	/**
+	 * Maps an existing file for reading
+	 * @throw std::runtime_error if the file cannot be opened or mapped
+	 */
+	static MappedFile OpenRead(const std::string& path);
+
+	/**
+	 * Writes a range of the mapping back to the file and waits for it
+	 * @param [in] offset, length Range in bytes. Widened to whole pages
+	 */
+	void Flush(size_t offset, size_t length);
+
+	/** Unmaps and closes the file. Does nothing if it is not open */
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+
+	void* Data() { return data; }
+	const void* Data() const { return data; }
+
+	/** Returns the size of the mapping in bytes */
+	size_t Size() const { return size; }
+
+private:
+	/// Start of the mapping
+	void* data = nullptr;
+
+	/// Size of the mapping in bytes
+	size_t size = 0;
+
+	/// Handles of the file and of the mapping, as returned by the system
+	intptr_t file = -1;
+	intptr_t mapping = -1;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_UTILITY_MAPPED_FILE_H
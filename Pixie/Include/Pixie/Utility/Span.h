@@ -0,0 +1,64 @@
+#ifndef PIXIE_UTILITY_SPAN_H
+#define PIXIE_UTILITY_SPAN_H
+
+#include <cstddef>
+
+namespace pixie
+{
+
+/**
+ * Non-owning view over a contiguous sequence of objects of type T
+ * @tparam T Type of the viewed objects
+ * @note A minimal stand-in for C++20's std::span
+ */
+template<class T>
+class Span
+{
+public:
+	using element_type = T;
+	using iterator = T*;
+
+	/** Default constructor. Constructs an empty span */
+	constexpr Span() = default;
+
+	/**
+	 * (Constructor) Views 'size' objects starting at 'data'
+	 */
+	constexpr Span(T* data, size_t size)
+			: ptr(data), count(size)
+	{}
+
+	/**
+	 * (Constructor) Views all the elements of a contiguous container
+	 * (e.g. std::vector or std::array)
+	 */
+	template<class Container>
+	constexpr Span(Container& container)
+			: ptr(container.data()), count(container.size())
+	{}
+
+	constexpr T* data() const { return ptr; }
+	constexpr size_t size() const { return count; }
+	constexpr bool empty() const { return count == 0; }
+
+	constexpr T& operator[](size_t index) const { return ptr[index]; }
+
+	constexpr iterator begin() const { return ptr; }
+	constexpr iterator end() const { return ptr + count; }
+
+	/**
+	 * Returns a view over 'size' objects starting at 'offset'
+	 */
+	constexpr Span subspan(size_t offset, size_t size) const { return Span(ptr + offset, size); }
+
+private:
+	/// First viewed object
+	T* ptr = nullptr;
+
+	/// Number of viewed objects
+	size_t count = 0;
+};
+
+} // namespace pixie
+
+#endif //PIXIE_UTILITY_SPAN_H
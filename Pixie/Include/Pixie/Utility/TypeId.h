@@ -0,0 +1,46 @@
+#ifndef PIXIE_UTILITY_TYPE_ID_H
+#define PIXIE_UTILITY_TYPE_ID_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "Pixie/Utility/TypeTraits.h"
+
+namespace pixie
+{
+
+/// Identifier of a type that is computed at compile time
+using TypeId = uint64_t;
+
+/**
+ * Hashes the input string at compile time (64-bit FNV-1a)
+ * @param [in] text The string to hash
+ * @return The hash of the string
+ */
+constexpr TypeId HashTypeName(std::string_view text)
+{
+	TypeId hash = 14695981039346656037ull;
+	for (char c : text)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+/**
+ * Compile-time identifier of type T, i.e. the hash of its name (see
+ * type_traits::experimental::type_name)
+ * @tparam T The type to identify
+ * @note The hash is computed once by the compiler, hence using it as a key
+ * costs no more than an integer
+ * @warning Distinct types with the exact same name (e.g. declared in the
+ * anonymous namespaces of two translation units) share the same identifier
+ */
+template<class T>
+constexpr TypeId type_id = HashTypeName(type_traits::experimental::type_name<T>());
+
+} // namespace pixie
+
+#endif //PIXIE_UTILITY_TYPE_ID_H
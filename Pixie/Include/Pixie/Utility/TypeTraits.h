@@ -120,23 +120,29 @@ struct function_traits<R(Args...)>
 };
 
 
+/**
+ * Returns the human readable name of type T at compile time, e.g. "pixie::Tree"
+ * @tparam T (Required) The type whose name is returned
+ * @note The name is extracted from the compiler's pretty function signature.
+ * Hence, the exact spelling (e.g. "class " prefixes on MSVC) is compiler specific
+ */
 template<class T>
 constexpr std::string_view type_name()
 {
 	using namespace std;
-#ifdef __clang__
+#if defined(__clang__) || defined(__GNUC__)
+	// e.g. "... type_name() [with T = Foo; std::string_view = ...]" (GCC)
+	//  or  "... type_name() [T = Foo]" (Clang)
 	string_view p = __PRETTY_FUNCTION__;
-	return string_view(p.data() + 34, p.size() - 34 - 1);
-#elif defined(__GNUC__)
-	string_view p = __PRETTY_FUNCTION__;
-#  if __cplusplus < 201402
-	return string_view(p.data() + 36, p.size() - 36 - 1);
-#  else
-	return string_view(p.data() + 49, p.find(';', 49) - 49);
-#  endif
+	auto begin = p.find("T = ") + 4;
+	auto end = p.find_first_of(";]", begin);
+	return p.substr(begin, end - begin);
 #elif defined(_MSC_VER)
+	// e.g. "... __cdecl pixie::type_traits::experimental::type_name<struct Foo>(void)"
 	string_view p = __FUNCSIG__;
-	return string_view(p.data() + 84, p.size() - 84 - 7);
+	auto begin = p.find("type_name<") + 10;
+	auto end = p.rfind(">(void)");
+	return p.substr(begin, end - begin);
 #endif
 }
 
@@ -28,6 +28,30 @@ void Core::Start()
 	}
 }
 
+void Core::Begin()
+{
+	if (is_initialized)
+	{
+		database.engine.Begin();
+	}
+}
+
+void Core::Step()
+{
+	if (is_initialized)
+	{
+		database.engine.Step();
+	}
+}
+
+void Core::End()
+{
+	if (is_initialized)
+	{
+		database.engine.End();
+	}
+}
+
 void Core::Shutdown()
 {
 	if (is_initialized)
@@ -41,6 +65,23 @@ void Core::Reset()
 	// TODO(Ahura): Needs implementation
 }
 
+void Core::Compact()
+{
+	if (is_initialized)
+	{
+		database.scene.Compact();
+	}
+}
+
+MemoryStats Core::GetMemoryStats()
+{
+	if (is_initialized)
+	{
+		return database.scene.GetMemoryStats();
+	}
+	return MemoryStats();
+}
+
 void Core::Destroy()
 {
 	// delete the main components and all the within them
@@ -17,26 +17,59 @@ void Engine::Start()
 	is_running = true;
 
 	// Call Begin method of all the registered objects (if implemented)
-	scene->BeginObjects();
+	Begin();
 
 	// Game loop
 	while(is_running)
-	{
-		// start the stop watch
-		Core::GetClock().StartTimer();
+		Step();
 
-		// TODO(Ahura): process rendering
+	// Call End method of all the registered object (if implemented)
+	End();
+}
 
-		// TODO(Ahura): Process user inputs
+void Engine::Begin()
+{
+	if(not scene or has_begun)
+		return;
 
-		// stop the stop watch
-		Core::GetClock().StopTimer();
+	has_begun = true;
+	scene->BeginObjects();
+}
 
-		// Call Tick member of all the registered objects
-		scene->TickObjects();
-	}
+void Engine::Step()
+{
+	if(not scene)
+		return;
 
-	// Call End method of all the registered object (if implemented)
+	Begin();
+
+	// start the stop watch
+	Core::GetClock().StartTimer();
+
+	// TODO(Ahura): process rendering
+
+	// TODO(Ahura): Process user inputs
+
+	// stop the stop watch
+	Core::GetClock().StopTimer();
+
+	// Physics advances by the fixed time step, across the workers once
+	// there are enough bodies to make it worth it
+	auto& physics = scene->GetPhysics();
+	physics.SetTimeStep(Core::GetClock().GetFixedTimeStepInSeconds());
+	if (not physics.GetWorkers() and physics.Size() >= PhysicsWorld2D::parallel_body_count)
+		physics.SetWorkers(&GetWorkers());
+
+	// Call Tick member of all the registered objects
+	scene->TickObjects();
+}
+
+void Engine::End()
+{
+	if(not scene or not has_begun)
+		return;
+
+	has_begun = false;
 	scene->EndObjects();
 }
 
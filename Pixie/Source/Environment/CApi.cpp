@@ -0,0 +1,239 @@
+#include "Pixie/Environment/CApi.h"
+
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Environment/EnvironmentRegistry.h"
+
+using namespace pixie;
+
+/**
+ * Batch of instances of a registered environment
+ */
+struct pixie_env
+{
+	/// Populates the core with the instances, on creation and on reset
+	EnvironmentRegistry::Constructor constructor;
+
+	/// Number of instances
+	size_t batch_size;
+};
+
+namespace
+{
+
+/// Message of the last error, per thread so that each caller reads its own
+thread_local std::string last_error;
+
+/// The environment that owns the core, if any
+pixie_env* active = nullptr;
+
+pixie_status Fail(pixie_status status, const char* message)
+{
+	last_error = message;
+	return status;
+}
+
+/**
+ * Runs a function of the C API, turning the exceptions thrown by the
+ * objects into an error status since they must not cross the C boundary
+ */
+template<class Function>
+pixie_status Guard(Function&& function)
+{
+	try
+	{
+		return function();
+	}
+	catch (const std::exception& exception)
+	{
+		return Fail(PIXIE_ERROR_INTERNAL, exception.what());
+	}
+	catch (...)
+	{
+		return Fail(PIXIE_ERROR_INTERNAL, "Unknown exception");
+	}
+}
+
+SpaceBuffer& GetBuffer(pixie_buffer buffer)
+{
+	return buffer == PIXIE_ACTIONS ? *ObjectInitializer::GetActions() : *ObjectInitializer::GetObservations();
+}
+
+/** Returns the size of a field for the whole batch, in bytes */
+size_t GetByteSize(const SpaceBuffer& buffer, size_t field)
+{
+	return buffer.BatchSize() * buffer.GetSpace(field).ByteSize();
+}
+
+/**
+ * Initializes a fresh core, populates it with the instances of the
+ * environment and begins the episode
+ */
+void Build(const pixie_env& env)
+{
+	Core::End();
+	Core::Destroy();
+	Core::Initialize();
+
+	ObjectInitializer::GetObservations()->Resize(env.batch_size);
+	ObjectInitializer::GetActions()->Resize(env.batch_size);
+	env.constructor(env.batch_size);
+
+	Core::Begin();
+}
+
+void CopyObservations(void* const* observations)
+{
+	if (not observations)
+		return;
+
+	const SpaceBuffer& buffer = *ObjectInitializer::GetObservations();
+	for (size_t field = 0; field < buffer.FieldCount(); ++field)
+	{
+		if (observations[field])
+			std::memcpy(observations[field], buffer.GetTensor(field).data, GetByteSize(buffer, field));
+	}
+}
+
+} // namespace
+
+
+pixie_status pixie_create(const char* name, size_t batch_size, pixie_env** out)
+{
+	if (not name or not out or batch_size == 0)
+		return Fail(PIXIE_ERROR_INVALID_ARGUMENT, "pixie_create needs a name, a batch size and an output");
+	if (active)
+		return Fail(PIXIE_ERROR_BUSY, "Another environment exists, batch the instances into one instead");
+
+	const EnvironmentRegistry::Constructor* constructor = EnvironmentRegistry::Find(name);
+	if (not constructor)
+		return Fail(PIXIE_ERROR_UNKNOWN_ENVIRONMENT, "No environment is registered with this name");
+
+	return Guard([&]
+	{
+		*out = nullptr;
+		active = new pixie_env{*constructor, batch_size};
+		try
+		{
+			Build(*active);
+		}
+		catch (...)
+		{
+			pixie_destroy(active);
+			throw;
+		}
+
+		*out = active;
+		return PIXIE_OK;
+	});
+}
+
+void pixie_destroy(pixie_env* env)
+{
+	if (not env)
+		return;
+
+	if (env == active)
+	{
+		try
+		{
+			Core::End();
+		}
+		catch (...)
+		{
+			// Destroying must not fail, the core is torn down regardless
+		}
+		Core::Destroy();
+		active = nullptr;
+	}
+
+	delete env;
+}
+
+pixie_status pixie_reset(pixie_env* env, void* const* observations)
+{
+	if (not env or env != active)
+		return Fail(PIXIE_ERROR_INVALID_ARGUMENT, "pixie_reset needs a live environment");
+
+	return Guard([&]
+	{
+		Build(*env);
+		CopyObservations(observations);
+		return PIXIE_OK;
+	});
+}
+
+pixie_status pixie_step(pixie_env* env, const void* const* actions, void* const* observations)
+{
+	if (not env or env != active)
+		return Fail(PIXIE_ERROR_INVALID_ARGUMENT, "pixie_step needs a live environment");
+
+	return Guard([&]
+	{
+		if (actions)
+		{
+			SpaceBuffer& buffer = *ObjectInitializer::GetActions();
+			for (size_t field = 0; field < buffer.FieldCount(); ++field)
+				if (actions[field])
+					std::memcpy(buffer.GetTensor(field).data, actions[field], GetByteSize(buffer, field));
+		}
+
+		Core::Step();
+		CopyObservations(observations);
+		return PIXIE_OK;
+	});
+}
+
+size_t pixie_batch_size(const pixie_env* env)
+{
+	return env ? env->batch_size : 0;
+}
+
+size_t pixie_field_count(const pixie_env* env, pixie_buffer buffer)
+{
+	return env and env == active ? GetBuffer(buffer).FieldCount() : 0;
+}
+
+pixie_status pixie_get_field(const pixie_env* env, pixie_buffer buffer, size_t index, pixie_field* out)
+{
+	if (not env or env != active or not out)
+		return Fail(PIXIE_ERROR_INVALID_ARGUMENT, "pixie_get_field needs a live environment and an output");
+
+	const SpaceBuffer& source = GetBuffer(buffer);
+	if (index >= source.FieldCount())
+		return Fail(PIXIE_ERROR_INVALID_ARGUMENT, "pixie_get_field was given an index past the last field");
+
+	const Space& space = source.GetSpace(index);
+	const TensorView tensor = source.GetTensor(index);
+
+	*out = pixie_field();
+	out->name = source.GetName(index).c_str();
+	out->kind = static_cast<pixie_space_kind>(space.GetKind());
+	out->low = space.GetLow();
+	out->high = space.GetHigh();
+	out->counts = space.GetCounts().data();
+	out->count_size = space.GetCounts().size();
+	out->byte_size = GetByteSize(source, index);
+
+	out->tensor.data = tensor.data;
+	out->tensor.code = tensor.type.code;
+	out->tensor.bits = tensor.type.bits;
+	out->tensor.lanes = tensor.type.lanes;
+	out->tensor.ndim = tensor.ndim;
+	for (int32_t i = 0; i < tensor.ndim; ++i)
+	{
+		out->tensor.shape[i] = tensor.shape[i];
+		out->tensor.strides[i] = tensor.strides[i];
+	}
+
+	return PIXIE_OK;
+}
+
+const char* pixie_last_error(void)
+{
+	return last_error.c_str();
+}
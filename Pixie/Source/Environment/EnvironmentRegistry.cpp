@@ -0,0 +1,30 @@
+#include "Pixie/Environment/EnvironmentRegistry.h"
+
+#include <unordered_map>
+
+using namespace pixie;
+
+namespace
+{
+
+/** Returns the registered environments, created on first use */
+std::unordered_map<std::string, EnvironmentRegistry::Constructor>& GetEnvironments()
+{
+	static std::unordered_map<std::string, EnvironmentRegistry::Constructor> environments;
+	return environments;
+}
+
+} // namespace
+
+
+void EnvironmentRegistry::Register(const std::string& name, Constructor constructor)
+{
+	GetEnvironments()[name] = std::move(constructor);
+}
+
+const EnvironmentRegistry::Constructor* EnvironmentRegistry::Find(const std::string& name)
+{
+	const auto& environments = GetEnvironments();
+	const auto it = environments.find(name);
+	return it != environments.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,179 @@
+#include "Pixie/Utility/MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace pixie;
+
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		data = other.data;
+		size = other.size;
+		file = other.file;
+		mapping = other.mapping;
+
+		other.data = nullptr;
+		other.size = 0;
+		other.file = -1;
+		other.mapping = -1;
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+MappedFile MappedFile::Create(const std::string& path, size_t size)
+{
+	MappedFile result;
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Cannot create " + path);
+	result.file = reinterpret_cast<intptr_t>(file);
+
+	const auto size_64 = static_cast<unsigned long long>(size);
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size_64 >> 32), static_cast<DWORD>(size_64), nullptr);
+	if (not mapping)
+		throw std::runtime_error("Cannot map " + path);
+	result.mapping = reinterpret_cast<intptr_t>(mapping);
+
+	result.data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+	if (not result.data)
+		throw std::runtime_error("Cannot map " + path);
+	result.size = size;
+
+	return result;
+}
+
+MappedFile MappedFile::OpenRead(const std::string& path)
+{
+	MappedFile result;
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Cannot open " + path);
+	result.file = reinterpret_cast<intptr_t>(file);
+
+	LARGE_INTEGER file_size;
+	if (not GetFileSizeEx(file, &file_size) or file_size.QuadPart == 0)
+		throw std::runtime_error("Cannot map the empty file " + path);
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (not mapping)
+		throw std::runtime_error("Cannot map " + path);
+	result.mapping = reinterpret_cast<intptr_t>(mapping);
+
+	result.data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (not result.data)
+		throw std::runtime_error("Cannot map " + path);
+	result.size = static_cast<size_t>(file_size.QuadPart);
+
+	return result;
+}
+
+void MappedFile::Flush(size_t offset, size_t length)
+{
+	if (not data or length == 0)
+		return;
+
+	FlushViewOfFile(static_cast<char*>(data) + offset, length);
+	FlushFileBuffers(reinterpret_cast<HANDLE>(file));
+}
+
+void MappedFile::Close()
+{
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping != -1)
+		CloseHandle(reinterpret_cast<HANDLE>(mapping));
+	if (file != -1)
+		CloseHandle(reinterpret_cast<HANDLE>(file));
+
+	data = nullptr;
+	size = 0;
+	file = -1;
+	mapping = -1;
+}
+
+#else
+
+MappedFile MappedFile::Create(const std::string& path, size_t size)
+{
+	MappedFile result;
+	const int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (file < 0)
+		throw std::runtime_error("Cannot create " + path);
+	result.file = file;
+
+	if (ftruncate(file, static_cast<off_t>(size)) != 0)
+		throw std::runtime_error("Cannot resize " + path);
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	if (data == MAP_FAILED)
+		throw std::runtime_error("Cannot map " + path);
+	result.data = data;
+	result.size = size;
+
+	return result;
+}
+
+MappedFile MappedFile::OpenRead(const std::string& path)
+{
+	MappedFile result;
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		throw std::runtime_error("Cannot open " + path);
+	result.file = file;
+
+	struct stat status;
+	if (fstat(file, &status) != 0 or status.st_size == 0)
+		throw std::runtime_error("Cannot map the empty file " + path);
+
+	const auto size = static_cast<size_t>(status.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+	if (data == MAP_FAILED)
+		throw std::runtime_error("Cannot map " + path);
+	result.data = data;
+	result.size = size;
+
+	return result;
+}
+
+void MappedFile::Flush(size_t offset, size_t length)
+{
+	if (not data or length == 0)
+		return;
+
+	// msync needs an address aligned to a page
+	const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	const size_t begin = offset / page * page;
+	msync(static_cast<char*>(data) + begin, offset + length - begin, MS_SYNC);
+}
+
+void MappedFile::Close()
+{
+	if (data)
+		munmap(data, size);
+	if (file != -1)
+		close(static_cast<int>(file));
+
+	data = nullptr;
+	size = 0;
+	file = -1;
+	mapping = -1;
+}
+
+#endif
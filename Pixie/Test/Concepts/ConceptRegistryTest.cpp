@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "Pixie/Concepts/ConceptRegistry.h"
+
+struct Observe
+{
+	template<class T>
+	static auto Call(T& object) -> decltype(object.Observe()) { object.Observe(); }
+};
+
+struct ComputeReward
+{
+	template<class T>
+	static auto Call(T& object) -> decltype(object.ComputeReward()) { object.ComputeReward(); }
+
+	template<class T>
+	static auto CallBatch(pixie::Span<T> objects) -> decltype(T::ComputeRewards(objects)) { T::ComputeRewards(objects); }
+};
+
+// The concepts must be declared before any of the scene objects is constructed
+namespace pixie
+{
+template<>
+struct SceneConcepts<>
+{
+	using type = ConceptList<Observe, ComputeReward>;
+};
+}
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Sensor
+{
+	void Observe() { ++observations; }
+
+	int observations = 0;
+};
+
+
+struct Rock
+{
+};
+
+
+struct Robot
+{
+	Handle<Sensor> sensor;
+	Handle<Rock> rock;
+
+	Robot()
+	{
+		sensor = ObjectInitializer::ConstructComponent<Sensor>();
+		rock = ObjectInitializer::ConstructComponent<Rock>();
+	}
+
+	void Tick() {}
+
+	void Observe() { ++observations; }
+
+	static void ComputeRewards(Span<Robot> robots)
+	{
+		++batch_calls;
+
+		for (auto& robot : robots)
+			robot.reward += 1.0f;
+	}
+
+	int observations = 0;
+	float reward = 0.0f;
+
+	static int batch_calls;
+};
+int Robot::batch_calls = 0;
+
+
+TEST(ConceptRegistryTest, DetectsImplementations)
+{
+	EXPECT_TRUE((Implements<Robot, Observe>));
+	EXPECT_TRUE((Implements<Sensor, Observe>));
+	EXPECT_FALSE((Implements<Rock, Observe>));
+	EXPECT_FALSE((Implements<Sensor, ComputeReward>));
+
+	EXPECT_EQ((ConceptIndex<Observe, SceneConceptsOf<void>>::value), 0u);
+	EXPECT_EQ((ConceptIndex<ComputeReward, SceneConceptsOf<void>>::value), 1u);
+}
+
+
+TEST(ConceptRegistryTest, StorageKnowsItsConcepts)
+{
+	ComponentStorage<Robot> robots;
+	ComponentStorage<Rock> rocks;
+
+	EXPECT_EQ(robots.ConceptCount(), 2u);
+	EXPECT_NE(robots.GetConceptDispatcher(0), nullptr);
+	EXPECT_NE(robots.GetConceptDispatcher(1), nullptr);
+	EXPECT_EQ(rocks.GetConceptDispatcher(0), nullptr);
+	EXPECT_EQ(rocks.GetConceptDispatcher(1), nullptr);
+}
+
+
+TEST(ConceptRegistryTest, DispatchReachesOnlyImplementers)
+{
+	Core::Initialize();
+	Robot::batch_calls = 0;
+
+	std::vector<Handle<Robot>> robots;
+	for (int i = 0; i < 4; ++i)
+		robots.push_back(ObjectInitializer::ConstructEntity<Robot>());
+
+	Core::Dispatch<Observe>();
+	Core::Dispatch<Observe>();
+	Core::Dispatch<ComputeReward>();
+
+	for (auto& robot : robots)
+	{
+		EXPECT_EQ(robot->observations, 2);
+		EXPECT_EQ(robot->sensor->observations, 2);
+		EXPECT_FLOAT_EQ(robot->reward, 1.0f);
+	}
+
+	// All robots are contiguous, hence rewarded in a single batch
+	EXPECT_EQ(Robot::batch_calls, 1);
+
+	Core::Destroy();
+}
+
+
+TEST(ConceptRegistryTest, StaticSceneDispatch)
+{
+	StaticScene<Sensor, Rock> scene;
+	scene.Add<Sensor>();
+	scene.Add<Sensor>();
+	scene.Add<Rock>();
+
+	scene.Dispatch<Observe>();
+	scene.DispatchConcept(0);
+
+	for (auto& sensor : scene.GetAll<Sensor>())
+		EXPECT_EQ(sensor.observations, 2);
+}
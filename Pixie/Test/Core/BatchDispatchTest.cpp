@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Bee
+{
+	static void TickBatch(Span<Bee> bees)
+	{
+		++batch_calls;
+
+		for (auto& bee : bees)
+			++bee.ticks;
+	}
+
+	int ticks = 0;
+
+	static int batch_calls;
+};
+int Bee::batch_calls = 0;
+
+
+struct Ant
+{
+	void Tick() { ++ticks; }
+
+	int ticks = 0;
+};
+
+
+struct Hive
+{
+	std::vector<Handle<Bee>> bees;
+	std::vector<Handle<Ant>> ants;
+
+	Hive()
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			bees.push_back(ObjectInitializer::ConstructComponent<Bee>());
+			ants.push_back(ObjectInitializer::ConstructComponent<Ant>());
+		}
+	}
+
+	void Tick()
+	{
+		++ticks;
+
+		if (ticks == 5)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+};
+
+
+TEST(BatchDispatchTest, TickBatchFallsBackToTick)
+{
+	std::vector<Ant> ants(3);
+
+	TickBatch(Span<Ant>(ants));
+	TickBatch(Span<Ant>(ants));
+
+	for (auto& ant : ants)
+		EXPECT_EQ(ant.ticks, 2);
+
+	EXPECT_TRUE(HasTickBatch<Bee>);
+	EXPECT_FALSE(HasTickBatch<Ant>);
+}
+
+
+TEST(BatchDispatchTest, OneBatchPerTypePerFrame)
+{
+	Core::Initialize();
+	Bee::batch_calls = 0;
+
+	auto first = ObjectInitializer::ConstructEntity<Hive>();
+	auto second = ObjectInitializer::ConstructEntity<Hive>();
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// All 20 bees are contiguous in memory, hence they are ticked in a
+	// single batch per frame
+	EXPECT_EQ(first->ticks, 5);
+	EXPECT_EQ(Bee::batch_calls, 5);
+
+	for (auto* hive : {first.Get(), second.Get()})
+	{
+		for (auto& bee : hive->bees)
+			EXPECT_EQ(bee->ticks, 5);
+
+		for (auto& ant : hive->ants)
+			EXPECT_EQ(ant->ticks, 5);
+	}
+
+	Core::Destroy();
+}
+
+
+TEST(BatchDispatchTest, HolesSplitBatches)
+{
+	Core::Initialize();
+	Bee::batch_calls = 0;
+
+	auto first = ObjectInitializer::ConstructEntity<Hive>();
+	auto second = ObjectInitializer::ConstructEntity<Hive>();
+	auto third = ObjectInitializer::ConstructEntity<Hive>();
+
+	// Leaves a hole between the bees of the first and third hives
+	ObjectInitializer::DestroyEntity(second);
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	EXPECT_EQ(first->ticks, 5);
+	EXPECT_EQ(Bee::batch_calls, 10);
+	EXPECT_EQ(third->bees.back()->ticks, 5);
+
+	// Compaction closes the hole, so bees are back to a single batch
+	Core::Compact();
+	Bee::batch_calls = 0;
+	first->ticks = 0;
+
+	async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	EXPECT_EQ(Bee::batch_calls, 5);
+
+	Core::Destroy();
+}
+
+
+struct Pebble {};
+
+
+struct Nest
+{
+	PObject ant;
+	PObject pebble;
+
+	Nest()
+	{
+		ObjectInitializer::ConstructPObject<Ant>(&ant);
+		ObjectInitializer::ConstructPObject<Pebble>(&pebble);
+	}
+
+	void Tick()
+	{
+		if (++ticks == 5)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+};
+
+
+TEST(BatchDispatchTest, PObjectsAreTickedInBatches)
+{
+	Core::Initialize();
+
+	auto first = ObjectInitializer::ConstructEntity<Nest>();
+	auto second = ObjectInitializer::ConstructEntity<Nest>();
+	auto third = ObjectInitializer::ConstructEntity<Nest>();
+
+	// Unregisters the ant of the second nest from its batch
+	ObjectInitializer::DestroyEntity(second);
+
+	// Moves the nests but not the objects owned by their PObjects
+	Core::Compact();
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	EXPECT_EQ(first->ticks, 5);
+	EXPECT_EQ(first->ant.StaticCast<Ant>()->ticks, 5);
+	EXPECT_EQ(third->ant.StaticCast<Ant>()->ticks, 5);
+
+	// Re-assigned PObjects are ticked for what they hold now
+	first->ant = Ant();
+	third->ant = Pebble();
+	first->ticks = 0;
+	third->ticks = 0;
+
+	async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	EXPECT_EQ(first->ant.StaticCast<Ant>()->ticks, 5);
+
+	Core::Destroy();
+}
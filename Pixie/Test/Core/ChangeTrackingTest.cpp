@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Position
+{
+	using change_tracking = TrackChanges;
+
+	float x = 0.0f;
+};
+
+
+struct Mover
+{
+	Handle<Position> position;
+
+	Mover()
+	{
+		position = ObjectInitializer::ConstructComponent<Position>();
+	}
+
+	void Tick()
+	{
+		++ticks;
+
+		// Moves on even frames only
+		if (ticks % 2 == 0)
+		{
+			position->x += 1.0f;
+			Core::MarkChanged(position);
+		}
+
+		if (ticks == 4)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+};
+
+
+TEST(ChangeTrackingTest, ChangeLog)
+{
+	ChangeLog log;
+
+	log.Record(0, 0, 1);
+	log.Record(1, 0, 1);
+	log.Record(0, 0, 1);
+	log.Record(2, 0, 2);
+	log.Record(0, 0, 3);
+
+	std::vector<uint32_t> changed;
+	log.ForEachSince(1, [&](uint32_t index, uint32_t) { changed.push_back(index); });
+
+	// Slot 0 shows up once, at its last change
+	EXPECT_EQ(changed, (std::vector<uint32_t>{2, 0}));
+	EXPECT_EQ(log.LastChange(0, 0), 3u);
+	EXPECT_EQ(log.LastChange(0, 1), 0u);
+	EXPECT_EQ(log.LastChange(7, 0), 0u);
+
+	// Superseded entries are eventually dropped
+	for (uint64_t frame = 4; frame < 200; ++frame)
+		log.Record(0, 0, frame);
+
+	EXPECT_LT(log.Size(), 200u);
+
+	changed.clear();
+	log.ForEachSince(0, [&](uint32_t index, uint32_t) { changed.push_back(index); });
+	EXPECT_EQ(changed, (std::vector<uint32_t>{1, 2, 0}));
+}
+
+
+TEST(ChangeTrackingTest, ChangedSinceFrame)
+{
+	Core::Initialize();
+
+	auto first = ObjectInitializer::ConstructEntity<Mover>();
+	auto second = ObjectInitializer::ConstructEntity<Mover>();
+
+	// Construction counts as a change
+	const uint64_t constructed = Core::GetFrame();
+	EXPECT_EQ(Core::ChangedSince<Position>(0).size(), 2u);
+	EXPECT_TRUE(Core::ChangedSince<Position>(constructed).empty());
+
+	// A third entity, destroyed, is never reported
+	auto third = ObjectInitializer::ConstructEntity<Mover>();
+	ObjectInitializer::DestroyEntity(third);
+	EXPECT_EQ(Core::ChangedSince<Position>(0).size(), 2u);
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// Four frames were ticked, the positions changed on the second and fourth
+	EXPECT_EQ(Core::GetFrame(), constructed + 4);
+	EXPECT_EQ(Core::ChangedSince<Position>(constructed + 1).size(), 2u);
+	EXPECT_EQ(Core::ChangedSince<Position>(constructed + 4).size(), 0u);
+	EXPECT_TRUE(Core::HasChangedSince(first->position, constructed + 3));
+	EXPECT_FALSE(Core::HasChangedSince(first->position, constructed + 4));
+
+	// Marking an object again on the same frame doesn't report it twice
+	Core::MarkChanged(second->position);
+	auto changed = Core::ChangedSince<Position>(Core::GetFrame() - 1);
+	ASSERT_EQ(changed.size(), 2u);
+	EXPECT_EQ(changed.back(), second->position);
+
+	Core::Destroy();
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Core/Storage/ComponentTable.h"
+
+using namespace pixie;
+
+struct Sensor
+{
+	int range = 10;
+};
+
+
+struct Motor
+{
+	void Tick() {}
+};
+
+
+struct Battery
+{
+};
+
+
+struct Robot
+{
+	Handle<Sensor> sensor;
+	Handle<Motor> left;
+	Handle<Motor> right;
+
+	Robot()
+	{
+		sensor = ObjectInitializer::ConstructComponent<Sensor>();
+		left = ObjectInitializer::ConstructComponent<Motor>();
+		right = ObjectInitializer::ConstructComponent<Motor>();
+	}
+
+	void Tick() {}
+};
+
+
+template<int N>
+struct Tag {};
+
+
+TEST(ComponentTableTest, TypeIdIsCompileTime)
+{
+	constexpr TypeId sensor = type_id<Sensor>;
+	constexpr TypeId motor = type_id<Motor>;
+
+	static_assert(sensor != motor, "Distinct types must have distinct identifiers");
+	EXPECT_EQ(sensor, HashTypeName(type_traits::experimental::type_name<Sensor>()));
+}
+
+
+TEST(ComponentTableTest, InsertAndFind)
+{
+	ComponentStorage<Sensor> storage;
+	ComponentRef first(storage.Emplace());
+	ComponentRef second(storage.Emplace());
+
+	ComponentTable table;
+	EXPECT_EQ(table.Find(type_id<Sensor>), nullptr);
+
+	EXPECT_TRUE(table.Insert(type_id<Sensor>, first));
+	EXPECT_FALSE(table.Insert(type_id<Sensor>, second));
+
+	// Enough types to make the table grow
+	EXPECT_TRUE(table.Insert(type_id<Tag<0>>, second));
+	EXPECT_TRUE(table.Insert(type_id<Tag<1>>, second));
+	EXPECT_TRUE(table.Insert(type_id<Tag<2>>, second));
+	EXPECT_TRUE(table.Insert(type_id<Tag<3>>, second));
+	EXPECT_TRUE(table.Insert(type_id<Tag<4>>, second));
+
+	EXPECT_EQ(table.Size(), 6u);
+	ASSERT_NE(table.Find(type_id<Sensor>), nullptr);
+	EXPECT_EQ(*table.Find(type_id<Sensor>), first);
+	EXPECT_EQ(*table.Find(type_id<Tag<4>>), second);
+	EXPECT_EQ(table.Find(type_id<Battery>), nullptr);
+}
+
+
+TEST(ComponentTableTest, LookUpSiblings)
+{
+	Core::Initialize();
+
+	auto robot = ObjectInitializer::ConstructEntity<Robot>();
+	auto other = ObjectInitializer::ConstructEntity<Robot>();
+
+	// From the entity
+	EXPECT_EQ(Core::GetComponent<Sensor>(robot), robot->sensor);
+	EXPECT_TRUE(Core::HasComponent<Motor>(robot));
+	EXPECT_FALSE(Core::HasComponent<Battery>(robot));
+
+	// From a sibling component, including back to the entity
+	EXPECT_EQ(Core::GetComponent<Sensor>(robot->left), robot->sensor);
+	EXPECT_EQ(Core::GetComponent<Robot>(robot->right), robot);
+	EXPECT_EQ(Core::GetComponent<Robot>(other->sensor), other);
+
+	// The first of several components of the same type
+	EXPECT_EQ(Core::GetComponent<Motor>(robot), robot->left);
+
+	auto sensor = robot->sensor;
+	ObjectInitializer::DestroyEntity(robot);
+
+	EXPECT_FALSE(Core::GetComponent<Motor>(sensor));
+	EXPECT_FALSE(Core::HasComponent<Robot>(sensor));
+	EXPECT_EQ(Core::GetComponent<Sensor>(other->left), other->sensor);
+
+	Core::Destroy();
+}
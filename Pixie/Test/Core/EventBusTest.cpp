@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <thread>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Ping
+{
+	int sender = 0;
+	int value = 0;
+};
+
+
+struct Pong
+{
+	int value = 0;
+};
+
+
+struct Shooter
+{
+	void Tick()
+	{
+		++ticks;
+		Core::Emit(Ping{0, ticks});
+
+		if (ticks == 3)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+};
+
+
+struct Target
+{
+	void Begin()
+	{
+		Core::Subscribe<Ping>([this](Span<const Ping> pings)
+		{
+			// Delivered after every object has ticked
+			EXPECT_EQ(shooter->ticks, pings[pings.size() - 1].value);
+
+			++batches;
+			for (auto& ping : pings)
+				total += ping.value;
+		});
+	}
+
+	void Tick() {}
+
+	Handle<Shooter> shooter;
+	int batches = 0;
+	int total = 0;
+};
+
+
+TEST(EventBusTest, DeliveredInBatchesAtFlush)
+{
+	EventBus bus;
+
+	std::vector<int> received;
+	uint32_t id = bus.Subscribe<Ping>([&](Span<const Ping> pings)
+	{
+		for (auto& ping : pings)
+			received.push_back(ping.value);
+
+		// Emitted during delivery, delivered at the next flush
+		bus.Emit(Pong{static_cast<int>(pings.size())});
+	});
+
+	int pongs = 0;
+	bus.Subscribe<Pong>([&](Span<const Pong> batch) { pongs += batch[0].value; });
+
+	bus.Emit(Ping{0, 1});
+	bus.Emit(Ping{0, 2});
+	EXPECT_TRUE(received.empty());
+
+	bus.Flush();
+	EXPECT_EQ(received, (std::vector<int>{1, 2}));
+	EXPECT_EQ(pongs, 0);
+
+	bus.Flush();
+	EXPECT_EQ(pongs, 2);
+
+	EXPECT_TRUE(bus.Unsubscribe<Ping>(id));
+	EXPECT_FALSE(bus.Unsubscribe<Ping>(id));
+
+	bus.Emit(Ping{0, 3});
+	bus.Flush();
+	EXPECT_EQ(received.size(), 2u);
+}
+
+
+TEST(EventBusTest, EmitFromManyThreads)
+{
+	EventBus bus;
+
+	std::vector<Ping> received;
+	bus.Subscribe<Ping>([&](Span<const Ping> pings) { received.assign(pings.begin(), pings.end()); });
+
+	constexpr int threads = 4;
+	constexpr int per_thread = 1000;
+
+	std::vector<std::thread> workers;
+	for (int sender = 0; sender < threads; ++sender)
+		workers.emplace_back([&bus, sender]()
+		{
+			for (int i = 0; i < per_thread; ++i)
+				bus.Emit(Ping{sender, i});
+		});
+
+	for (auto& worker : workers)
+		worker.join();
+
+	bus.Flush();
+	ASSERT_EQ(received.size(), static_cast<size_t>(threads * per_thread));
+
+	// The events of each thread are delivered in emission order
+	std::vector<int> next(threads, 0);
+	for (auto& ping : received)
+		EXPECT_EQ(ping.value, next[ping.sender]++);
+}
+
+
+TEST(EventBusTest, SceneFlushesAtPhaseBoundaries)
+{
+	Core::Initialize();
+
+	auto shooter = ObjectInitializer::ConstructEntity<Shooter>();
+	auto target = ObjectInitializer::ConstructEntity<Target>();
+	target->shooter = shooter;
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	EXPECT_EQ(target->batches, 3);
+	EXPECT_EQ(target->total, 1 + 2 + 3);
+
+	Core::Destroy();
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Core/Storage/ComponentStorage.h"
+
+using namespace pixie;
+
+struct Counter
+{
+	Counter() = default;
+
+	explicit Counter(int value) : value(value) {}
+
+	int value = 0;
+};
+
+
+struct Wheel
+{
+	void Tick() { ++spins; }
+
+	int spins = 0;
+};
+
+
+struct Car
+{
+	Handle<Wheel> front;
+	Handle<Wheel> back;
+
+	Car()
+	{
+		front = ObjectInitializer::ConstructComponent<Wheel>();
+		back = ObjectInitializer::ConstructComponent<Wheel>();
+	}
+
+	void Tick() {}
+};
+
+
+TEST(HandleTest, NullHandle)
+{
+	Handle<Counter> handle;
+
+	EXPECT_FALSE(handle.IsValid());
+	EXPECT_FALSE(handle);
+	EXPECT_EQ(handle.Get(), nullptr);
+}
+
+
+TEST(HandleTest, ResolveToStoredObject)
+{
+	ComponentStorage<Counter> storage;
+
+	auto handle = storage.Emplace(42);
+
+	ASSERT_TRUE(handle.IsValid());
+	EXPECT_EQ(handle->value, 42);
+	EXPECT_EQ(storage.Size(), 1u);
+
+	handle->value = 7;
+	EXPECT_EQ((*handle).value, 7);
+}
+
+
+TEST(HandleTest, StaleHandleAfterErase)
+{
+	ComponentStorage<Counter> storage;
+
+	auto old_handle = storage.Emplace(1);
+	EXPECT_TRUE(storage.Erase(old_handle));
+
+	EXPECT_FALSE(old_handle.IsValid());
+	EXPECT_EQ(old_handle.Get(), nullptr);
+
+	// erasing twice is a no-op
+	EXPECT_FALSE(storage.Erase(old_handle));
+
+	// The slot is recycled for the next object but with a new generation
+	auto new_handle = storage.Emplace(2);
+	EXPECT_EQ(new_handle.GetIndex(), old_handle.GetIndex());
+	EXPECT_NE(new_handle.GetGeneration(), old_handle.GetGeneration());
+
+	EXPECT_FALSE(old_handle.IsValid());
+	EXPECT_EQ(new_handle->value, 2);
+}
+
+
+TEST(HandleTest, GrowingStorageDoesNotMoveObjects)
+{
+	ComponentStorage<Counter> storage;
+
+	auto handle = storage.Emplace(3);
+	Counter* address = handle.Get();
+
+	for (int i = 0; i < 10000; ++i)
+		storage.Emplace(i);
+
+	EXPECT_EQ(handle.Get(), address);
+	EXPECT_EQ(handle->value, 3);
+}
+
+
+TEST(HandleTest, RelocateKeepsHandlesValid)
+{
+	ComponentStorage<Counter> storage;
+
+	std::vector<Handle<Counter>> handles;
+	for (int i = 0; i < 8; ++i)
+		handles.push_back(storage.Emplace(i));
+
+	// Punch holes in the storage
+	storage.Erase(handles[1]);
+	storage.Erase(handles[4]);
+	storage.Erase(handles[6]);
+
+	// Request a reversed memory order of the remaining objects
+	std::vector<uint32_t> order;
+	for (int i : {7, 5, 3, 2, 0})
+		order.push_back(handles[i].GetIndex());
+
+	std::vector<Relocation> relocations;
+	storage.Relocate(order, relocations);
+
+	EXPECT_EQ(storage.Size(), 5u);
+	EXPECT_EQ(storage.Extent(), 5u);
+	EXPECT_EQ(relocations.size(), 5u);
+
+	// Objects are contiguous and laid out in the requested order
+	Counter* first = handles[7].Get();
+	EXPECT_EQ(handles[5].Get(), first + 1);
+	EXPECT_EQ(handles[3].Get(), first + 2);
+	EXPECT_EQ(handles[2].Get(), first + 3);
+	EXPECT_EQ(handles[0].Get(), first + 4);
+
+	for (int i : {7, 5, 3, 2, 0})
+		EXPECT_EQ(handles[i]->value, i);
+
+	EXPECT_FALSE(handles[1].IsValid());
+	EXPECT_FALSE(handles[4].IsValid());
+}
+
+
+TEST(HandleTest, DestroyEntityInvalidatesComponents)
+{
+	Core::Initialize();
+
+	auto car = ObjectInitializer::ConstructEntity<Car>();
+	auto other_car = ObjectInitializer::ConstructEntity<Car>();
+
+	ASSERT_TRUE(car.IsValid());
+	auto front = car->front;
+	auto back = car->back;
+
+	EXPECT_TRUE(front.IsValid());
+	EXPECT_TRUE(back.IsValid());
+
+	EXPECT_TRUE(ObjectInitializer::DestroyEntity(car));
+
+	EXPECT_FALSE(car.IsValid());
+	EXPECT_FALSE(front.IsValid());
+	EXPECT_FALSE(back.IsValid());
+
+	// Destroying twice is detected
+	EXPECT_FALSE(ObjectInitializer::DestroyEntity(car));
+
+	// Other entities are left untouched
+	EXPECT_TRUE(other_car.IsValid());
+	EXPECT_TRUE(other_car->front.IsValid());
+
+	Core::Destroy();
+}
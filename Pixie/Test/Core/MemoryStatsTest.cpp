@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Sensor
+{
+	double readings[8] = {};
+};
+
+
+struct Robot
+{
+	Handle<Sensor> left;
+	Handle<Sensor> right;
+
+	Robot()
+	{
+		left = ObjectInitializer::ConstructComponent<Sensor>();
+		right = ObjectInitializer::ConstructComponent<Sensor>();
+	}
+
+	void Tick() {}
+};
+
+
+TEST(MemoryStatsTest, TypeName)
+{
+	EXPECT_EQ(type_traits::experimental::type_name<int>(), "int");
+
+	auto name = type_traits::experimental::type_name<Sensor>();
+	EXPECT_NE(name.find("Sensor"), std::string_view::npos);
+}
+
+
+TEST(MemoryStatsTest, EmptyScene)
+{
+	Core::Initialize();
+
+	auto stats = Core::GetMemoryStats();
+
+	EXPECT_TRUE(stats.types.empty());
+	EXPECT_TRUE(stats.trees.empty());
+	EXPECT_EQ(stats.scene.instances, 0u);
+	EXPECT_EQ(stats.scene.bytes, 0u);
+	EXPECT_EQ(stats.reserved_bytes, 0u);
+
+	Core::Destroy();
+}
+
+
+TEST(MemoryStatsTest, CountPerTypeTreeAndScene)
+{
+	Core::Initialize();
+
+	for (int i = 0; i < 3; ++i)
+		ObjectInitializer::ConstructEntity<Robot>();
+
+	auto stats = Core::GetMemoryStats();
+
+	// Sensors take the most memory, hence they come first
+	ASSERT_EQ(stats.types.size(), 2u);
+	EXPECT_EQ(stats.types[0].type_name, type_traits::experimental::type_name<Sensor>());
+	EXPECT_EQ(stats.types[0].live.instances, 6u);
+	EXPECT_EQ(stats.types[0].live.bytes, 6 * sizeof(Sensor));
+	EXPECT_GE(stats.types[0].reserved_bytes, stats.types[0].live.bytes);
+
+	EXPECT_EQ(stats.types[1].type_name, type_traits::experimental::type_name<Robot>());
+	EXPECT_EQ(stats.types[1].live.instances, 3u);
+	EXPECT_EQ(stats.types[1].live.bytes, 3 * sizeof(Robot));
+
+	ASSERT_EQ(stats.trees.size(), 3u);
+	for (auto& tree : stats.trees)
+	{
+		EXPECT_EQ(tree.live.instances, 3u);
+		EXPECT_EQ(tree.live.bytes, sizeof(Robot) + 2 * sizeof(Sensor));
+	}
+
+	EXPECT_EQ(stats.scene.instances, 9u);
+	EXPECT_EQ(stats.scene.bytes, 3 * sizeof(Robot) + 6 * sizeof(Sensor));
+	EXPECT_EQ(stats.reserved_bytes, stats.types[0].reserved_bytes + stats.types[1].reserved_bytes);
+
+	Core::Destroy();
+}
+
+
+TEST(MemoryStatsTest, DestroyAndCompactReleaseMemory)
+{
+	Core::Initialize();
+
+	std::vector<Handle<Robot>> robots;
+	for (int i = 0; i < 1000; ++i)
+		robots.push_back(ObjectInitializer::ConstructEntity<Robot>());
+
+	auto before = Core::GetMemoryStats();
+
+	for (size_t i = 0; i < 990; ++i)
+		ObjectInitializer::DestroyEntity(robots[i]);
+
+	auto after_destroy = Core::GetMemoryStats();
+	EXPECT_EQ(after_destroy.scene.instances, 30u);
+	EXPECT_EQ(after_destroy.trees.size(), 10u);
+
+	// Destroyed objects leave holes behind until the scene is compacted
+	EXPECT_EQ(after_destroy.reserved_bytes, before.reserved_bytes);
+
+	Core::Compact();
+
+	auto after_compact = Core::GetMemoryStats();
+	EXPECT_EQ(after_compact.scene.instances, 30u);
+	EXPECT_LT(after_compact.reserved_bytes, before.reserved_bytes);
+
+	Core::Destroy();
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Transform
+{
+	float x = 0.0f;
+};
+
+
+struct Velocity
+{
+	float dx = 1.0f;
+};
+
+
+struct Mover
+{
+	Handle<Transform> transform;
+	Handle<Velocity> velocity;
+
+	Mover()
+	{
+		transform = ObjectInitializer::ConstructComponent<Transform>();
+		velocity = ObjectInitializer::ConstructComponent<Velocity>();
+	}
+
+	void Tick() {}
+};
+
+
+struct Statue
+{
+	Handle<Transform> transform;
+
+	Statue()
+	{
+		transform = ObjectInitializer::ConstructComponent<Transform>();
+	}
+};
+
+
+TEST(QueryTest, EmptyScene)
+{
+	Core::Initialize();
+
+	EXPECT_TRUE((Core::Query<Transform, Velocity>().IsEmpty()));
+
+	Core::Destroy();
+}
+
+
+TEST(QueryTest, MatchesEntitiesOwningAllTypes)
+{
+	Core::Initialize();
+
+	std::vector<Handle<Mover>> movers;
+	for (int i = 0; i < 3; ++i)
+	{
+		movers.push_back(ObjectInitializer::ConstructEntity<Mover>());
+		ObjectInitializer::ConstructEntity<Statue>();
+	}
+
+	EXPECT_EQ(Core::Query<Transform>().Size(), 6u);
+	EXPECT_EQ((Core::Query<Transform, Velocity>().Size()), 3u);
+	EXPECT_EQ(Core::Query<Statue>().Size(), 3u);
+
+	Core::Query<Transform, Velocity>().ForEach([](Transform& transform, Velocity& velocity)
+	{
+		transform.x += velocity.dx;
+	});
+
+	for (auto& mover : movers)
+		EXPECT_FLOAT_EQ(mover->transform->x, 1.0f);
+
+	// The entity type can be queried along with its components
+	int count = 0;
+	Core::Query<Mover, Transform>().ForEach([&](Mover& mover, Transform& transform)
+	{
+		EXPECT_EQ(mover.transform.Get(), &transform);
+		++count;
+	});
+	EXPECT_EQ(count, 3);
+
+	Core::Destroy();
+}
+
+
+TEST(QueryTest, TablesFollowDestructionAndCompaction)
+{
+	Core::Initialize();
+
+	std::vector<Handle<Mover>> movers;
+	for (int i = 0; i < 10; ++i)
+		movers.push_back(ObjectInitializer::ConstructEntity<Mover>());
+
+	for (size_t i = 0; i < movers.size(); i += 2)
+		ObjectInitializer::DestroyEntity(movers[i]);
+
+	EXPECT_EQ((Core::Query<Transform, Velocity>().Size()), 5u);
+
+	Core::Compact();
+
+	Core::Query<Mover, Transform, Velocity>().ForEach([](Mover& mover, Transform& transform, Velocity& velocity)
+	{
+		EXPECT_EQ(mover.transform.Get(), &transform);
+		EXPECT_EQ(mover.velocity.Get(), &velocity);
+	});
+
+	Core::Destroy();
+}
@@ -29,7 +29,7 @@ struct C5
 {
 	bool print_message = true;
 
-	C6* c6;
+	Handle<C6> c6;
 
 	C5()
 	{
@@ -71,7 +71,7 @@ struct C4
 
 struct C3
 {
-	C4* c4;
+	Handle<C4> c4;
 	bool print_message = true;
 
 	C3()
@@ -116,8 +116,8 @@ struct C2
 
 struct C1
 {
-	C2* c2;
-	C3* c3;
+	Handle<C2> c2;
+	Handle<C3> c3;
 	bool print_message = true;
 
 	C1()
@@ -151,8 +151,8 @@ struct C1
 class Agent1
 {
 public:
-	C1* c1;
-	C5* c5;
+	Handle<C1> c1;
+	Handle<C5> c5;
 	bool print_message = true;
 
 	Agent1()
@@ -183,8 +183,8 @@ public:
 class Agent2
 {
 public:
-	C3* c3;
-	C1* c1;
+	Handle<C3> c3;
+	Handle<C1> c1;
 
 	bool print_message = true;
 
@@ -295,7 +295,7 @@ TEST(SceneForestTest, VerifyReturnPointerRemainsValid)
 {
 	Core::Initialize();
 
-	auto* agent1 = ObjectInitializer::ConstructEntity<Agent1>();
+	auto agent1 = ObjectInitializer::ConstructEntity<Agent1>();
 
 	EXPECT_EQ(agent1->c1->num, 0);
 
@@ -304,7 +304,7 @@ TEST(SceneForestTest, VerifyReturnPointerRemainsValid)
 	// construct a bunch of more objects
 	for (int i = 0; i < 1000; ++i)
 	{
-		auto* temp = ObjectInitializer::ConstructEntity<Agent1>();
+		auto temp = ObjectInitializer::ConstructEntity<Agent1>();
 		temp->print_message = false;
 	}
 
@@ -420,4 +420,45 @@ TEST(SceneForestTest, ChangeComponentDuringRuntime)
 	);
 
 	EXPECT_EQ(agent3->num, 1);
-}
\ No newline at end of file
+}
+
+
+TEST(SceneForestTest, CompactAfterDestroyingEntities)
+{
+	Core::Initialize();
+
+	std::vector<Handle<Agent3>> agents;
+	for (int i = 0; i < 10; ++i)
+		agents.push_back(ObjectInitializer::ConstructEntity<Agent3>());
+
+	// Despawn every other agent to fragment the storage
+	for (size_t i = 0; i < agents.size(); i += 2)
+		EXPECT_TRUE(ObjectInitializer::DestroyEntity(agents[i]));
+
+	auto survivor = agents.back();
+	Agent3* old_address = survivor.Get();
+
+	Core::Compact();
+
+	// The survivor is still reachable through its handle but not at its old
+	// address since the storage is now packed
+	ASSERT_TRUE(survivor.IsValid());
+	EXPECT_NE(survivor.Get(), old_address);
+	EXPECT_EQ(agents[1].Get() + 1, agents[3].Get());
+
+	::testing::internal::CaptureStdout();
+
+	// Begin goes through the PObjects registered in the trees. They must
+	// have followed their outer agents
+	auto async_engine = StartAsync();
+	async_engine.wait_for(std::chrono::milliseconds{100});
+	Core::Shutdown();
+	async_engine.wait_for(std::chrono::milliseconds{50});
+
+	testing::internal::GetCapturedStdout();
+
+	for (size_t i = 1; i < agents.size(); i += 2)
+		EXPECT_EQ(agents[i]->num, 1);
+
+	Core::Destroy();
+}
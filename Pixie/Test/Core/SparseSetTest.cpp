@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+struct Stunned
+{
+	using storage_policy = SparseStorage;
+
+	Stunned() = default;
+	explicit Stunned(int frames) : frames(frames) {}
+
+	void Tick() { ++ticks; }
+
+	int frames = 0;
+	int ticks = 0;
+};
+
+
+struct Shield
+{
+	using storage_policy = SparseStorage;
+
+	float strength = 1.0f;
+};
+
+
+struct Sword
+{
+};
+
+
+struct Knight
+{
+	Handle<Sword> sword;
+
+	Knight()
+	{
+		sword = ObjectInitializer::ConstructComponent<Sword>();
+	}
+
+	void Tick()
+	{
+		++ticks;
+
+		// Removed while Tick is being dispatched
+		if (ticks == 2)
+			Core::RemoveComponent<Stunned>(self);
+
+		if (ticks == 5)
+			Core::Shutdown();
+	}
+
+	Handle<Knight> self;
+	int ticks = 0;
+};
+
+
+TEST(SparseSetTest, AddRemoveKeepsComponentsPacked)
+{
+	SparseSet<Stunned> set;
+
+	set.Add({0, 3}, 1);
+	set.Add({0, 7}, 2);
+	set.Add({1, 0}, 3);
+
+	EXPECT_EQ(set.Size(), 3u);
+	EXPECT_EQ(set.Find({0, 7})->frames, 2);
+	EXPECT_EQ(set.Find({0, 4}), nullptr);
+
+	// Replaces the current component
+	set.Add({0, 7}, 5);
+	EXPECT_EQ(set.Size(), 3u);
+	EXPECT_EQ(set.Find({0, 7})->frames, 5);
+
+	// The last component fills the hole
+	EXPECT_TRUE(set.Remove({0, 3}));
+	EXPECT_FALSE(set.Remove({0, 3}));
+	EXPECT_EQ(set.Size(), 2u);
+	EXPECT_EQ(set.Find({1, 0})->frames, 3);
+	EXPECT_EQ(set.GetOwners().front(), (EntityKey{1, 0}));
+
+	auto all = set.GetAll();
+	EXPECT_EQ(all.size(), 2u);
+	EXPECT_EQ(&all[0] + 1, &all[1]);
+	EXPECT_EQ(set.GetMemoryAccount().live.instances, 2u);
+}
+
+
+TEST(SparseSetTest, AttachAtRuntime)
+{
+	Core::Initialize();
+
+	auto knight = ObjectInitializer::ConstructEntity<Knight>();
+	auto other = ObjectInitializer::ConstructEntity<Knight>();
+
+	EXPECT_FALSE(Core::HasComponent<Shield>(knight));
+
+	// From the entity or from any of its components
+	ASSERT_NE(Core::AddComponent<Shield>(knight->sword), nullptr);
+	EXPECT_TRUE(Core::HasComponent<Shield>(knight));
+	EXPECT_FALSE(Core::HasComponent<Shield>(other));
+	EXPECT_EQ(Core::GetComponent<Shield>(knight)->strength, 1.0f);
+
+	// Dense lookups are unaffected
+	EXPECT_EQ(Core::GetComponent<Sword>(knight), knight->sword);
+
+	EXPECT_TRUE(Core::RemoveComponent<Shield>(knight));
+	EXPECT_FALSE(Core::RemoveComponent<Shield>(knight));
+	EXPECT_EQ(Core::GetComponent<Shield>(knight), nullptr);
+
+	// Destroying the entity destroys its sparse components
+	Core::AddComponent<Shield>(knight);
+	Core::AddComponent<Shield>(other);
+	ObjectInitializer::DestroyEntity(knight);
+
+	EXPECT_EQ(Core::GetComponent<Shield>(knight), nullptr);
+	EXPECT_NE(Core::GetComponent<Shield>(other), nullptr);
+	EXPECT_EQ(Core::AddComponent<Shield>(knight), nullptr);
+
+	Core::Destroy();
+}
+
+
+TEST(SparseSetTest, TickAndDeferredRemoval)
+{
+	Core::Initialize();
+
+	auto stunned = ObjectInitializer::ConstructEntity<Knight>();
+	auto free = ObjectInitializer::ConstructEntity<Knight>();
+	stunned->self = stunned;
+
+	Core::AddComponent<Stunned>(stunned, 3);
+	Core::AddComponent<Stunned>(free, 3);
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// The removal issued on the second frame is applied once the frame is
+	// over, the other knight stays stunned
+	EXPECT_FALSE(Core::HasComponent<Stunned>(stunned));
+	ASSERT_TRUE(Core::HasComponent<Stunned>(free));
+	EXPECT_EQ(Core::GetComponent<Stunned>(free)->ticks, 5);
+
+	Core::Destroy();
+}
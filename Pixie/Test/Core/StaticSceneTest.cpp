@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Core/Scene/StaticScene.h"
+
+using namespace pixie;
+
+struct Particle
+{
+	Particle() = default;
+
+	Particle(float position, float velocity)
+			: position(position), velocity(velocity)
+	{}
+
+	void Tick() { position += velocity; }
+
+	float position = 0.0f;
+	float velocity = 0.0f;
+};
+
+
+struct Wall
+{
+	void Begin() { ++begin_count; }
+
+	void End() { ++end_count; }
+
+	int begin_count = 0;
+	int end_count = 0;
+};
+
+
+struct Stopwatch
+{
+	void Tick()
+	{
+		++ticks;
+
+		if (ticks == 10)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+};
+
+
+TEST(StaticSceneTest, AddAndAccessObjects)
+{
+	StaticScene<Particle, Wall> scene;
+
+	auto first = scene.Add<Particle>(1.0f, 2.0f);
+	auto second = scene.Add<Particle>();
+	scene.Add<Wall>();
+
+	EXPECT_EQ(first, 0u);
+	EXPECT_EQ(second, 1u);
+	EXPECT_EQ(scene.Size(), 3u);
+	EXPECT_EQ(scene.GetAll<Particle>().size(), 2u);
+	EXPECT_EQ(scene.GetAll<Wall>().size(), 1u);
+	EXPECT_FLOAT_EQ(scene.Get<Particle>(first).velocity, 2.0f);
+}
+
+
+TEST(StaticSceneTest, DispatchOnlyImplementedPhases)
+{
+	StaticScene<Particle, Wall> scene;
+
+	for (int i = 0; i < 100; ++i)
+		scene.Add<Particle>(0.0f, static_cast<float>(i));
+
+	scene.Add<Wall>();
+
+	scene.BeginObjects();
+	for (int i = 0; i < 3; ++i)
+		scene.TickObjects();
+	scene.EndObjects();
+
+	auto& particles = scene.GetAll<Particle>();
+	for (size_t i = 0; i < particles.size(); ++i)
+		EXPECT_FLOAT_EQ(particles[i].position, 3.0f * i);
+
+	EXPECT_EQ(scene.Get<Wall>(0).begin_count, 1);
+	EXPECT_EQ(scene.Get<Wall>(0).end_count, 1);
+}
+
+
+TEST(StaticSceneTest, MixedWithDynamicScene)
+{
+	Core::Initialize();
+
+	auto stopwatch = ObjectInitializer::ConstructEntity<Stopwatch>();
+
+	auto* static_scene = ObjectInitializer::ConstructStaticScene<Particle, Wall>();
+	ASSERT_NE(static_scene, nullptr);
+
+	static_scene->Add<Particle>(0.0f, 1.0f);
+	static_scene->Add<Wall>();
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// Static objects are ticked in the same frames as the dynamic ones
+	EXPECT_EQ(stopwatch->ticks, 10);
+	EXPECT_FLOAT_EQ(static_scene->Get<Particle>(0).position, 10.0f);
+	EXPECT_EQ(static_scene->Get<Wall>(0).begin_count, 1);
+	EXPECT_EQ(static_scene->Get<Wall>(0).end_count, 1);
+
+	Core::Destroy();
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+
+using namespace pixie;
+
+namespace
+{
+
+void ExpectNear(const Vec3& a, const Vec3& b)
+{
+	EXPECT_NEAR(a.x, b.x, 1e-4f);
+	EXPECT_NEAR(a.y, b.y, 1e-4f);
+	EXPECT_NEAR(a.z, b.z, 1e-4f);
+}
+
+const float pi = 3.14159265f;
+
+} // namespace
+
+
+struct Hand
+{
+	Hand()
+	{
+		transform = ObjectInitializer::ConstructComponent<Transform3D>();
+		transform->SetPosition({1.0f, 0.0f, 0.0f});
+	}
+
+	Handle<Transform3D> transform;
+};
+
+
+struct Arm
+{
+	Arm()
+	{
+		transform = ObjectInitializer::ConstructComponent<Transform3D>();
+		transform->SetPosition({2.0f, 0.0f, 0.0f});
+		hand = ObjectInitializer::ConstructComponent<Hand>();
+	}
+
+	Handle<Transform3D> transform;
+	Handle<Hand> hand;
+};
+
+
+/** Has no transform of its own: its sensor follows the robot */
+struct Mount
+{
+	Mount()
+	{
+		sensor = ObjectInitializer::ConstructComponent<Transform3D>();
+		sensor->SetPosition({0.0f, 0.0f, 1.0f});
+	}
+
+	Handle<Transform3D> sensor;
+};
+
+
+struct Robot
+{
+	Robot()
+	{
+		arm = ObjectInitializer::ConstructComponent<Arm>();
+		transform = ObjectInitializer::ConstructComponent<Transform3D>();
+		mount = ObjectInitializer::ConstructComponent<Mount>();
+	}
+
+	void Tick()
+	{
+		++ticks;
+
+		// Drive forward and turn left a quarter, then only move the hand
+		if (ticks == 1)
+		{
+			transform->SetPosition({10.0f, 0.0f, 0.0f});
+			transform->SetRotation(Quat::FromAxisAngle({0.0f, 0.0f, 1.0f}, 0.5f * pi));
+		}
+		else if (ticks == 2)
+		{
+			arm->hand->transform->SetPosition({0.0f, 1.0f, 0.0f});
+		}
+		else
+		{
+			Core::Shutdown();
+		}
+	}
+
+	Handle<Transform3D> transform;
+	Handle<Arm> arm;
+	Handle<Mount> mount;
+	int ticks = 0;
+};
+
+
+struct Observer
+{
+	void Tick()
+	{
+		// The game manager sees the world matrices of this frame
+		hand_positions.push_back(robot->arm->hand->transform->GetWorldPosition());
+	}
+
+	Handle<Robot> robot;
+	std::vector<Vec3> hand_positions{};
+};
+
+
+TEST(Transform3DTest, WorldFollowsOuterObjects)
+{
+	Core::Initialize();
+
+	auto robot = ObjectInitializer::ConstructEntity<Robot>();
+	auto* observer = ObjectInitializer::ConstructGameManager<Observer>();
+	observer->robot = robot;
+
+	// Up to date as soon as the entity is constructed, whatever the order the transforms were created in
+	ExpectNear(robot->arm->transform->GetWorldPosition(), {2.0f, 0.0f, 0.0f});
+	ExpectNear(robot->arm->hand->transform->GetWorldPosition(), {3.0f, 0.0f, 0.0f});
+	ExpectNear(robot->mount->sensor->GetWorldPosition(), {0.0f, 0.0f, 1.0f});
+	EXPECT_FALSE(robot->transform->IsDirty());
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	ASSERT_EQ(observer->hand_positions.size(), 3u);
+	ExpectNear(observer->hand_positions[0], {10.0f, 3.0f, 0.0f});
+
+	// Moved alone, the hand still follows the turned robot
+	ExpectNear(observer->hand_positions[1], {9.0f, 2.0f, 0.0f});
+	ExpectNear(observer->hand_positions[2], {9.0f, 2.0f, 0.0f});
+
+	ExpectNear(robot->arm->transform->GetWorldPosition(), {10.0f, 2.0f, 0.0f});
+	ExpectNear(robot->mount->sensor->GetWorldPosition(), {10.0f, 0.0f, 1.0f});
+	EXPECT_FALSE(robot->arm->hand->transform->IsDirty());
+
+	Core::Destroy();
+}
@@ -0,0 +1,153 @@
+/*
+ * Drives an environment through the C API only, the way ctypes or cffi do
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "Pixie/Environment/CApi.h"
+
+/* Registers the "Walk" environment, see CApiTestEnvironment.cpp */
+void RegisterWalkEnvironment(void);
+
+static int failures = 0;
+
+#define CHECK(condition)                                                    \
+	do                                                                      \
+	{                                                                       \
+		if (!(condition))                                                   \
+		{                                                                   \
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			++failures;                                                     \
+		}                                                                   \
+	} while (0)
+
+#define BATCH 4
+
+
+static void TestErrors(void)
+{
+	pixie_env* env = NULL;
+	CHECK(pixie_create("Missing", BATCH, &env) == PIXIE_ERROR_UNKNOWN_ENVIRONMENT);
+	CHECK(env == NULL);
+	CHECK(strlen(pixie_last_error()) > 0);
+
+	CHECK(pixie_create("Walk", 0, &env) == PIXIE_ERROR_INVALID_ARGUMENT);
+	CHECK(pixie_step(NULL, NULL, NULL) == PIXIE_ERROR_INVALID_ARGUMENT);
+	pixie_destroy(NULL);
+}
+
+
+static void TestFields(pixie_env* env)
+{
+	pixie_field field;
+
+	CHECK(pixie_batch_size(env) == BATCH);
+	CHECK(pixie_field_count(env, PIXIE_OBSERVATIONS) == 2);
+	CHECK(pixie_field_count(env, PIXIE_ACTIONS) == 1);
+
+	CHECK(pixie_get_field(env, PIXIE_OBSERVATIONS, 0, &field) == PIXIE_OK);
+	CHECK(strcmp(field.name, "position") == 0);
+	CHECK(field.kind == PIXIE_BOX);
+	CHECK(field.low == -100.0f && field.high == 100.0f);
+	CHECK(field.byte_size == BATCH * sizeof(float));
+	CHECK(field.tensor.code == 2 && field.tensor.bits == 32 && field.tensor.lanes == 1);
+	CHECK(field.tensor.ndim == 2);
+	CHECK(field.tensor.shape[0] == BATCH && field.tensor.shape[1] == 1);
+	CHECK(field.tensor.strides[0] == 1 && field.tensor.strides[1] == 1);
+
+	CHECK(pixie_get_field(env, PIXIE_OBSERVATIONS, 1, &field) == PIXIE_OK);
+	CHECK(strcmp(field.name, "reward") == 0);
+	CHECK(field.tensor.ndim == 1);
+
+	CHECK(pixie_get_field(env, PIXIE_ACTIONS, 0, &field) == PIXIE_OK);
+	CHECK(strcmp(field.name, "move") == 0);
+	CHECK(field.kind == PIXIE_DISCRETE);
+	CHECK(field.count_size == 1 && field.counts[0] == 3);
+	CHECK(field.tensor.code == 0);
+
+	CHECK(pixie_get_field(env, PIXIE_ACTIONS, 1, &field) == PIXIE_ERROR_INVALID_ARGUMENT);
+}
+
+
+static void TestStep(pixie_env* env)
+{
+	float position[BATCH];
+	float reward[BATCH];
+	int32_t move[BATCH] = {2, 2, 1, 0};
+	void* observations[2] = {position, reward};
+	const void* actions[1] = {move};
+	pixie_field field;
+	int step;
+
+	CHECK(pixie_reset(env, observations) == PIXIE_OK);
+	CHECK(position[0] == 0.0f && position[3] == 0.0f);
+
+	for (step = 0; step < 3; ++step)
+		CHECK(pixie_step(env, actions, observations) == PIXIE_OK);
+
+	CHECK(position[0] == 3.0f && position[1] == 3.0f && position[2] == 0.0f && position[3] == -3.0f);
+	CHECK(reward[0] == 1.0f && reward[1] == 1.0f && reward[2] == 0.0f && reward[3] == 0.0f);
+
+	/* The tensor views the storage the objects write to */
+	CHECK(pixie_get_field(env, PIXIE_OBSERVATIONS, 0, &field) == PIXIE_OK);
+	CHECK(memcmp(field.tensor.data, position, sizeof(position)) == 0);
+
+	/* Null buffers keep the previous actions and skip the observations */
+	CHECK(pixie_step(env, NULL, NULL) == PIXIE_OK);
+	CHECK(((const float*)field.tensor.data)[0] == 4.0f);
+
+	CHECK(pixie_reset(env, observations) == PIXIE_OK);
+	CHECK(position[0] == 0.0f && reward[0] == 0.0f);
+}
+
+
+static void ReportStepTime(pixie_env* env)
+{
+	float position[BATCH];
+	float reward[BATCH];
+	int32_t move[BATCH] = {1, 1, 1, 1};
+	void* observations[2] = {position, reward};
+	const void* actions[1] = {move};
+	const int steps = 100000;
+	clock_t start;
+	int step;
+
+	start = clock();
+	for (step = 0; step < steps; ++step)
+		pixie_step(env, actions, observations);
+
+	printf("pixie_step: %.0f ns per call with a batch of %d\n",
+		   1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / steps, BATCH);
+}
+
+
+int main(void)
+{
+	pixie_env* env = NULL;
+	pixie_env* other = NULL;
+
+	RegisterWalkEnvironment();
+	TestErrors();
+
+	CHECK(pixie_create("Walk", BATCH, &env) == PIXIE_OK);
+	if (!env)
+		return 1;
+
+	CHECK(pixie_create("Walk", BATCH, &other) == PIXIE_ERROR_BUSY);
+
+	TestFields(env);
+	TestStep(env);
+	ReportStepTime(env);
+	pixie_destroy(env);
+
+	/* The core is free again once the environment is destroyed */
+	CHECK(pixie_create("Walk", 2, &other) == PIXIE_OK);
+	CHECK(pixie_batch_size(other) == 2);
+	pixie_destroy(other);
+
+	if (failures)
+		fprintf(stderr, "%d checks failed\n", failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,62 @@
+#include <vector>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Environment/EnvironmentRegistry.h"
+
+using namespace pixie;
+
+/**
+ * Batch of walkers on a line, each moved left, not at all or right by its
+ * action and rewarded once it stands on the goal
+ */
+class WalkGame
+{
+public:
+	static constexpr int goal = 3;
+
+	void Begin()
+	{
+		SpaceBuffer& observations = *ObjectInitializer::GetObservations();
+		positions.assign(observations.BatchSize(), 0);
+		Observe();
+	}
+
+	void Tick()
+	{
+		const Span<const int32_t> moves = static_cast<const SpaceBuffer&>(*ObjectInitializer::GetActions()).Get<int32_t>(0);
+		for (size_t i = 0; i < positions.size(); ++i)
+			positions[i] += moves[i] - 1;
+
+		Observe();
+	}
+
+private:
+	/** Stores the observations of the walkers straight into the buffer */
+	void Observe()
+	{
+		SpaceBuffer& observations = *ObjectInitializer::GetObservations();
+		const Span<float> position = observations.Get<float>(0);
+		const Span<float> reward = observations.Get<float>(1);
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			position[i] = static_cast<float>(positions[i]);
+			reward[i] = positions[i] == goal ? 1.0f : 0.0f;
+		}
+	}
+
+	std::vector<int> positions{};
+};
+
+
+extern "C" void RegisterWalkEnvironment(void)
+{
+	EnvironmentRegistry::Register("Walk", [](size_t)
+	{
+		ObjectInitializer::GetObservations()->Add("position", Space::Box({1}, -100.0f, 100.0f));
+		ObjectInitializer::GetObservations()->Add("reward", Space::Box({}));
+		ObjectInitializer::GetActions()->Add("move", Space::Discrete(3));
+
+		ObjectInitializer::ConstructGameManager<WalkGame>();
+	});
+}
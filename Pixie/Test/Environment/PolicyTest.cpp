@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Environment/Policy.h"
+
+using namespace pixie;
+
+
+/**
+ * Agent that walks toward a target chosen by the policy, one slot of the
+ * scene buffers per agent
+ */
+class Walker
+{
+public:
+	static constexpr size_t observation = 0;
+	static constexpr size_t step = 0;
+
+	Walker() : slot(next_slot++), position(static_cast<float>(slot)) {}
+
+	void Begin() { Gather(); }
+
+	void Tick()
+	{
+		// Scatter: the action decided between the frames for this agent
+		position += ObjectInitializer::GetActions()->Get<float>(step, slot)[0];
+		Gather();
+	}
+
+	/** Stores the observation of the agent in its slot */
+	void Gather()
+	{
+		ObjectInitializer::GetObservations()->Get<float>(observation, slot)[0] = position;
+	}
+
+	static size_t next_slot;
+
+	size_t slot;
+	float position;
+};
+
+size_t Walker::next_slot = 0;
+
+
+TEST(PolicyTest, PolicySeesTheWholeBatchBetweenFrames)
+{
+	constexpr size_t agent_count = 5;
+	constexpr float target = 10.0f;
+
+	Core::Initialize();
+	Walker::next_slot = 0;
+
+	ObjectInitializer::GetObservations()->Resize(agent_count);
+	ObjectInitializer::GetObservations()->Add("position", Space::Box({1}));
+	ObjectInitializer::GetActions()->Resize(agent_count);
+	ObjectInitializer::GetActions()->Add("step", Space::Box({1}, -1.0f, 1.0f));
+
+	std::vector<Handle<Walker>> walkers;
+	for (size_t i = 0; i < agent_count; ++i)
+		walkers.push_back(ObjectInitializer::ConstructEntity<Walker>());
+
+	// Moves every agent one unit toward the target, in one pass over the batch
+	std::vector<size_t> batch_sizes;
+	Core::SetPolicy([&](const SpaceBuffer& observations, SpaceBuffer& actions)
+	{
+		const Span<const float> positions = observations.Get<float>(Walker::observation);
+		const Span<float> steps = actions.Get<float>(Walker::step);
+		for (size_t i = 0; i < positions.size(); ++i)
+			steps[i] = std::max(-1.0f, std::min(1.0f, target - positions[i]));
+
+		batch_sizes.push_back(positions.size());
+	});
+
+	// Begin gathers the first observations and infers the first actions
+	Core::Begin();
+	ASSERT_EQ(batch_sizes.size(), 1u);
+	EXPECT_EQ(ObjectInitializer::GetActions()->Get<float>(Walker::step, 0)[0], 1.0f);
+
+	for (int frame = 0; frame < 3; ++frame)
+		Core::Step();
+
+	EXPECT_EQ(batch_sizes, std::vector<size_t>(4, agent_count));
+	for (size_t i = 0; i < agent_count; ++i)
+		EXPECT_EQ(walkers[i]->position, static_cast<float>(i) + 3.0f);
+
+	// Agents on the target stay put, the others keep walking
+	for (int frame = 0; frame < 10; ++frame)
+		Core::Step();
+
+	for (size_t i = 0; i < agent_count; ++i)
+		EXPECT_EQ(walkers[i]->position, target);
+
+	// Without a policy, the last actions are kept
+	Core::SetPolicy({});
+	Core::Step();
+	EXPECT_EQ(batch_sizes.size(), 14u);
+
+	Core::End();
+	Core::Destroy();
+}
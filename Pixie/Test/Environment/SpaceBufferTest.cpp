@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Environment/SpaceBuffer.h"
+#include "Pixie/Grid/GridWorld.h"
+
+using namespace pixie;
+
+
+TEST(SpaceBufferTest, SpacesContainTheirSamples)
+{
+	const Space box = Space::Box({2, 3}, -1.0f, 1.0f);
+	const Space discrete = Space::Discrete(4);
+	const Space multi = Space::MultiDiscrete({3, 2, 5});
+
+	EXPECT_EQ(box.ElementCount(), 6u);
+	EXPECT_EQ(box.GetType(), TensorType::Float32());
+	EXPECT_TRUE(discrete.GetShape().empty());
+	EXPECT_EQ(discrete.ElementCount(), 1u);
+	EXPECT_EQ(multi.GetShape(), std::vector<int64_t>{3});
+	EXPECT_EQ(multi.GetType(), TensorType::Int32());
+	EXPECT_THROW(Space::Discrete(0), std::invalid_argument);
+
+	std::mt19937 random(7);
+	float floats[6];
+	int32_t ints[3];
+	for (int i = 0; i < 100; ++i)
+	{
+		box.Sample(random, floats);
+		EXPECT_TRUE(box.Contains(floats));
+		discrete.Sample(random, ints);
+		EXPECT_TRUE(discrete.Contains(ints));
+		multi.Sample(random, ints);
+		EXPECT_TRUE(multi.Contains(ints));
+	}
+
+	floats[4] = 2.0f;
+	EXPECT_FALSE(box.Contains(floats));
+	ints[2] = 5;
+	EXPECT_FALSE(multi.Contains(ints));
+}
+
+
+TEST(SpaceBufferTest, FieldsAreAlignedContiguousTensors)
+{
+	SpaceBuffer buffer(3);
+	const size_t position = buffer.Add("position", Space::Box({2}));
+	const size_t move = buffer.Add("move", Space::MultiDiscrete({3, 3}));
+	const size_t image = buffer.Add("image", Space::Box({2, 4, 5}, 0.0f, 1.0f));
+
+	EXPECT_EQ(buffer.Find("move"), move);
+	EXPECT_EQ(buffer.Find("missing"), SpaceBuffer::npos);
+	EXPECT_THROW(buffer.Add("move", Space::Discrete(2)), std::invalid_argument);
+	EXPECT_THROW(buffer.Get<float>(move), std::invalid_argument);
+
+	for (size_t field = 0; field < buffer.FieldCount(); ++field)
+	{
+		const TensorView tensor = buffer.GetTensor(field);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.data) % SpaceBuffer::alignment, 0u);
+		EXPECT_EQ(tensor.shape[0], 3);
+		EXPECT_EQ(tensor.ElementCount(), 3 * buffer.GetSpace(field).ElementCount());
+	}
+
+	const TensorView tensor = buffer.GetTensor(image);
+	ASSERT_EQ(tensor.ndim, 4);
+	EXPECT_EQ(tensor.shape[1], 2);
+	EXPECT_EQ(tensor.shape[3], 5);
+	EXPECT_EQ(tensor.strides[0], 40);
+	EXPECT_EQ(tensor.strides[2], 5);
+	EXPECT_EQ(tensor.strides[3], 1);
+	EXPECT_EQ(tensor.ByteStride(0), 160);
+
+	// Writes through a row land in the tensor at [agent, channel, y, x]
+	buffer.Get<float>(image, 2)[1 * 20 + 3 * 5 + 4] = 0.5f;
+	buffer.Get<int32_t>(move, 1)[1] = 2;
+	buffer.Get<float>(position, 0)[0] = -3.0f;
+
+	const auto* values = static_cast<const float*>(tensor.data);
+	EXPECT_EQ(values[2 * tensor.strides[0] + 1 * tensor.strides[1] + 3 * tensor.strides[2] + 4], 0.5f);
+	EXPECT_EQ(static_cast<const int32_t*>(buffer.GetTensor(move).data)[1 * 2 + 1], 2);
+	EXPECT_EQ(static_cast<const float*>(buffer.GetTensor(position).data)[0], -3.0f);
+
+	buffer.Clear();
+	EXPECT_EQ(values[2 * 40 + 1 * 20 + 3 * 5 + 4], 0.0f);
+
+	buffer.Resize(5);
+	EXPECT_EQ(buffer.GetTensor(image).shape[0], 5);
+	EXPECT_EQ(buffer.Get<float>(image).size(), 5u * 40u);
+}
+
+
+TEST(SpaceBufferTest, GridObservationsAreStoredInPlace)
+{
+	GridWorld world(8, 8);
+	const size_t walls = world.AddBitLayer();
+	world.GetBitLayer(walls).Set(4, 3, true);
+
+	const std::vector<GridAgent> agents = {{3, 3, Facing::East}, {0, 0, Facing::North}};
+	const int radius = 1;
+
+	SpaceBuffer observations(agents.size());
+	const size_t view = observations.Add("view", Space::Box({static_cast<int64_t>(world.ChannelCount()), 3, 3}, 0.0f, 1.0f));
+	ASSERT_EQ(observations.GetSpace(view).ElementCount(), world.ObservationSize(radius));
+
+	world.Observe(Span<const GridAgent>(agents), radius, observations.Get<float>(view));
+
+	std::vector<float> expected(agents.size() * world.ObservationSize(radius));
+	world.Observe(Span<const GridAgent>(agents), radius, Span<float>(expected));
+
+	const Span<const float> stored = static_cast<const SpaceBuffer&>(observations).Get<float>(view);
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), stored.data()));
+	EXPECT_NE(std::find(expected.begin(), expected.end(), 1.0f), expected.end());
+}
+
+
+TEST(SpaceBufferTest, SceneExposesObservationsAndActions)
+{
+	EXPECT_EQ(ObjectInitializer::GetObservations(), nullptr);
+
+	Core::Initialize();
+	SpaceBuffer* observations = ObjectInitializer::GetObservations();
+	SpaceBuffer* actions = ObjectInitializer::GetActions();
+	ASSERT_NE(observations, nullptr);
+	ASSERT_NE(actions, nullptr);
+	EXPECT_NE(observations, actions);
+
+	actions->Resize(4);
+	const size_t move = actions->Add("move", Space::Discrete(5));
+	actions->Get<int32_t>(move, 3)[0] = 4;
+	EXPECT_EQ(ObjectInitializer::GetActions()->Get<int32_t>(move)[3], 4);
+
+	Core::Shutdown();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "Pixie/Grid/GridWorld.h"
+
+using namespace pixie;
+
+
+TEST(GridWorldTest, BitLayerKeepsPaddingClear)
+{
+	BitLayer layer(70, 3);
+	layer.Fill(true);
+	EXPECT_EQ(layer.Count(), 210u);
+	EXPECT_FALSE(layer.Get(70, 0));
+	EXPECT_FALSE(layer.Get(-1, 0));
+
+	layer.Set(69, 2, false);
+	EXPECT_FALSE(layer.Get(69, 2));
+	EXPECT_EQ(layer.Count(), 209u);
+}
+
+
+TEST(GridWorldTest, NeighborCountsMatchBruteForce)
+{
+	// Crosses word boundaries and ends in a partial word
+	std::mt19937 random(5);
+	BitLayer layer(150, 40);
+	for (int y = 0; y < layer.Height(); ++y)
+		for (int x = 0; x < layer.Width(); ++x)
+			layer.Set(x, y, random() % 3 == 0);
+
+	ByteLayer moore(layer.Width(), layer.Height());
+	ByteLayer von_neumann(layer.Width(), layer.Height());
+	CountNeighbors(layer, moore);
+	CountNeighbors(layer, von_neumann, Neighborhood::VonNeumann);
+
+	for (int y = 0; y < layer.Height(); ++y)
+		for (int x = 0; x < layer.Width(); ++x)
+		{
+			int expected_moore = 0;
+			for (int dy = -1; dy <= 1; ++dy)
+				for (int dx = -1; dx <= 1; ++dx)
+					expected_moore += (dx or dy) and layer.Get(x + dx, y + dy);
+
+			const int expected_von_neumann = layer.Get(x - 1, y) + layer.Get(x + 1, y) + layer.Get(x, y - 1) + layer.Get(x, y + 1);
+
+			ASSERT_EQ(moore.Get(x, y), expected_moore) << x << ", " << y;
+			ASSERT_EQ(von_neumann.Get(x, y), expected_von_neumann) << x << ", " << y;
+		}
+
+	// All eight set
+	BitLayer full(3, 3);
+	full.Fill(true);
+	ByteLayer counts(3, 3);
+	CountNeighbors(full, counts);
+	EXPECT_EQ(counts.Get(1, 1), 8);
+}
+
+
+TEST(GridWorldTest, EgocentricCropsRotateWithFacing)
+{
+	GridWorld world(5, 5);
+	const size_t marks = world.AddByteLayer();
+
+	// Tile ahead of a north facing agent at (2, 2), and tile to its east
+	world.GetByteLayer(marks).Set(2, 1, 7);
+	world.GetByteLayer(marks).Set(3, 2, 9);
+
+	const int radius = 1;
+	const size_t ahead = 0 * 3 + 1;
+	const size_t right = 1 * 3 + 2;
+
+	std::vector<GridAgent> agents{{2, 2, Facing::North}, {2, 2, Facing::East}, {2, 2, Facing::West}, {0, 0, Facing::South}};
+	std::vector<uint8_t> observations(agents.size() * world.ObservationSize(radius));
+	world.Observe(Span<const GridAgent>(agents), radius, Span<uint8_t>(observations));
+
+	const uint8_t* north = observations.data();
+	EXPECT_EQ(north[ahead], 7);
+	EXPECT_EQ(north[right], 9);
+
+	const uint8_t* east = north + 9;
+	EXPECT_EQ(east[ahead], 9);
+
+	const uint8_t* west = east + 9;
+	EXPECT_EQ(west[right], 7);
+
+	// Facing south from the corner: only the tiles behind and left of it are on the grid
+	const uint8_t* south = west + 9;
+	EXPECT_EQ(south[ahead], 0);
+}
+
+
+TEST(GridWorldTest, WallsHideWhatIsBehind)
+{
+	GridWorld world(7, 1);
+	const size_t walls = world.AddBitLayer();
+	const size_t items = world.AddByteLayer();
+
+	world.GetBitLayer(walls).Set(4, 0);
+	world.GetByteLayer(items).Fill(1);
+
+	std::vector<GridAgent> agents(64, GridAgent{2, 0, Facing::North});
+	std::vector<float> serial(agents.size() * world.ObservationSize(3));
+	std::vector<float> parallel(serial.size());
+
+	world.Observe(Span<const GridAgent>(agents), 3, Span<float>(serial), nullptr, walls);
+
+	WorkerPool workers(2);
+	world.Observe(Span<const GridAgent>(agents), 3, Span<float>(parallel), &workers, walls);
+	EXPECT_EQ(serial, parallel);
+
+	// Middle row of the item channel: columns 0..6 are x = -1..5, the wall at x = 4
+	const float* items_row = serial.data() + 49 + 3 * 7;
+	const float expected[7] = {0, 1, 1, 1, 1, 1, 0};
+	for (int column = 0; column < 7; ++column)
+		EXPECT_EQ(items_row[column], expected[column]) << column;
+
+	// The wall is seen
+	EXPECT_EQ(serial[3 * 7 + 5], 1.0f);
+}
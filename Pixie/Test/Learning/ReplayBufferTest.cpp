@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Pixie/Learning/ReplayBuffer.h"
+
+using namespace pixie;
+
+
+TEST(ReplayBufferTest, SumTreeFindsRunningSums)
+{
+	SumTree tree(5);
+	const double priorities[] = {1.0, 0.0, 2.0, 3.0, 4.0};
+	for (size_t i = 0; i < 5; ++i)
+		tree.Set(i, priorities[i]);
+
+	EXPECT_DOUBLE_EQ(tree.Total(), 10.0);
+	EXPECT_EQ(tree.Find(0.0), 0u);
+	EXPECT_EQ(tree.Find(0.99), 0u);
+	EXPECT_EQ(tree.Find(1.0), 2u);
+	EXPECT_EQ(tree.Find(5.5), 3u);
+	EXPECT_EQ(tree.Find(9.99), 4u);
+
+	tree.Set(4, 0.0);
+	tree.Rebuild();
+	EXPECT_DOUBLE_EQ(tree.Total(), 6.0);
+	EXPECT_EQ(tree.Find(100.0), 4u);
+}
+
+
+TEST(ReplayBufferTest, ConcurrentProducersAppendEveryTransition)
+{
+	constexpr size_t producer_count = 4;
+	constexpr int transitions_per_producer = 2000;
+
+	ReplayBuffer replay(producer_count * transitions_per_producer);
+	const size_t observation = replay.AddColumn("observation", Space::Box({6}));
+	const size_t producer = replay.AddColumn("producer", Space::Discrete(producer_count));
+
+	std::vector<std::thread> producers;
+	for (size_t p = 0; p < producer_count; ++p)
+	{
+		producers.emplace_back([&, p]
+		{
+			for (int i = 0; i < transitions_per_producer; ++i)
+			{
+				// Written in place in the claimed slot
+				const ReplaySlot slot = replay.Claim();
+				const Span<float> values = replay.Get<float>(observation, slot);
+				for (size_t j = 0; j < values.size(); ++j)
+					values[j] = static_cast<float>(i) + 0.1f * static_cast<float>(j);
+				replay.Get<int32_t>(producer, slot)[0] = static_cast<int32_t>(p);
+				replay.Publish(slot);
+			}
+		});
+	}
+
+	for (auto& thread : producers)
+		thread.join();
+
+	ASSERT_EQ(replay.Size(), replay.Capacity());
+
+	// Each producer stored each of its transitions exactly once
+	std::vector<uint32_t> indices(replay.Capacity());
+	for (size_t i = 0; i < indices.size(); ++i)
+		indices[i] = static_cast<uint32_t>(i);
+
+	std::vector<float> values(indices.size() * 6);
+	std::vector<int32_t> producers_of(indices.size());
+	replay.Gather(observation, Span<const uint32_t>(indices), values.data());
+	replay.Gather(producer, Span<const uint32_t>(indices), producers_of.data());
+
+	std::vector<std::vector<int>> seen(producer_count, std::vector<int>(transitions_per_producer, 0));
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		const auto step = static_cast<int>(values[i * 6]);
+		EXPECT_FLOAT_EQ(values[i * 6 + 5], static_cast<float>(step) + 0.5f);
+		++seen[producers_of[i]][step];
+	}
+
+	for (const auto& counts : seen)
+		EXPECT_EQ(std::count(counts.begin(), counts.end(), 1), transitions_per_producer);
+}
+
+
+TEST(ReplayBufferTest, OldestTransitionsAreEvicted)
+{
+	ReplayBuffer replay(4);
+	const size_t reward = replay.AddColumn("reward", Space::Box({}));
+
+	for (int i = 0; i < 6; ++i)
+	{
+		const float value = static_cast<float>(i);
+		replay.Append({&value});
+	}
+
+	EXPECT_EQ(replay.Size(), 4u);
+	EXPECT_EQ(replay.AppendCount(), 6u);
+
+	const std::vector<uint32_t> indices = {0, 1, 2, 3};
+	float rewards[4];
+	replay.Gather(reward, Span<const uint32_t>(indices), rewards);
+	EXPECT_EQ(rewards[0], 4.0f);
+	EXPECT_EQ(rewards[1], 5.0f);
+	EXPECT_EQ(rewards[2], 2.0f);
+	EXPECT_EQ(rewards[3], 3.0f);
+}
+
+
+TEST(ReplayBufferTest, SamplingFollowsPriorities)
+{
+	ReplayBuffer replay(8, 1.0f);
+	const size_t id = replay.AddColumn("id", Space::Discrete(8));
+
+	std::mt19937 random(3);
+	std::vector<uint32_t> indices(64);
+	std::vector<float> weights(64);
+	EXPECT_EQ(replay.SampleUniform(random, Span<uint32_t>(indices)), 0u);
+
+	for (int32_t i = 0; i < 4; ++i)
+		replay.Append({&i}, 1.0f);
+
+	// Uniform sampling only draws stored transitions
+	ASSERT_EQ(replay.SampleUniform(random, Span<uint32_t>(indices)), indices.size());
+	for (uint32_t index : indices)
+		EXPECT_LT(index, 4u);
+
+	// Transition 3 holds 7 / 10 of the total priority
+	const std::vector<uint32_t> updated = {0, 1, 2, 3};
+	const std::vector<float> priorities = {1.0f, 1.0f, 1.0f, 7.0f};
+	replay.UpdatePriorities(Span<const uint32_t>(updated), Span<const float>(priorities));
+
+	size_t draws_of_3 = 0;
+	for (int round = 0; round < 50; ++round)
+	{
+		ASSERT_EQ(replay.SamplePrioritized(random, Span<uint32_t>(indices), Span<float>(weights), 1.0f), indices.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			ASSERT_LT(indices[i], 4u);
+			draws_of_3 += indices[i] == 3;
+
+			// Rare transitions weigh more, the most likely one weighs 1 / 7 of them
+			EXPECT_FLOAT_EQ(weights[i], indices[i] == 3 ? 1.0f / 7.0f : 1.0f);
+		}
+	}
+	EXPECT_NEAR(static_cast<double>(draws_of_3) / (50.0 * indices.size()), 0.7, 0.03);
+
+	std::vector<int32_t> ids(indices.size());
+	replay.Gather(id, Span<const uint32_t>(indices), ids.data());
+	for (size_t i = 0; i < indices.size(); ++i)
+		EXPECT_EQ(ids[i], static_cast<int32_t>(indices[i]));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "Pixie/Learning/TrajectoryRecorder.h"
+
+using namespace pixie;
+
+
+TEST(TrajectoryRecorderTest, RecordedFieldsCanBeMappedBack)
+{
+	const std::string directory = ::testing::TempDir();
+
+	SpaceBuffer observations(3);
+	const size_t position = observations.Add("trajectory_position", Space::Box({2}));
+
+	{
+		TrajectoryRecorder recorder(directory, 16);
+		EXPECT_EQ(recorder.AddFields(observations), 0u);
+		EXPECT_EQ(recorder.AddField("trajectory_action", Space::Discrete(4)), 1u);
+		EXPECT_EQ(recorder.AddField("trajectory_done", Space::Discrete(2)), 2u);
+
+		for (int32_t step = 0; step < 10; ++step)
+		{
+			const Span<float> values = observations.Get<float>(position);
+			for (size_t i = 0; i < values.size(); ++i)
+				values[i] = static_cast<float>(step * 10 + static_cast<int32_t>(i));
+
+			const int32_t action = step % 4;
+			const int32_t done = step == 9;
+			ASSERT_TRUE(recorder.Record({observations.GetTensor(position).data, &action, &done}));
+		}
+
+		recorder.Flush();
+		EXPECT_EQ(recorder.Size(), 10u);
+	}
+
+	const TrajectoryReader positions(TrajectoryRecorder::GetPath(directory, "trajectory_position"));
+	const TrajectoryHeader& header = positions.GetHeader();
+	EXPECT_EQ(header.type, TensorType::Float32());
+	EXPECT_EQ(header.capacity, 16u);
+	EXPECT_EQ(header.row_size, 3u * 2u * sizeof(float));
+	ASSERT_EQ(positions.Size(), 10u);
+
+	// Rows of shape [batch, 2], stacked along the steps
+	const TensorView tensor = positions.GetTensor();
+	ASSERT_EQ(tensor.ndim, 3);
+	EXPECT_EQ(tensor.shape[0], 10);
+	EXPECT_EQ(tensor.shape[1], 3);
+	EXPECT_EQ(tensor.shape[2], 2);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.data) % 64, 0u);
+	EXPECT_EQ(static_cast<const float*>(tensor.data)[7 * tensor.strides[0] + 2 * tensor.strides[1] + 1], 75.0f);
+	EXPECT_EQ(positions.Get<float>(4)[5], 45.0f);
+
+	const TrajectoryReader actions(TrajectoryRecorder::GetPath(directory, "trajectory_action"));
+	const TrajectoryReader dones(TrajectoryRecorder::GetPath(directory, "trajectory_done"));
+	EXPECT_EQ(actions.GetHeader().ndim, 0);
+	for (size_t step = 0; step < 10; ++step)
+	{
+		EXPECT_EQ(actions.Get<int32_t>(step)[0], static_cast<int32_t>(step % 4));
+		EXPECT_EQ(dones.Get<int32_t>(step)[0], step == 9 ? 1 : 0);
+	}
+}
+
+
+TEST(TrajectoryRecorderTest, BackgroundThreadPublishesRecordedSteps)
+{
+	const std::string directory = ::testing::TempDir();
+
+	TrajectoryRecorder recorder(directory, 4, std::chrono::milliseconds(5));
+	recorder.AddField("trajectory_reward", Space::Box({}));
+
+	for (int step = 0; step < 3; ++step)
+	{
+		const float reward = 0.5f * static_cast<float>(step);
+		ASSERT_TRUE(recorder.Record({&reward}));
+	}
+
+	// A reader sees the steps once the background thread has written them
+	const TrajectoryReader rewards(TrajectoryRecorder::GetPath(directory, "trajectory_reward"));
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (rewards.Size() < 3 and std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	ASSERT_EQ(rewards.Size(), 3u);
+	EXPECT_EQ(rewards.Get<float>(2)[0], 1.0f);
+
+	// Files are sized upfront and never grow
+	const float reward = 2.0f;
+	EXPECT_TRUE(recorder.Record({&reward}));
+	EXPECT_FALSE(recorder.Record({&reward}));
+
+	recorder.Close();
+	EXPECT_FALSE(recorder.Record({&reward}));
+	EXPECT_EQ(TrajectoryReader(TrajectoryRecorder::GetPath(directory, "trajectory_reward")).Size(), 4u);
+}
+
+
+TEST(TrajectoryRecorderTest, ReaderRejectsOtherFiles)
+{
+	const std::string path = ::testing::TempDir() + "/trajectory_not_a_trajectory.pxt";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << std::string(256, 'x');
+	}
+
+	EXPECT_THROW(TrajectoryReader reader(path), std::runtime_error);
+	EXPECT_THROW(TrajectoryReader reader(path + ".missing"), std::runtime_error);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "Pixie/Math/TransformKernels.h"
+
+using namespace pixie;
+
+namespace
+{
+
+const float pi = 3.14159265f;
+
+void ExpectNear(const Vec3& a, const Vec3& b, float tolerance = 1e-4f)
+{
+	EXPECT_NEAR(a.x, b.x, tolerance);
+	EXPECT_NEAR(a.y, b.y, tolerance);
+	EXPECT_NEAR(a.z, b.z, tolerance);
+}
+
+} // namespace
+
+
+TEST(MathTest, QuatRotations)
+{
+	const Quat quarter_z = Quat::FromAxisAngle({0.0f, 0.0f, 1.0f}, 0.5f * pi);
+	ExpectNear(Rotate(quarter_z, {1.0f, 0.0f, 0.0f}), {0.0f, 1.0f, 0.0f});
+
+	// Composition applies the right-hand side first
+	const Quat quarter_x = Quat::FromAxisAngle({1.0f, 0.0f, 0.0f}, 0.5f * pi);
+	ExpectNear(Rotate(quarter_x * quarter_z, {1.0f, 0.0f, 0.0f}), {0.0f, 0.0f, 1.0f});
+	ExpectNear(Rotate(Conjugate(quarter_z), Rotate(quarter_z, {1.0f, 2.0f, 3.0f})), {1.0f, 2.0f, 3.0f});
+
+	// Same rotation as a matrix
+	const Quat any = Normalize(Quat{0.3f, -0.2f, 0.5f, 0.8f});
+	const Mat3 matrix = Mat3::FromQuat(any);
+	ExpectNear(matrix * Vec3{1.0f, -2.0f, 0.5f}, Rotate(any, {1.0f, -2.0f, 0.5f}));
+	EXPECT_NEAR(matrix.Determinant(), 1.0f, 1e-5f);
+	ExpectNear((matrix.Transposed() * matrix) * Vec3{4.0f, 5.0f, 6.0f}, {4.0f, 5.0f, 6.0f});
+
+	const Quat halfway = Nlerp(Quat::Identity(), quarter_z, 0.5f);
+	ExpectNear(Rotate(halfway, {1.0f, 0.0f, 0.0f}), {std::sqrt(0.5f), std::sqrt(0.5f), 0.0f});
+}
+
+
+TEST(MathTest, Mat4Transforms)
+{
+	const Mat4 trs = Mat4::Trs({1.0f, 2.0f, 3.0f}, Quat::FromAxisAngle({0.0f, 0.0f, 1.0f}, 0.5f * pi), {2.0f, 2.0f, 2.0f});
+	ExpectNear(trs.TransformPoint({1.0f, 0.0f, 0.0f}), {1.0f, 4.0f, 3.0f});
+	ExpectNear(trs.TransformVector({1.0f, 0.0f, 0.0f}), {0.0f, 2.0f, 0.0f});
+
+	const Mat4 composed = Mat4::Translation({1.0f, 2.0f, 3.0f}) * Mat4::Trs({}, Quat::FromAxisAngle({0.0f, 0.0f, 1.0f}, 0.5f * pi), {2.0f, 2.0f, 2.0f});
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			EXPECT_NEAR((&composed.columns[i].x)[j], (&trs.columns[i].x)[j], 1e-5f);
+
+	EXPECT_EQ(Mat4::Identity() * trs, trs);
+	EXPECT_EQ(trs.Transposed().Transposed(), trs);
+	ExpectNear(trs.GetTranslation(), {1.0f, 2.0f, 3.0f});
+}
+
+
+TEST(MathTest, BatchedKernelsMatchSingleTransforms)
+{
+	std::mt19937 random(9);
+	std::uniform_real_distribution<float> value(-5.0f, 5.0f);
+
+	const Mat4 transform = Mat4::Trs({1.0f, -2.0f, 0.5f}, Normalize(Quat{0.1f, 0.7f, -0.3f, 0.6f}), {1.0f, 3.0f, 0.5f});
+
+	// Not a multiple of the SIMD width, to cover the scalar tails
+	const size_t count = 37;
+	std::vector<Vec3> points(count), transformed(count);
+	std::vector<float> x(count), y(count), z(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		points[i] = {value(random), value(random), value(random)};
+		x[i] = points[i].x;
+		y[i] = points[i].y;
+		z[i] = points[i].z;
+	}
+
+	TransformPoints(transform, Span<const Vec3>(points), Span<Vec3>(transformed));
+
+	// In place
+	TransformPoints(transform, Span<const float>(x), Span<const float>(y), Span<const float>(z), Span<float>(x), Span<float>(y), Span<float>(z));
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Vec3 expected = transform.TransformPoint(points[i]);
+		ExpectNear(transformed[i], expected);
+		ExpectNear({x[i], y[i], z[i]}, expected);
+	}
+
+	std::vector<Mat4> locals(count), composed(count), broadcast(count);
+	for (size_t i = 0; i < count; ++i)
+		locals[i] = Mat4::Translation({value(random), value(random), value(random)});
+
+	std::vector<Mat4> parents(count, transform);
+	ComposeTransforms(Span<const Mat4>(parents), Span<const Mat4>(locals), Span<Mat4>(composed));
+	ComposeTransforms(transform, Span<const Mat4>(locals), Span<Mat4>(broadcast));
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		EXPECT_EQ(composed[i], broadcast[i]);
+		ExpectNear(composed[i].TransformPoint(points[i]), transform.TransformPoint(locals[i].TransformPoint(points[i])));
+	}
+}
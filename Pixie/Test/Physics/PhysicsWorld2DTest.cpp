@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <future>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Physics/PhysicsWorld2D.h"
+
+using namespace pixie;
+
+
+TEST(PhysicsWorld2DTest, FreeFall)
+{
+	PhysicsWorld2D physics;
+	physics.SetTimeStep(0.1f);
+
+	// More bodies than a SIMD lane count, plus one static body that must not fall
+	std::vector<uint32_t> bodies;
+	for (int i = 0; i < 6; ++i)
+		bodies.push_back(physics.AddBody({{i * 10.0f, 100.0f, 0.0f}}));
+	const uint32_t ledge = physics.AddBody({{100.0f, 100.0f, 0.0f}, 0.0f, {}, 0.0f, 0.0f});
+
+	for (int step = 0; step < 10; ++step)
+		physics.Step();
+
+	for (uint32_t body : bodies)
+	{
+		EXPECT_NEAR(physics.GetVelocity(body).y, -9.81f, 1e-4f);
+		// Semi-implicit Euler over 1 s in substeps of h = 0.025 s: y = y0 - g t (t + h) / 2
+		EXPECT_NEAR(physics.GetPosition(body).y, 100.0f - 0.5f * 9.81f * 1.025f, 1e-3f);
+	}
+	EXPECT_EQ(physics.GetPosition(ledge).y, 100.0f);
+	EXPECT_EQ(physics.ContactCount(), 0u);
+}
+
+
+TEST(PhysicsWorld2DTest, BodyRestsOnGround)
+{
+	PhysicsWorld2D physics;
+	physics.GetSettings().substeps = 8;
+
+	physics.AddBody({{0.0f, -100.0f, 0.0f}, 0.0f, {}, 0.0f, 0.0f, 100.0f});
+	const uint32_t ball = physics.AddBody({{0.0f, 1.0f, 0.0f}});
+
+	for (int step = 0; step < 120; ++step)
+		physics.Step();
+
+	EXPECT_NEAR(physics.GetPosition(ball).y, 0.5f, 0.02f);
+	EXPECT_NEAR(physics.GetVelocity(ball).y, 0.0f, 0.05f);
+	EXPECT_EQ(physics.IslandCount(), 1u);
+}
+
+
+TEST(PhysicsWorld2DTest, ElasticCollisionSwapsVelocities)
+{
+	PhysicsWorld2D physics;
+	physics.GetSettings().gravity = {};
+	physics.GetSettings().restitution = 1.0f;
+	physics.GetSettings().friction = 0.0f;
+
+	const uint32_t left = physics.AddBody({{-2.0f, 0.0f, 0.0f}, 0.0f, {3.0f, 0.0f, 0.0f}});
+	const uint32_t right = physics.AddBody({{2.0f, 0.0f, 0.0f}, 0.0f, {-1.0f, 0.0f, 0.0f}});
+
+	for (int step = 0; step < 90; ++step)
+		physics.Step();
+
+	EXPECT_NEAR(physics.GetVelocity(left).x, -1.0f, 0.05f);
+	EXPECT_NEAR(physics.GetVelocity(right).x, 3.0f, 0.05f);
+	EXPECT_NEAR(physics.GetAngularVelocity(left), 0.0f, 1e-5f);
+}
+
+
+TEST(PhysicsWorld2DTest, ParallelIslandsMatchSerial)
+{
+	auto build = [](PhysicsWorld2D& physics)
+	{
+		// Separate piles on a shared static floor, each pile its own island
+		physics.AddBody({{0.0f, -1000.0f, 0.0f}, 0.0f, {}, 0.0f, 0.0f, 1000.0f});
+		for (int pile = 0; pile < 40; ++pile)
+			for (int level = 0; level < 8; ++level)
+				physics.AddBody({{pile * 5.0f + level * 0.1f, 0.5f + level * 0.95f, 0.0f}});
+	};
+
+	PhysicsWorld2D serial, parallel;
+	build(serial);
+	build(parallel);
+
+	WorkerPool workers(3);
+	parallel.SetWorkers(&workers);
+
+	for (int step = 0; step < 30; ++step)
+	{
+		serial.Step();
+		parallel.Step();
+	}
+
+	EXPECT_GT(parallel.IslandCount(), 1u);
+	for (uint32_t body = 0; body < serial.Size(); ++body)
+	{
+		ASSERT_EQ(serial.GetPosition(body), parallel.GetPosition(body)) << body;
+		ASSERT_EQ(serial.GetAngle(body), parallel.GetAngle(body)) << body;
+	}
+}
+
+
+struct Rocket
+{
+	void Begin() { body = ObjectInitializer::GetPhysics()->AddBody({{0.0f, 0.0f, 0.0f}}); }
+
+	void Tick()
+	{
+		seen_by_tick.push_back(ObjectInitializer::GetPhysics()->GetPosition(body).y);
+		ObjectInitializer::GetPhysics()->ApplyForce(body, {0.0f, 20.0f, 0.0f});
+	}
+
+	uint32_t body = PhysicsWorld2D::npos;
+	std::vector<float> seen_by_tick{};
+};
+
+
+struct Mission
+{
+	void Tick()
+	{
+		seen_by_manager.push_back(ObjectInitializer::GetPhysics()->GetPosition(rocket->body).y);
+
+		if (seen_by_manager.size() == 3)
+			Core::Shutdown();
+	}
+
+	Handle<Rocket> rocket;
+	std::vector<float> seen_by_manager{};
+};
+
+
+TEST(PhysicsWorld2DTest, SteppedBetweenTickAndGameManager)
+{
+	Core::Initialize();
+	Core::GetClock().SetFixedTimeStepInSeconds(0.5f);
+
+	auto rocket = ObjectInitializer::ConstructEntity<Rocket>();
+	auto* manager = ObjectInitializer::ConstructGameManager<Mission>();
+	manager->rocket = rocket;
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	ASSERT_EQ(rocket->seen_by_tick.size(), 3u);
+	ASSERT_EQ(manager->seen_by_manager.size(), 3u);
+
+	// The manager sees the step that follows each Tick
+	EXPECT_EQ(rocket->seen_by_tick[0], 0.0f);
+	EXPECT_GT(manager->seen_by_manager[0], 0.0f);
+	EXPECT_EQ(rocket->seen_by_tick[1], manager->seen_by_manager[0]);
+	EXPECT_NEAR(ObjectInitializer::GetPhysics()->GetTimeStep(), 0.5f, 0.0f);
+
+	Core::Destroy();
+}
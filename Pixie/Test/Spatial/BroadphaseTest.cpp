@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <random>
+#include <set>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Spatial/Broadphase.h"
+
+using namespace pixie;
+
+namespace
+{
+
+std::set<uint64_t> ToSet(Span<const uint64_t> keys) { return std::set<uint64_t>(keys.begin(), keys.end()); }
+
+} // namespace
+
+
+TEST(BroadphaseTest, TracksOverlapsAcrossFrames)
+{
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> coordinate(0.0f, 40.0f);
+	std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+
+	Broadphase broadphase;
+	std::vector<Aabb> boxes;
+	std::vector<uint32_t> proxies;
+	for (int i = 0; i < 200; ++i)
+	{
+		Vec3 min{coordinate(random), coordinate(random), 0.0f};
+		boxes.push_back({min, min + Vec3{1.5f, 1.5f, 0.0f}});
+		proxies.push_back(broadphase.Insert(boxes.back()));
+	}
+
+	std::set<uint64_t> previous;
+	for (int frame = 0; frame < 30; ++frame)
+	{
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			const Vec3 move{step(random), step(random), 0.0f};
+			boxes[i].min += move;
+			boxes[i].max += move;
+			broadphase.SetBounds(proxies[i], boxes[i]);
+		}
+		broadphase.Commit();
+
+		std::set<uint64_t> expected;
+		for (uint32_t i = 0; i < boxes.size(); ++i)
+			for (uint32_t j = i + 1; j < boxes.size(); ++j)
+				if (Aabb::Overlap(boxes[i], boxes[j]))
+					expected.insert(Broadphase::ToKey(proxies[i], proxies[j]));
+
+		ASSERT_EQ(ToSet(broadphase.Pairs()), expected);
+
+		// Previous pairs + began - ended = current pairs
+		std::set<uint64_t> rebuilt = previous;
+		for (uint64_t key : broadphase.Ended())
+			EXPECT_EQ(rebuilt.erase(key), 1u);
+		for (uint64_t key : broadphase.Began())
+			EXPECT_TRUE(rebuilt.insert(key).second);
+
+		EXPECT_EQ(rebuilt, expected);
+		previous = expected;
+	}
+}
+
+
+TEST(BroadphaseTest, RemovalEndsOverlapsBeforeReuse)
+{
+	Broadphase broadphase;
+	const uint32_t a = broadphase.Insert({{0.0f, 0.0f, 0.0f}, {2.0f, 2.0f, 2.0f}});
+	const uint32_t b = broadphase.Insert({{1.0f, 1.0f, 1.0f}, {3.0f, 3.0f, 3.0f}});
+
+	// Touching counts as overlapping
+	const uint32_t c = broadphase.Insert({{2.0f, 0.0f, 0.0f}, {4.0f, 1.0f, 1.0f}});
+	broadphase.Commit();
+
+	EXPECT_EQ(ToSet(broadphase.Began()), (std::set<uint64_t>{Broadphase::ToKey(a, b), Broadphase::ToKey(a, c), Broadphase::ToKey(b, c)}));
+
+	EXPECT_TRUE(broadphase.Remove(b));
+	EXPECT_FALSE(broadphase.Remove(b));
+	EXPECT_EQ(broadphase.Size(), 2u);
+	broadphase.Commit();
+
+	EXPECT_TRUE(broadphase.Began().empty());
+	EXPECT_EQ(ToSet(broadphase.Ended()), (std::set<uint64_t>{Broadphase::ToKey(a, b), Broadphase::ToKey(b, c)}));
+
+	// The identifier is reused once its overlaps ended
+	EXPECT_EQ(broadphase.Insert({{10.0f, 10.0f, 10.0f}, {11.0f, 11.0f, 11.0f}}), b);
+	broadphase.Commit();
+	EXPECT_TRUE(broadphase.Began().empty());
+	EXPECT_TRUE(broadphase.Ended().empty());
+}
+
+
+struct Ball
+{
+	void Begin()
+	{
+		proxy = ObjectInitializer::GetBroadphase()->Insert(Bounds());
+	}
+
+	void Tick()
+	{
+		x += speed;
+		ObjectInitializer::GetBroadphase()->SetBounds(proxy, Bounds());
+	}
+
+	Aabb Bounds() const { return {{x, 0.0f, 0.0f}, {x + 1.0f, 1.0f, 1.0f}}; }
+
+	float x = 0.0f;
+	float speed = 0.0f;
+	uint32_t proxy = Broadphase::npos;
+};
+
+
+struct Referee
+{
+	void Begin()
+	{
+		Core::Subscribe<OverlapBegin>([this](Span<const OverlapBegin> events) { begins.push_back({ticks, events.size()}); });
+		Core::Subscribe<OverlapEnd>([this](Span<const OverlapEnd> events) { ends.push_back({ticks, events.size()}); });
+	}
+
+	void Tick()
+	{
+		if (++ticks == 6)
+			Core::Shutdown();
+	}
+
+	int ticks = 0;
+	std::vector<std::pair<int, size_t>> begins{};
+	std::vector<std::pair<int, size_t>> ends{};
+};
+
+
+TEST(BroadphaseTest, SceneEmitsOverlapEvents)
+{
+	Core::Initialize();
+
+	// Balls pass through each other between the second and fourth ticks
+	auto left = ObjectInitializer::ConstructEntity<Ball>();
+	left->x = -3.5f;
+	left->speed = 1.0f;
+
+	auto right = ObjectInitializer::ConstructEntity<Ball>();
+	right->x = 3.5f;
+	right->speed = -1.0f;
+
+	auto referee = ObjectInitializer::ConstructEntity<Referee>();
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// x: -2.5/2.5, -1.5/1.5, -0.5/0.5, 0.5/-0.5, 1.5/-1.5, ...
+	EXPECT_EQ(referee->begins, (std::vector<std::pair<int, size_t>>{{3, 1}}));
+	EXPECT_EQ(referee->ends, (std::vector<std::pair<int, size_t>>{{5, 1}}));
+
+	Core::Destroy();
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Spatial/Raycaster.h"
+
+using namespace pixie;
+
+namespace
+{
+
+/** Reference answer: entry distance of the ray into the box, or infinity */
+float BruteForceHit(const Ray& ray, const Aabb& box)
+{
+	float t_enter = 0.0f;
+	float t_exit = ray.max_distance;
+
+	const float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+	const float direction[3] = {ray.direction.x, ray.direction.y, ray.direction.z};
+	const float lo[3] = {box.min.x, box.min.y, box.min.z};
+	const float hi[3] = {box.max.x, box.max.y, box.max.z};
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float t1 = (lo[axis] - origin[axis]) / direction[axis];
+		float t2 = (hi[axis] - origin[axis]) / direction[axis];
+		t_enter = std::max(t_enter, std::min(t1, t2));
+		t_exit = std::min(t_exit, std::max(t1, t2));
+	}
+
+	return t_enter <= t_exit ? t_enter : INFINITY;
+}
+
+Aabb RandomBox(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> size(0.5f, 3.0f);
+
+	Vec3 min{coordinate(random), coordinate(random), coordinate(random)};
+	return {min, min + Vec3{size(random), size(random), size(random)}};
+}
+
+} // namespace
+
+
+TEST(RaycasterTest, MatchesBruteForce)
+{
+	std::mt19937 random(3);
+
+	Raycaster geometry;
+	std::vector<Aabb> boxes;
+	for (int i = 0; i < 300; ++i)
+	{
+		boxes.push_back(RandomBox(random));
+		if (i % 3 == 0)
+			geometry.AddDynamic(boxes.back());
+		else
+			geometry.AddStatic(boxes.back());
+	}
+	geometry.Commit();
+
+	// Lidar-like sweep from a few points, including a partial last packet
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::vector<Ray> rays;
+	for (int i = 0; i < 1003; ++i)
+	{
+		float yaw = angle(random);
+		float pitch = angle(random) * 0.1f;
+		rays.push_back({{0.0f, 0.0f, 0.0f}, {std::cos(yaw), std::sin(yaw), std::sin(pitch)}, 80.0f});
+	}
+
+	std::vector<float> distances(rays.size());
+	std::vector<uint32_t> hits(rays.size());
+
+	WorkerPool workers(3);
+	geometry.Raycast(Span<const Ray>(rays), Span<float>(distances), Span<uint32_t>(hits), &workers);
+
+	int hit_count = 0;
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		float closest = INFINITY;
+		uint32_t closest_id = Raycaster::npos;
+		for (uint32_t id = 0; id < boxes.size(); ++id)
+		{
+			float t = BruteForceHit(rays[i], boxes[id]);
+			if (t < closest)
+			{
+				closest = t;
+				closest_id = id;
+			}
+		}
+
+		if (closest_id == Raycaster::npos)
+		{
+			EXPECT_EQ(hits[i], Raycaster::npos);
+			EXPECT_EQ(distances[i], 80.0f);
+		}
+		else
+		{
+			++hit_count;
+			EXPECT_EQ(hits[i], closest_id);
+			EXPECT_NEAR(distances[i], closest, 1e-3f);
+		}
+	}
+
+	EXPECT_GT(hit_count, 0);
+}
+
+
+TEST(RaycasterTest, DynamicBoxesMoveAndGo)
+{
+	Raycaster geometry;
+	geometry.AddStatic({{10.0f, -1.0f, -1.0f}, {11.0f, 1.0f, 1.0f}});
+	uint32_t door = geometry.AddDynamic({{5.0f, -1.0f, -1.0f}, {6.0f, 1.0f, 1.0f}});
+	geometry.Commit();
+
+	std::vector<Ray> rays{{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 20.0f}};
+	std::vector<float> distances(1);
+	std::vector<uint32_t> hits(1);
+
+	geometry.Raycast(Span<const Ray>(rays), Span<float>(distances), Span<uint32_t>(hits));
+	EXPECT_EQ(hits[0], door);
+	EXPECT_FLOAT_EQ(distances[0], 5.0f);
+
+	// Refitted, not visible until committed
+	geometry.SetBounds(door, {{2.0f, -1.0f, -1.0f}, {3.0f, 1.0f, 1.0f}});
+	geometry.Raycast(Span<const Ray>(rays), Span<float>(distances));
+	EXPECT_FLOAT_EQ(distances[0], 5.0f);
+
+	geometry.Commit();
+	geometry.Raycast(Span<const Ray>(rays), Span<float>(distances));
+	EXPECT_FLOAT_EQ(distances[0], 2.0f);
+
+	EXPECT_TRUE(geometry.RemoveDynamic(door));
+	EXPECT_FALSE(geometry.RemoveDynamic(door));
+	geometry.Commit();
+
+	geometry.Raycast(Span<const Ray>(rays), Span<float>(distances), Span<uint32_t>(hits));
+	EXPECT_EQ(hits[0], 0u);
+	EXPECT_FLOAT_EQ(distances[0], 10.0f);
+}
+
+
+TEST(RaycasterTest, WorkerPoolCoversEveryItem)
+{
+	WorkerPool workers(4);
+
+	std::vector<int> visits(10007, 0);
+	for (int run = 0; run < 3; ++run)
+		workers.ParallelFor(visits.size(), 100, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				++visits[i];
+		});
+
+	for (int count : visits)
+		ASSERT_EQ(count, 3);
+}
+
+
+TEST(RaycasterTest, SceneGeometry)
+{
+	Core::Initialize();
+
+	auto* geometry = ObjectInitializer::GetRaycaster();
+	ASSERT_NE(geometry, nullptr);
+	geometry->AddStatic({{1.0f, -1.0f, -1.0f}, {2.0f, 1.0f, 1.0f}});
+	geometry->Commit();
+
+	std::vector<Ray> rays(64, Ray{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 10.0f});
+	std::vector<float> distances(rays.size());
+	geometry->Raycast(Span<const Ray>(rays), Span<float>(distances), {}, &Core::GetWorkerPool());
+
+	for (float distance : distances)
+		EXPECT_FLOAT_EQ(distance, 1.0f);
+
+	Core::Destroy();
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <numeric>
+#include <random>
+
+#include "Pixie/Core/Core.h"
+#include "Pixie/Core/ObjectInitializer.h"
+#include "Pixie/Spatial/SpatialHash.h"
+
+using namespace pixie;
+
+namespace
+{
+
+/** Reference answer: all the points within 'radius' of 'center' */
+std::vector<uint32_t> BruteForceRadius(const std::vector<Vec3>& points, const Vec3& center, float radius)
+{
+	std::vector<uint32_t> ids;
+	for (uint32_t id = 0; id < points.size(); ++id)
+		if (DistanceSquared(points[id], center) <= radius * radius)
+			ids.push_back(id);
+
+	return ids;
+}
+
+std::vector<uint32_t> Sorted(std::vector<uint32_t> ids)
+{
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+} // namespace
+
+
+struct Walker
+{
+	void Begin()
+	{
+		proxy = ObjectInitializer::GetSpatialHash()->Insert(position);
+	}
+
+	void Tick()
+	{
+		auto* grid = ObjectInitializer::GetSpatialHash();
+
+		// Sees the positions of the previous frame, whatever the tick order
+		neighbors.clear();
+		grid->QueryRadius(position, 1.5f, neighbors);
+		seen.push_back(neighbors.size());
+
+		position.x += 1.0f;
+		grid->SetPosition(proxy, position);
+
+		if (++ticks == 3)
+			Core::Shutdown();
+	}
+
+	Vec3 position{};
+	uint32_t proxy = SpatialHash::npos;
+	std::vector<uint32_t> neighbors;
+	std::vector<size_t> seen;
+	int ticks = 0;
+};
+
+
+TEST(SpatialHashTest, QueriesMatchBruteForce)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> coordinate(-20.0f, 20.0f);
+
+	SpatialHash grid(2.0f);
+	std::vector<Vec3> points;
+	for (int i = 0; i < 500; ++i)
+	{
+		points.push_back({coordinate(random), coordinate(random), 0.0f});
+		EXPECT_EQ(grid.Insert(points.back()), static_cast<uint32_t>(i));
+	}
+
+	EXPECT_EQ(grid.Size(), 0u);
+	grid.Commit();
+	EXPECT_EQ(grid.Size(), 500u);
+
+	// Move half of them, some across cells
+	for (uint32_t id = 0; id < 500; id += 2)
+	{
+		points[id] = points[id] + Vec3{coordinate(random) * 0.1f, 0.5f, 0.0f};
+		grid.SetPosition(id, points[id]);
+	}
+	grid.Commit();
+
+	const Vec3 center{1.0f, -3.0f, 0.0f};
+
+	std::vector<uint32_t> found;
+	grid.QueryRadius(center, 5.0f, found);
+	EXPECT_EQ(Sorted(found), BruteForceRadius(points, center, 5.0f));
+
+	found.clear();
+	grid.QueryAabb({-4.0f, -4.0f, -1.0f}, {4.0f, 2.0f, 1.0f}, found);
+	for (uint32_t id : found)
+		EXPECT_TRUE(points[id].x >= -4.0f and points[id].x <= 4.0f and points[id].y >= -4.0f and points[id].y <= 2.0f);
+
+	// The k nearest are the k first of all the points sorted by distance
+	std::vector<uint32_t> all(points.size());
+	std::iota(all.begin(), all.end(), 0u);
+	std::sort(all.begin(), all.end(), [&](uint32_t a, uint32_t b)
+	{
+		return DistanceSquared(points[a], center) < DistanceSquared(points[b], center);
+	});
+
+	found.clear();
+	grid.QueryNearest(center, 10, found);
+	EXPECT_EQ(found, std::vector<uint32_t>(all.begin(), all.begin() + 10));
+
+	// Batched queries give the same answers
+	std::vector<Vec3> centers{center, {10.0f, 10.0f, 0.0f}};
+	SpatialQueryResults results;
+	grid.QueryRadius(Span<const Vec3>(centers), 5.0f, results);
+	ASSERT_EQ(results.Size(), 2u);
+	EXPECT_EQ(Sorted({results[1].begin(), results[1].end()}), BruteForceRadius(points, centers[1], 5.0f));
+
+	grid.QueryNearest(Span<const Vec3>(centers), 10, results);
+	EXPECT_EQ(std::vector<uint32_t>(results[0].begin(), results[0].end()), found);
+}
+
+
+TEST(SpatialHashTest, RemoveAndRecycle)
+{
+	SpatialHash grid;
+
+	uint32_t a = grid.Insert({0.0f, 0.0f, 0.0f});
+	uint32_t b = grid.Insert({0.5f, 0.0f, 0.0f});
+	grid.Commit();
+
+	grid.Remove(a);
+
+	// Still visible until the next commit
+	std::vector<uint32_t> found;
+	grid.QueryRadius({}, 1.0f, found);
+	EXPECT_EQ(found.size(), 2u);
+
+	grid.Commit();
+	found.clear();
+	grid.QueryRadius({}, 1.0f, found);
+	EXPECT_EQ(found, std::vector<uint32_t>{b});
+
+	// Removed before it was ever committed
+	uint32_t c = grid.Insert({0.0f, 0.0f, 0.0f});
+	EXPECT_EQ(c, a);
+	grid.Remove(c);
+	grid.Commit();
+	EXPECT_EQ(grid.Size(), 1u);
+}
+
+
+TEST(SpatialHashTest, SceneCommitsEveryFrame)
+{
+	Core::Initialize();
+
+	// Three walkers one unit apart, all moving right at the same pace
+	std::vector<Handle<Walker>> walkers;
+	for (int i = 0; i < 3; ++i)
+	{
+		walkers.push_back(ObjectInitializer::ConstructEntity<Walker>());
+		walkers.back()->position = {static_cast<float>(i), 0.0f, 0.0f};
+	}
+
+	auto async_engine = std::async(std::launch::async, []() { Core::Start(); });
+	EXPECT_NE(async_engine.wait_for(std::chrono::milliseconds(2000)), std::future_status::timeout);
+	Core::Shutdown();
+
+	// Each walker always sees the others where they were on the previous frame
+	EXPECT_EQ(walkers[0]->seen, (std::vector<size_t>{2, 2, 2}));
+	EXPECT_EQ(walkers[1]->seen, (std::vector<size_t>{3, 3, 3}));
+	EXPECT_EQ(walkers[2]->seen, (std::vector<size_t>{2, 2, 2}));
+
+	Core::Destroy();
+}